@@ -48,6 +48,40 @@ struct SHADERGRAPHPLUGIN_API FSUGGraphOutputEntry
 
     UPROPERTY(EditAnywhere, BlueprintReadOnly)
     UTextureRenderTarget2D* RenderTarget;
+
+    // Render graph execution to the back buffer and only swap it with the
+    // front buffer once the execution has completed
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    bool bDoubleBuffered = false;
+
+    UPROPERTY(Transient, BlueprintReadOnly)
+    UTextureRenderTarget2D* BackRenderTarget = nullptr;
+
+    // Incremented once an execution that wrote the output has completed and
+    // its result is visible through RenderTarget or TileRenderTargets
+    UPROPERTY(Transient, BlueprintReadOnly)
+    int32 Version = 0;
+
+    bool bPendingSwap = false;
+
+    // Output render targets have been written during the execution, version
+    // is incremented once the execution has completed
+    bool bPendingVersion = false;
+
+    // Copy tiles of tiled executions into a single graph domain sized render
+    // target instead of keeping one render target per tile
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    bool bStitchTiles = false;
+
+    UPROPERTY(Transient, BlueprintReadOnly)
+    FIntPoint TileCount = FIntPoint::ZeroValue;
+
+    UPROPERTY(Transient, BlueprintReadOnly)
+    TArray<UTextureRenderTarget2D*> TileRenderTargets;
+
+    FSUGGraphOutputRT TileOutput;
+
+    void SwapBuffers();
 };
 
 UCLASS(BlueprintType, Blueprintable)
@@ -61,9 +95,16 @@ class SHADERGRAPHPLUGIN_API USUGGraph : public UObject
     TArray<USUGGraphTask*> TaskQueue;
     bool bExecutionInProgress = false;
 
-    void AssignOutput(USUGGraphTask& Task);
+    bool AssignOutput(USUGGraphTask& Task);
     void InitializeTasks();
     void ExecuteTasks();
+    void SwapOutputBuffers();
+
+    int32 GetTaskFootprintRadius() const;
+    static int32 GetPathFootprintRadius(const USUGGraphTask& Task, TMap<const USUGGraphTask*, int32>& PathFootprintMap);
+    void ExecuteTiles();
+    void PrepareOutputTiles(const FIntPoint& TileCount);
+    void ResolveOutputTiles();
 
 public:
 
@@ -76,6 +117,29 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite)
     TMap<FName, FSUGGraphOutputEntry> OutputMap;
 
+    // Tile currently being generated when executed by a tile streamer
+    UPROPERTY(Transient, BlueprintReadOnly)
+    FSUGGraphStreamingTile StreamingTile;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    FSUGGraphTiledExecutionConfig TiledExecution;
+
+    // Tile currently being executed during tiled execution
+    UPROPERTY(Transient, BlueprintReadOnly)
+    FSUGGraphExecutionTile ExecutionTile;
+
+    // Retain prepared tasks and their outputs between executions and only
+    // re-render task output regions affected by changes since the previous
+    // execution. Ignored by tiled execution.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    bool bIncrementalExecution = false;
+
+    // Evaluate chains of native pointwise tasks with single dependants in a
+    // single pass without intermediate render targets. Ignored by
+    // incremental execution.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    bool bFuseNativeTasks = true;
+
     UFUNCTION(BlueprintCallable)
     void AddTask(USUGGraphTask* Task);
 
@@ -97,6 +161,36 @@ public:
     UFUNCTION(BlueprintCallable)
 	UTextureRenderTarget2D* GetOutputRenderTarget(FName OutputName);
 
+    UFUNCTION(BlueprintCallable)
+	int32 GetOutputVersion(FName OutputName) const;
+
+    UFUNCTION(BlueprintCallable)
+	UTextureRenderTarget2D* GetOutputTileRenderTarget(FName OutputName, FIntPoint TileIndex) const;
+
+    // Transform from render target UV to graph domain UV, packed as (OffsetU, OffsetV, ScaleU, ScaleV)
+    UFUNCTION(BlueprintCallable)
+	FLinearColor GetDomainUVTransform() const;
+
+    // Discard retained tasks, prepare graph will be called on the next
+    // incremental execution
+    UFUNCTION(BlueprintCallable)
+    void ResetIncrementalExecution();
+
+    FORCEINLINE bool IsTiledExecution() const
+    {
+        return ExecutionTile.IsValid();
+    }
+
+    FORCEINLINE bool IsIncrementalExecution() const
+    {
+        return bIncrementalExecution && ! TiledExecution.bEnabled;
+    }
+
+    FORCEINLINE bool NeedsPrepare() const
+    {
+        return ! IsIncrementalExecution() || TaskQueue.Num() == 0;
+    }
+
     FORCEINLINE bool HasValidDimension() const
     {
         return OutputConfig.SizeX > 0 && OutputConfig.SizeY > 0;
@@ -142,9 +236,21 @@ public:
     UMaterialInstanceDynamic* GetCachedMID(UMaterialInterface* BaseMaterial, bool bClearParameterValues = false);
     UMaterialInstanceDynamic* GetCachedMID(FName MaterialName, bool bClearParameterValues = false);
 
+    UMaterialInstanceDynamic* GetPooledMID(UMaterialInterface* BaseMaterial, FSUGGraphPooledMIDHandle& OutHandle);
+    UMaterialInstanceDynamic* GetPooledMID(FName MaterialName, FSUGGraphPooledMIDHandle& OutHandle);
+
     bool HasGraphManager() const;
     void ExecuteGraph(USUGGraphManager* InGraphManager);
 
+    // Gather assets referenced by queued tasks that have not been loaded yet
+    void GatherAssetReferences(TArray<FSoftObjectPath>& OutAssetPaths) const;
+
+    // Gather material draws of queued tasks for shader warm-up
+    void GatherMaterialWarmUpEntries(TArray<FSUGGraphMaterialWarmUpEntry>& OutEntries) const;
+
+    // Discard tasks queued by a preparation that will not be executed
+    void DiscardPreparedTasks();
+
 	void GetOutputConfig(FRULShaderOutputConfig& OutConfig) const;
 	FSUGGraphOutputEntry* GetOutput(FName OutputName);
 	UTextureRenderTarget2D* CreateOutputRenderTarget(FName OutputName, const FRULShaderOutputConfig& InOutputConfig);
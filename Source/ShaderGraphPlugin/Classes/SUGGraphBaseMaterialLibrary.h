@@ -46,6 +46,24 @@ class SHADERGRAPHPLUGIN_API USUGGraphBaseMaterialLibrary : public UBlueprintFunc
     typedef FRULShaderVectorParameter FVectorParam;
     typedef FSUGGraphTextureParameter FTextureParam;
 
+    // Task type of native operations, base operation task type if no task
+    // type is specified. Specified task types that are not base operation
+    // tasks are kept and render the operation material instead.
+    static TSubclassOf<USUGGraphTask_ApplyMaterial> GetBaseTaskType(
+        TSubclassOf<USUGGraphTask_ApplyMaterial> TaskType,
+        bool bUseNativeShader
+        );
+
+    // Configure task to render the operation with its built-in global shader,
+    // returns false if the task does not use the native shader
+    static bool SetNativeOperation(
+        USUGGraphTask_ApplyMaterial& Task,
+        TEnumAsByte<enum ESUGGraphBaseOpType> Operation,
+        bool bUseNativeShader,
+        const TArray<FScalarParam>& ScalarParameters,
+        const TArray<FTextureParam>& TextureParameters
+        );
+
 public:
 
     UFUNCTION(BlueprintCallable, meta=(DefaultToSelf="Graph", DisplayName="Levels", AutoCreateRefTerm="TaskConfig,MaterialRef,ScalarParameters,VectorParameters,TextureParameters", AdvancedDisplay="Graph,TaskType,TaskConfig,ConfigMethod,OutputTask,ScalarParameters,VectorParameters,TextureParameters,ParameterCategoryName"))
@@ -65,7 +83,8 @@ public:
         float InRemapValueHi = 1.f,
         float OutRemapValueLo = 0.f,
         float OutRemapValueHi = 1.f,
-        float MidPoint = .5f
+        float MidPoint = .5f,
+        bool bUseNativeShader = false
         );
 
     UFUNCTION(BlueprintCallable, meta=(DefaultToSelf="Graph", DisplayName="Levels Manual", AutoCreateRefTerm="TaskConfig,MaterialRef,ScalarParameters,VectorParameters,TextureParameters", AdvancedDisplay="Graph,TaskType,TaskConfig,ConfigMethod,OutputTask,ScalarParameters,VectorParameters,TextureParameters,ParameterCategoryName"))
@@ -88,7 +107,8 @@ public:
         float LevelsLo = 0.0f,
         float LevelsMi = 0.5f,
         float LevelsHi = 1.0f,
-        float MidPoint = .5f
+        float MidPoint = .5f,
+        bool bUseNativeShader = false
         );
 
     UFUNCTION(BlueprintCallable, meta=(DefaultToSelf="Graph", DisplayName="Blend Target", AutoCreateRefTerm="TaskConfig,MaterialRef,ScalarParameters,VectorParameters,TextureParameters", AdvancedDisplay="Graph,TaskType,ConfigMethod,ScalarParameters,VectorParameters,TextureParameters,ParameterCategoryName"))
@@ -104,7 +124,8 @@ public:
         const TArray<FSUGGraphTextureParameter>& TextureParameters,
         FName ParameterCategoryName,
         FSUGGraphTextureInput SourceTexture,
-        float Opacity = 1.f
+        float Opacity = 1.f,
+        bool bUseNativeShader = false
         );
 
     UFUNCTION(BlueprintCallable, meta=(DefaultToSelf="Graph", DisplayName="Blend Target Masked", AutoCreateRefTerm="TaskConfig,MaterialRef,ScalarParameters,VectorParameters,TextureParameters", AdvancedDisplay="Graph,TaskType,ConfigMethod,ScalarParameters,VectorParameters,TextureParameters,ParameterCategoryName"))
@@ -121,7 +142,8 @@ public:
         FName ParameterCategoryName,
         FSUGGraphTextureInput SourceTexture,
         FSUGGraphTextureInput MaskTexture,
-        float Opacity = 1.f
+        float Opacity = 1.f,
+        bool bUseNativeShader = false
         );
 
     UFUNCTION(BlueprintCallable, meta=(DefaultToSelf="Graph", DisplayName="Blend", AutoCreateRefTerm="TaskConfig,MaterialRef,ScalarParameters,VectorParameters,TextureParameters", AdvancedDisplay="Graph,TaskType,TaskConfig,ConfigMethod,OutputTask,ScalarParameters,VectorParameters,TextureParameters,ParameterCategoryName"))
@@ -138,7 +160,8 @@ public:
         FName ParameterCategoryName,
         FSUGGraphTextureInput BackgroundTexture,
         FSUGGraphTextureInput ForegroundTexture,
-        float Opacity = 1.f
+        float Opacity = 1.f,
+        bool bUseNativeShader = false
         );
 
     UFUNCTION(BlueprintCallable, meta=(DefaultToSelf="Graph", DisplayName="Blend Masked", AutoCreateRefTerm="TaskConfig,MaterialRef,ScalarParameters,VectorParameters,TextureParameters", AdvancedDisplay="Graph,TaskType,TaskConfig,ConfigMethod,OutputTask,ScalarParameters,VectorParameters,TextureParameters,ParameterCategoryName"))
@@ -156,6 +179,7 @@ public:
         FSUGGraphTextureInput BackgroundTexture,
         FSUGGraphTextureInput ForegroundTexture,
         FSUGGraphTextureInput MaskTexture,
-        float Opacity = 1.f
+        float Opacity = 1.f,
+        bool bUseNativeShader = false
         );
 };
@@ -0,0 +1,119 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RHI.h"
+#include "RHICommandList.h"
+#include "RHIUtilities.h"
+
+// Pool of structured buffers used by compute kernels, only accessed on the
+// rendering thread. Buffers acquired during a task dispatch are returned to
+// the pool once the dispatch has completed.
+//
+// Cached buffers persist across dispatches and are keyed by a texture and
+// a size. The key texture is referenced while cached so the key can not
+// match a different texture reusing the same resource. The least recently
+// used cached buffer is released once the cache limit is reached.
+class SHADERGRAPHPLUGIN_API FSUGGraphBufferPool
+{
+    struct FPooledBuffer
+    {
+        FRWBufferStructured Buffer;
+        uint32 BytesPerElement = 0;
+        uint32 NumElements = 0;
+        bool bInUse = false;
+    };
+
+    struct FCachedBuffer
+    {
+        FRWBufferStructured Buffer;
+        FTextureRHIRef KeyTexture;
+        FIntPoint KeySize;
+        uint32 LastUse = 0;
+    };
+
+    TArray<TUniquePtr<FPooledBuffer>> Buffers;
+    TArray<TUniquePtr<FCachedBuffer>> CachedBuffers;
+    uint32 CacheUseCounter = 0;
+
+public:
+
+    enum { MaxCachedBuffers = 8 };
+
+    ~FSUGGraphBufferPool();
+
+    FRWBufferStructured& AcquireBuffer(uint32 BytesPerElement, uint32 NumElements);
+    void ReleaseBuffers();
+    void Empty();
+
+    // Cached buffer of the key, null if not cached
+    FRWBufferStructured* FindCachedBuffer(FTextureRHIParamRef KeyTexture, const FIntPoint& KeySize);
+
+    // Add uninitialized cached buffer of the key, replaces any buffer
+    // previously cached with the same key
+    FRWBufferStructured& AddCachedBuffer(FTextureRHIParamRef KeyTexture, const FIntPoint& KeySize, uint32 BytesPerElement, uint32 NumElements);
+};
+
+// Rendering thread resources of a compute task dispatch
+struct SHADERGRAPHPLUGIN_API FSUGGraphComputeContext
+{
+    TArray<FName> InputNames;
+    TArray<FTextureRHIParamRef> InputTextures;
+
+    FTextureRHIParamRef OutputTexture = nullptr;
+    FUnorderedAccessViewRHIParamRef OutputUAV = nullptr;
+    FIntPoint OutputSize = FIntPoint::ZeroValue;
+
+    FSUGGraphBufferPool* BufferPool = nullptr;
+
+    // Named input texture, black texture if the input is not available
+    FTextureRHIParamRef GetInputTexture(FName InputName) const;
+
+    FORCEINLINE static FIntVector GetGroupCount(const FIntPoint& Size, const FIntPoint& GroupSize)
+    {
+        return FIntVector(
+            FMath::DivideAndRoundUp(Size.X, GroupSize.X),
+            FMath::DivideAndRoundUp(Size.Y, GroupSize.Y),
+            1
+            );
+    }
+};
+
+// Compute kernel of a compute task, created on the game thread with a copy
+// of the task parameters and dispatched on the rendering thread
+class SHADERGRAPHPLUGIN_API FSUGGraphComputeKernel
+{
+public:
+
+    virtual ~FSUGGraphComputeKernel() {}
+
+    virtual void Dispatch(FRHICommandListImmediate& RHICmdList, const FSUGGraphComputeContext& Context) = 0;
+};
+
+typedef TSharedPtr<FSUGGraphComputeKernel, ESPMode::ThreadSafe> FSUGGraphComputeKernelPtr;
@@ -102,7 +102,7 @@ public:
         float BlurSampleCount = 1.f
         );
 
-    UFUNCTION(BlueprintCallable, meta=(DefaultToSelf="Graph", DisplayName="Erode Filter", AutoCreateRefTerm="TaskConfig,MaterialRef,ScalarParameters,VectorParameters,TextureParameters", AdvancedDisplay="Graph,TaskType,TaskConfig,ConfigMethod,OutputTask,ScalarParameters,VectorParameters,TextureParameters,ParameterCategoryName"))
+    UFUNCTION(BlueprintCallable, meta=(DefaultToSelf="Graph", DisplayName="Erode Filter", AutoCreateRefTerm="TaskConfig,MaterialRef,ScalarParameters,VectorParameters,TextureParameters", AdvancedDisplay="Graph,TaskType,TaskConfig,ConfigMethod,OutputTask,ScalarParameters,VectorParameters,TextureParameters,ParameterCategoryName,ConvergenceThreshold"))
     static USUGGraphTask_ErodeFilter* AddErodeFilterTask(
         USUGGraph* Graph,
         TSubclassOf<USUGGraphTask_ErodeFilter> TaskType,
@@ -116,6 +116,8 @@ public:
         FName ParameterCategoryName,
         FSUGGraphTextureInput SourceTexture,
         FSUGGraphTextureInput WeightTexture,
-        int32 IterationCount = 1
+        int32 IterationCount = 1,
+        bool bStopOnConvergence = false,
+        float ConvergenceThreshold = .0001f
         );
 };
@@ -28,11 +28,15 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Engine/StreamableManager.h"
 #include "SUGGraphTypes.h"
 #include "SUGGraphManager.generated.h"
 
+class FSUGGraphBufferPool;
 class USUGGraph;
 
+typedef TSharedPtr<FSUGGraphBufferPool, ESPMode::ThreadSafe> FSUGGraphBufferPoolPtr;
+
 UCLASS(BlueprintType, Blueprintable, meta=(BlueprintSpawnableComponent))
 class SHADERGRAPHPLUGIN_API USUGGraphManager : public UActorComponent
 {
@@ -50,30 +54,158 @@ class SHADERGRAPHPLUGIN_API USUGGraphManager : public UActorComponent
     UPROPERTY()
     TMap<FName, UMaterialInstanceDynamic*> NamedMIDCacheMap;
 
-    int32 FindFreeRTIndex(const FRULShaderOutputConfig& OutputConfig);
+    UPROPERTY()
+    TMap<UMaterialInterface*, FSUGGraphMIDPoolEntry> MIDPoolMap;
+
+    UPROPERTY(Transient)
+    TArray<UTextureRenderTarget2D*> WarmUpRenderTargets;
+
+    // Simulation states persisting across graph executions, keyed by the
+    // simulation name of the owning tasks
+    UPROPERTY(Transient)
+    TMap<FName, FSUGGraphSimulationState> SimulationStateMap;
+
+    // Pipeline state keys of material draws that have been warmed up
+    TMap<TWeakObjectPtr<UMaterialInterface>, TArray<uint16>> WarmedPipelineMap;
+
+    TSharedPtr<FStreamableHandle> PreloadHandle;
+    bool bExecutionDeferred = false;
+
+    FSUGGraphBufferPoolPtr BufferPool;
+
+    int32 FindFreeRTIndex(const FRULShaderOutputConfig& OutputConfig, bool bRequireUAV);
+    UMaterialInterface* GetNamedMaterial(FName MaterialName) const;
+
+    bool StartAssetPreload();
+    void CancelAssetPreload();
+    void OnAssetPreloadCompleted();
+    void ExecuteDeferred();
+
+    bool WarmUpGraphMaterials(bool bBlockOnShaderCompilation);
+    bool IsMaterialShaderReady(UMaterialInterface& Material, bool bBlockOnShaderCompilation) const;
+    void WarmUpMaterialPipeline(UMaterialInterface& Material, const FSUGGraphMaterialWarmUpEntry& Entry);
+    UTextureRenderTarget2D* GetWarmUpRenderTarget(ETextureRenderTargetFormat Format);
+
+protected:
+
+    // Keep streaming pending assets but skip the deferred graph execution
+    void DiscardDeferredExecution();
+
+    FORCEINLINE bool IsExecutionDeferred() const
+    {
+        return bExecutionDeferred;
+    }
 
 public:
 
     UPROPERTY(EditAnywhere, BlueprintReadOnly, meta=(DisplayName="Shader Graph Type"))
     TSubclassOf<USUGGraph> GraphType;
 
+    // User specified priority used by the graph scheduler, higher values are executed first
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Scheduling")
+    float ExecutionPriority = 0.f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Scheduling")
+    bool bPrioritizeByViewDistance = true;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Scheduling")
+    bool bPrioritizeByVisibility = true;
+
+    // Stream in assets referenced by prepared graph tasks asynchronously and
+    // defer graph execution until they have been loaded. Graphs with every
+    // asset loaded still execute immediately. Deferred executions return
+    // from Execute Graph before outputs have been written.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    bool bPreloadAssets = false;
+
+    // Defer graph execution until shaders of graph materials have been
+    // compiled instead of blocking on the first material draw
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    bool bDeferUntilShadersReady = false;
+
     UFUNCTION(BlueprintCallable)
 	UTextureRenderTarget2D* GetGraphOutput(FName OutputName);
 
+    UFUNCTION(BlueprintCallable)
+	int32 GetGraphOutputVersion(FName OutputName) const;
+
     UFUNCTION(BlueprintCallable, meta=(DisplayName="Execute Graph"))
     void K2_ExecuteGraph(USUGGraph* GraphInstance);
 
+    UFUNCTION(BlueprintCallable, meta=(DisplayName="Request Execute Graph"))
+    void K2_RequestExecuteGraph(USUGGraph* GraphInstance);
+
+    UFUNCTION(BlueprintCallable, meta=(DisplayName="Cancel Execute Graph Request"))
+    void K2_CancelExecuteGraphRequest();
+
     UFUNCTION(BlueprintCallable, meta=(DisplayName="Clear Outputs"))
     void K2_ClearOutputs();
 
+    UFUNCTION(BlueprintCallable, meta=(DisplayName="Clear Material Instance Pool"))
+    void K2_ClearMIDPool();
+
+    // Restart the named simulation from its initial state on the next
+    // graph execution
+    UFUNCTION(BlueprintCallable, meta=(DisplayName="Reset Simulation"))
+    void K2_ResetSimulation(FName SimulationName);
+
+    UFUNCTION(BlueprintCallable, meta=(DisplayName="Get Simulation Step Count"))
+    int32 K2_GetSimulationStepCount(FName SimulationName) const;
+
+    UFUNCTION(BlueprintCallable, meta=(DisplayName="Is Asset Preload Pending"))
+    bool K2_IsAssetPreloadPending() const;
+
+    // Compile shaders and create pipeline states of materials referenced by
+    // the graph ahead of its execution, returns whether all shaders are ready
+    UFUNCTION(BlueprintCallable, meta=(DisplayName="Warm Up Graph"))
+    bool K2_WarmUpGraph(USUGGraph* GraphInstance, bool bBlockOnShaderCompilation = false);
+
     void Reset();
     void Initialize(USUGGraph* GraphInstance);
     void Execute();
+    void ExecuteGraph(USUGGraph* GraphInstance);
 
-    UTextureRenderTarget2D* CreateOutputRenderTarget(const FRULShaderOutputConfig& OutputConfig);
-    void FindFreeOutputRT(const FRULShaderOutputConfig& OutputConfig, FSUGGraphOutputRT& OutputRT);
+    FORCEINLINE bool IsAssetPreloadPending() const
+    {
+        return PreloadHandle.IsValid() && PreloadHandle->IsLoadingInProgress();
+    }
+
+    FVector GetSchedulingLocation() const;
+    bool IsSchedulingOwnerVisible() const;
+
+    virtual void BeginDestroy() override;
+
+    virtual UTextureRenderTarget2D* CreateOutputRenderTarget(const FRULShaderOutputConfig& OutputConfig);
+    UTextureRenderTarget2D* CreateUAVOutputRenderTarget(const FRULShaderOutputConfig& OutputConfig);
+    void FindFreeOutputRT(const FRULShaderOutputConfig& OutputConfig, FSUGGraphOutputRT& OutputRT, bool bRequireUAV = false);
     void ClearOutputRTs();
 
+    // Structured buffer pool of compute task dispatches
+    FSUGGraphBufferPoolPtr GetBufferPool();
+    void ClearBufferPool();
+
     UMaterialInstanceDynamic* GetCachedMID(UMaterialInterface* BaseMaterial, bool bClearParameterValues = false);
     UMaterialInstanceDynamic* GetCachedMID(FName MaterialName, bool bClearParameterValues = false);
+
+    // Persistent MID for the next use of the base material within the
+    // current execution, along with the pool handle of the instance
+    UMaterialInstanceDynamic* GetPooledMID(UMaterialInterface* BaseMaterial, FSUGGraphPooledMIDHandle& OutHandle);
+    UMaterialInstanceDynamic* GetPooledMID(FName MaterialName, FSUGGraphPooledMIDHandle& OutHandle);
+
+    // Material parameter layout and the parameter values last applied to a
+    // pooled MID. Only valid until the next pooled MID lookup.
+    bool FindPooledMIDState(
+        const FSUGGraphPooledMIDHandle& Handle,
+        const FSUGGraphMaterialParameterLayout*& OutLayout,
+        FSUGGraphMIDParameterState*& OutState
+        );
+
+    void ResetMIDPoolUsage();
+    void ClearMIDPool();
+
+    FSUGGraphSimulationState& FindOrAddSimulationState(FName SimulationName);
+    const FSUGGraphSimulationState* FindSimulationState(FName SimulationName) const;
+    void ClearSimulationStates();
+
+    bool WarmUpGraph(USUGGraph* GraphInstance, bool bBlockOnShaderCompilation = false);
 };
@@ -0,0 +1,91 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/EngineSubsystem.h"
+#include "Tickable.h"
+#include "SUGGraphScheduler.generated.h"
+
+class USUGGraph;
+class USUGGraphManager;
+
+USTRUCT()
+struct SHADERGRAPHPLUGIN_API FSUGGraphExecutionRequest
+{
+    GENERATED_BODY()
+
+    TWeakObjectPtr<USUGGraphManager> GraphManager;
+
+    UPROPERTY()
+    USUGGraph* GraphInstance = nullptr;
+
+    uint64 RequestFrame = 0;
+    float Priority = 0.f;
+};
+
+UCLASS()
+class SHADERGRAPHPLUGIN_API USUGGraphScheduler : public UEngineSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+    UPROPERTY()
+    TArray<FSUGGraphExecutionRequest> RequestQueue;
+
+    void GatherViewLocations(TArray<FVector>& OutViewLocations) const;
+    void UpdateRequestPriorities();
+
+public:
+
+    static USUGGraphScheduler* Get();
+
+    UFUNCTION(BlueprintCallable)
+    void RequestExecution(USUGGraphManager* GraphManager, USUGGraph* GraphInstance);
+
+    UFUNCTION(BlueprintCallable)
+    void CancelRequest(USUGGraphManager* GraphManager);
+
+    UFUNCTION(BlueprintCallable)
+    bool HasPendingRequest(USUGGraphManager* GraphManager) const;
+
+    FORCEINLINE int32 GetPendingRequestCount() const
+    {
+        return RequestQueue.Num();
+    }
+
+    // FTickableGameObject interface
+
+    virtual void Tick(float DeltaTime) override;
+    virtual bool IsTickable() const override;
+    virtual TStatId GetStatId() const override;
+
+    virtual bool IsTickableInEditor() const override
+    {
+        return true;
+    }
+};
@@ -31,8 +31,10 @@
 #include "SUGGraphTypes.h"
 #include "SUGGraphTask.generated.h"
 
+class UProperty;
 class UTextureRenderTarget2D;
 class USUGGraph;
+class USUGGraphManager;
 
 UCLASS(Abstract, BlueprintType, Blueprintable)
 class SHADERGRAPHPLUGIN_API USUGGraphTask : public UObject
@@ -59,6 +61,33 @@ protected:
     UPROPERTY()
     USUGGraphTask* OutputTask;
 
+    // Output retained between incremental graph executions
+    UPROPERTY(Transient)
+    UTextureRenderTarget2D* PersistentOutputRT;
+
+    FIntRect PendingDirtyRegion;
+    FIntRect ExecutionRegion;
+    uint32 LastStateHash = 0;
+    bool bHasPendingDirtyRegion = false;
+    bool bPendingFullDirty = false;
+    bool bHasExecutionRegion = false;
+    bool bHasIncrementalState = false;
+
+    // Output is never written, the task is evaluated by its dependant task
+    bool bOutputElided = false;
+
+    // Coarse occupancy of the task output, resolved before execution
+    FSUGGraphTileOccupancy TileOccupancy;
+
+    // Hashes of referenced tasks. Specified to hash task references by the
+    // referenced task state and inputs instead of their identity.
+    typedef TMap<const USUGGraphTask*, uint32> FTaskHashMap;
+
+    uint32 CalculateStateHash(FTaskHashMap* TaskHashMap = nullptr) const;
+    uint32 CalculatePropertyHash(FName PropertyName, FTaskHashMap* TaskHashMap = nullptr) const;
+    static uint32 HashPropertyValue(const UProperty& Property, const void* ValuePtr, uint32 Hash, FTaskHashMap* TaskHashMap = nullptr);
+    void GenerateTileOccupancy(const USUGGraph& Graph, const TArray<FBox2D>& Bounds);
+
 public:
 
     UPROPERTY(EditAnywhere, BlueprintReadOnly)
@@ -73,6 +102,23 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadOnly)
     bool bRequireOutput;
 
+    // Radius in pixels of the neighbourhood sampled by the task per pass
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    int32 FootprintRadius;
+
+    // Generate tile occupancy of the task output for dependant tasks
+    // skipping empty tiles
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    bool bGenerateTileOccupancy;
+
+    // Only render output tiles overlapping occupied input tiles, remaining
+    // tiles are cleared. Task output has to be empty where inputs are empty.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    bool bSkipEmptyTiles;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    int32 OccupancyTileSize;
+
     UFUNCTION(BlueprintCallable)
     bool IsTaskExecutionValid(const USUGGraph* Graph) const;
 
@@ -86,6 +132,79 @@ public:
     virtual void Execute(USUGGraph* Graph);
     virtual void PostExecute(USUGGraph* Graph);
 
+    // Total radius in pixels of source pixels affecting a single output pixel
+    virtual int32 GetFootprintRadius() const;
+
+    // Gather referenced assets that have not been loaded yet
+    virtual void GatherAssetReferences(TArray<FSoftObjectPath>& OutAssetPaths) const;
+
+    // Gather tasks sampled by this task. Available before initialization,
+    // inputs are found from task input properties and texture inputs.
+    virtual void GatherInputTasks(TArray<USUGGraphTask*>& OutTasks) const;
+
+    // Gather material draws performed by the task for shader warm-up
+    virtual void GatherMaterialWarmUpEntries(const USUGGraph& Graph, TArray<FSUGGraphMaterialWarmUpEntry>& OutEntries) const;
+
+    // Whether the task is able to render a sub region of its output during
+    // incremental graph execution
+    virtual bool SupportsRegionExecution() const;
+
+    // Whether the task output is written through an unordered access view
+    virtual bool RequiresUAVOutput() const;
+
+    // Resolve evaluation of input tasks within this task, called on every
+    // queued task in order before non-incremental graph task execution
+    virtual void ResolveFusion(USUGGraph& Graph);
+
+    FORCEINLINE bool IsOutputElided() const
+    {
+        return bOutputElided;
+    }
+
+    FORCEINLINE int32 GetDependantCount() const
+    {
+        return DependantOutputList.Num();
+    }
+
+    // Re-render the whole task output on the next incremental execution
+    UFUNCTION(BlueprintCallable)
+    void MarkDirty();
+
+    // Re-render output region, in output pixels, on the next incremental
+    // execution. Property changes without marked regions re-render the whole
+    // output.
+    UFUNCTION(BlueprintCallable)
+    void MarkDirtyRegion(FIntPoint RegionMin, FIntPoint RegionMax);
+
+    // Mark output regions affected by task state changes, called before the
+    // incremental execution region is resolved. State changes without marked
+    // regions re-render the whole output.
+    virtual void MarkChangedRegions(const USUGGraph& Graph);
+
+    FORCEINLINE bool HasExecutionRegion() const
+    {
+        return bHasExecutionRegion;
+    }
+
+    FORCEINLINE const FIntRect& GetExecutionRegion() const
+    {
+        return ExecutionRegion;
+    }
+
+    // Resolve output tile occupancy, called before task execution
+    virtual void ResolveTileOccupancy(const USUGGraph& Graph);
+
+    FORCEINLINE const FSUGGraphTileOccupancy& GetTileOccupancy() const
+    {
+        return TileOccupancy;
+    }
+
+    bool HasSparseTileOccupancy() const;
+    bool IsPartialExecutionRegion() const;
+    void ResolveExecutionRegion(bool bForceFullRegion);
+    void ResetIncrementalState();
+    bool AssignPersistentOutput(USUGGraphManager& GraphManager, const FRULShaderOutputConfig& OutputConfig);
+
     FORCEINLINE bool IsOutputRequired() const
     {
         return bRequireOutput;
@@ -113,7 +232,7 @@ public:
         USUGGraphTask* InputTask = nullptr
         );
 
-    void ResolveOutputConfig(const USUGGraph& Graph);
+    virtual void ResolveOutputConfig(const USUGGraph& Graph);
     void GetResolvedOutputConfig(FRULShaderOutputConfig& OutConfig) const;
     USUGGraphTask* GetInputTask() const;
 
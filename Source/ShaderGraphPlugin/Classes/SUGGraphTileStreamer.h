@@ -0,0 +1,152 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RenderCommandFence.h"
+#include "SUGGraphManager.h"
+#include "SUGGraphTypes.h"
+#include "SUGGraphTileStreamer.generated.h"
+
+class AActor;
+class UTextureRenderTarget2D;
+class USUGGraph;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FSUGGraphTileGeneratedSignature, FIntPoint, TileCoordinates, float, GenerationLatency);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FSUGGraphTileEvictedSignature, FIntPoint, TileCoordinates);
+
+USTRUCT(BlueprintType)
+struct SHADERGRAPHPLUGIN_API FSUGGraphStreamedTile
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly)
+    FSUGGraphStreamingTile Tile;
+
+    UPROPERTY(BlueprintReadOnly)
+    TMap<FName, UTextureRenderTarget2D*> Outputs;
+
+    // Seconds between the tile being requested and its generation
+    // commands being processed by the rendering thread
+    UPROPERTY(BlueprintReadOnly)
+    float GenerationLatency = -1.f;
+
+    int64 MemorySize = 0;
+    double RequestTime = 0.0;
+    bool bGenerationPending = false;
+    FRenderCommandFence GenerationFence;
+};
+
+UCLASS(BlueprintType, Blueprintable, meta=(BlueprintSpawnableComponent))
+class SHADERGRAPHPLUGIN_API USUGGraphTileStreamer : public USUGGraphManager
+{
+	GENERATED_UCLASS_BODY()
+
+    struct FTileRequest
+    {
+        FIntPoint Coordinates;
+        float DistanceSq;
+    };
+
+    UPROPERTY(Transient)
+    USUGGraph* TileGraph;
+
+    UPROPERTY(Transient)
+    TMap<FIntPoint, FSUGGraphStreamedTile> TileCache;
+
+    // Output render targets of evicted tiles available for reuse
+    UPROPERTY(Transient)
+    TArray<UTextureRenderTarget2D*> FreeOutputRTs;
+
+    TMap<FIntPoint, double> RequestTimeMap;
+    int64 CacheMemorySize = 0;
+
+    void GatherStreamingSources(TArray<FVector>& OutLocations) const;
+    void GatherRequiredTiles(const TArray<FVector>& SourceLocations, TArray<FTileRequest>& OutRequests) const;
+    void GenerateTile(const FIntPoint& Coordinates);
+    void UpdatePendingTiles();
+    void EvictTiles(const TArray<FVector>& SourceLocations);
+    void EvictTile(const FIntPoint& Coordinates);
+    float GetTileDistanceSq(const FIntPoint& Coordinates, const TArray<FVector>& SourceLocations) const;
+
+    static int64 GetRenderTargetMemorySize(const UTextureRenderTarget2D* RenderTarget);
+
+public:
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Streaming", meta=(ClampMin="1"))
+    float TileSize = 10000.f;
+
+    // Tiles whose center lies within this distance from any streaming source are generated
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Streaming")
+    float StreamingRadius = 30000.f;
+
+    // Cached tiles farther than this distance from all streaming sources are evicted
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Streaming")
+    float EvictionRadius = 40000.f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Streaming", meta=(ClampMin="0"))
+    int32 MemoryBudgetMB = 256;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Streaming", meta=(ClampMin="1"))
+    int32 MaxTilesPerFrame = 1;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Streaming")
+    bool bUsePlayerViewsAsStreamingSources = true;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Streaming")
+    TArray<AActor*> StreamingSources;
+
+    UPROPERTY(BlueprintAssignable)
+    FSUGGraphTileGeneratedSignature OnTileGenerated;
+
+    UPROPERTY(BlueprintAssignable)
+    FSUGGraphTileEvictedSignature OnTileEvicted;
+
+    virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+    virtual UTextureRenderTarget2D* CreateOutputRenderTarget(const FRULShaderOutputConfig& OutputConfig) override;
+
+    UFUNCTION(BlueprintCallable)
+    FIntPoint GetTileCoordinates(const FVector& WorldLocation) const;
+
+    UFUNCTION(BlueprintCallable)
+    bool HasTile(FIntPoint TileCoordinates) const;
+
+    UFUNCTION(BlueprintCallable)
+    UTextureRenderTarget2D* GetTileOutput(FIntPoint TileCoordinates, FName OutputName) const;
+
+    UFUNCTION(BlueprintCallable)
+    float GetTileGenerationLatency(FIntPoint TileCoordinates) const;
+
+    UFUNCTION(BlueprintCallable)
+    void ClearTiles();
+
+    FORCEINLINE int64 GetCacheMemorySize() const
+    {
+        return CacheMemorySize;
+    }
+};
@@ -32,9 +32,11 @@
 #include "Templates/RefCounting.h"
 #include "SUGGraphTypes.generated.h"
 
+class UMaterialInstanceDynamic;
 class UMaterialInterface;
 class UTexture;
 class UTextureRenderTarget2D;
+class USUGGraphManager;
 class USUGGraphTask;
 
 class FRefCountedObject_Debug : public FRefCountedObject
@@ -56,6 +58,48 @@ enum ESUGGraphConfigMethod
 	RUL_CM_Absolute
 };
 
+// Base material library operations with built-in global shader
+// implementations, must match operation types of SUGGraphBaseOp.usf
+UENUM(BlueprintType)
+enum ESUGGraphBaseOpType
+{
+	SUG_BOP_Levels,
+	SUG_BOP_LevelsManual,
+	SUG_BOP_Blend,
+	SUG_BOP_BlendMasked,
+	SUG_BOP_BlendTarget,
+	SUG_BOP_BlendTargetMasked,
+	SUG_BOP_MAX UMETA(Hidden)
+};
+
+UENUM(BlueprintType)
+enum ESUGGraphHistogramBinCount
+{
+	SUG_HBC_256,
+	SUG_HBC_1024
+};
+
+UENUM(BlueprintType)
+enum ESUGGraphMorphologyOp
+{
+	// Maximum over the structuring element, grows masks
+	SUG_MO_Dilate,
+	// Minimum over the structuring element, shrinks masks
+	SUG_MO_Erode
+};
+
+UENUM(BlueprintType)
+enum ESUGGraphBlurMethod
+{
+	// Pyramid blur for radii beyond the pyramid level radius, separable blur
+	// otherwise
+	SUG_BM_Auto,
+	// Full resolution horizontal and vertical gaussian passes
+	SUG_BM_Separable,
+	// Gaussian blur of a downsampled pyramid level followed by upsampling
+	SUG_BM_Pyramid
+};
+
 USTRUCT(BlueprintType)
 struct SHADERGRAPHPLUGIN_API FSUGGraphTaskConfig
 {
@@ -92,10 +136,136 @@ struct SHADERGRAPHPLUGIN_API FSUGGraphOutputRT
 
     bool IsValidOutput() const;
     bool CompareFormat(const FRULShaderOutputConfig& OutputConfig) const;
+    static bool CompareFormat(const UTextureRenderTarget2D& RenderTarget, const FRULShaderOutputConfig& OutputConfig);
     void ClearReferenceId();
     void CreateReferenceId();
 };
 
+// Parameter values last applied to a pooled material instance, indexed by
+// material parameter layout index
+struct SHADERGRAPHPLUGIN_API FSUGGraphMIDParameterState
+{
+    TArray<float> Scalars;
+    TArray<FLinearColor> Vectors;
+    TArray<UTexture*> Textures;
+
+    // Task that applied parameters to the instance last
+    TWeakObjectPtr<const UObject> LastOwner;
+
+    // Tracked values match the instance parameters. Cleared after
+    // parameters are written to the instance directly, every parameter is
+    // reapplied on the next use of the instance.
+    bool bValuesValid = true;
+};
+
+// Pooled material instance of a base material. Parameter layout and state
+// of the instance are resolved through the owning graph manager on every
+// use, pool storage may be reallocated by subsequent pool lookups.
+struct SHADERGRAPHPLUGIN_API FSUGGraphPooledMIDHandle
+{
+    USUGGraphManager* Manager = nullptr;
+    UMaterialInterface* BaseMaterial = nullptr;
+    int32 InstanceIndex = INDEX_NONE;
+
+    FORCEINLINE bool IsValid() const
+    {
+        return Manager && BaseMaterial && InstanceIndex != INDEX_NONE;
+    }
+
+    FORCEINLINE void Reset()
+    {
+        *this = FSUGGraphPooledMIDHandle();
+    }
+};
+
+// Scalar and vector parameters of a base material resolved to parameter
+// indices shared by every pooled instance of the material
+struct SHADERGRAPHPLUGIN_API FSUGGraphMaterialParameterLayout
+{
+    TMap<FName, int32> ScalarIndexMap;
+    TMap<FName, int32> VectorIndexMap;
+    TMap<FName, int32> TextureIndexMap;
+
+    TArray<FName> ScalarNames;
+    TArray<FName> VectorNames;
+    TArray<FName> TextureNames;
+
+    // Instance parameter index of each layout parameter
+    TArray<int32> ScalarSlots;
+    TArray<int32> VectorSlots;
+
+    TArray<float> ScalarDefaults;
+    TArray<FLinearColor> VectorDefaults;
+    TArray<UTexture*> TextureDefaults;
+
+    // Unique identifier of the built layout
+    uint32 LayoutId = 0;
+
+    bool bIsBuilt = false;
+    bool bHasSlots = false;
+
+    void Build(const UMaterialInterface& Material);
+    void InitializeInstance(UMaterialInstanceDynamic& MID, FSUGGraphMIDParameterState& State);
+
+    FORCEINLINE int32 FindScalarIndex(FName ParameterName) const
+    {
+        const int32* Index = ScalarIndexMap.Find(ParameterName);
+        return Index ? *Index : INDEX_NONE;
+    }
+
+    FORCEINLINE int32 FindVectorIndex(FName ParameterName) const
+    {
+        const int32* Index = VectorIndexMap.Find(ParameterName);
+        return Index ? *Index : INDEX_NONE;
+    }
+
+    FORCEINLINE int32 FindTextureIndex(FName ParameterName) const
+    {
+        const int32* Index = TextureIndexMap.Find(ParameterName);
+        return Index ? *Index : INDEX_NONE;
+    }
+};
+
+// Persistent material instances of a base material, instances are assigned
+// by order of use within a graph execution
+USTRUCT()
+struct SHADERGRAPHPLUGIN_API FSUGGraphMIDPoolEntry
+{
+    GENERATED_BODY()
+
+    FSUGGraphMaterialParameterLayout ParameterLayout;
+
+    UPROPERTY(Transient)
+    TArray<UMaterialInstanceDynamic*> Instances;
+
+    TArray<FSUGGraphMIDParameterState> ParameterStates;
+
+    int32 UseCount = 0;
+};
+
+// Render targets and progress of a simulation persisting across graph
+// executions, owned by the graph manager
+USTRUCT()
+struct SHADERGRAPHPLUGIN_API FSUGGraphSimulationState
+{
+    GENERATED_BODY()
+
+    UPROPERTY(Transient)
+    TArray<UTextureRenderTarget2D*> StateTextures;
+
+    // Simulation steps completed since the state was initialized
+    int32 StepCount = 0;
+
+    // Hash of the source the state was initialized from
+    uint32 SourceHash = 0;
+
+    bool IsValidState(int32 TextureCount, const FRULShaderOutputConfig& StateConfig) const;
+    void Reset();
+
+    // Reset simulation progress, keeping the state render targets
+    void Restart();
+};
+
 USTRUCT(BlueprintType)
 struct SHADERGRAPHPLUGIN_API FSUGGraphTextureInput
 {
@@ -107,7 +277,69 @@ struct SHADERGRAPHPLUGIN_API FSUGGraphTextureInput
     UPROPERTY(EditAnywhere, BlueprintReadWrite)
     USUGGraphTask* Task = nullptr;
 
+    // Texture streamed in by graph asset preloading, used if no texture
+    // has been assigned
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    TSoftObjectPtr<UTexture> SoftTexture;
+
+    FORCEINLINE bool operator==(const FSUGGraphTextureInput& Other) const
+    {
+        return Texture == Other.Texture && Task == Other.Task && SoftTexture == Other.SoftTexture;
+    }
+
     bool HasValidInput() const;
+    UTexture* GetTexture() const;
+    void GatherAssetReferences(TArray<FSoftObjectPath>& OutAssetPaths) const;
+};
+
+// Runtime parameter storage of material tasks. Parameters are kept in
+// arrays sorted by name and applied by a linear scan.
+USTRUCT()
+struct SHADERGRAPHPLUGIN_API FSUGGraphParameterBlock
+{
+    GENERATED_BODY()
+
+    UPROPERTY(VisibleInstanceOnly)
+    TArray<FName> ScalarNames;
+
+    UPROPERTY(VisibleInstanceOnly)
+    TArray<float> ScalarValues;
+
+    UPROPERTY(VisibleInstanceOnly)
+    TArray<FName> VectorNames;
+
+    UPROPERTY(VisibleInstanceOnly)
+    TArray<FLinearColor> VectorValues;
+
+    UPROPERTY(VisibleInstanceOnly)
+    TArray<FName> TextureNames;
+
+    UPROPERTY(VisibleInstanceOnly)
+    TArray<FSUGGraphTextureInput> TextureInputs;
+
+    // Textures resolved from texture inputs during execution
+    UPROPERTY(Transient)
+    TArray<UTexture*> ResolvedTextures;
+
+    // Parameters changed since parameters were last applied
+    TBitArray<> DirtyScalars;
+    TBitArray<> DirtyVectors;
+
+    // Parameters have been added since parameters were last applied
+    bool bLayoutDirty = true;
+
+    // Incremented whenever parameter names are added or removed
+    uint32 LayoutVersion = 0;
+
+    void SetScalar(FName ParameterName, float Value);
+    void SetVector(FName ParameterName, const FLinearColor& Value);
+    void SetTexture(FName ParameterName, const FSUGGraphTextureInput& Value);
+    void RemoveTexture(FName ParameterName);
+    void Reset();
+    void ClearDirty();
+
+    float GetScalar(FName ParameterName, float DefaultValue = 0.f) const;
+    UTexture* GetResolvedTexture(FName ParameterName) const;
 };
 
 USTRUCT(BlueprintType)
@@ -120,6 +352,30 @@ struct SHADERGRAPHPLUGIN_API FSUGGraphMaterialRef
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite)
     FName MaterialName;
+
+    // Material streamed in by graph asset preloading, used if no material
+    // has been assigned
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    TSoftObjectPtr<UMaterialInterface> SoftMaterial;
+
+    UMaterialInterface* GetMaterial() const;
+    void GatherAssetReferences(TArray<FSoftObjectPath>& OutAssetPaths) const;
+};
+
+// Material draw state used to compile shaders and create pipeline states
+// ahead of graph execution
+struct SHADERGRAPHPLUGIN_API FSUGGraphMaterialWarmUpEntry
+{
+    UMaterialInterface* Material = nullptr;
+    FName MaterialName;
+    TEnumAsByte<ETextureRenderTargetFormat> Format;
+    FRULShaderDrawConfig DrawConfig;
+
+    // Key identifying pipeline state variation of the material draw
+    FORCEINLINE uint16 GetPipelineKey() const
+    {
+        return (uint16(Format.GetValue()) << 8) | uint16(static_cast<uint8>(DrawConfig.BlendType));
+    }
 };
 
 USTRUCT(BlueprintType)
@@ -141,6 +397,92 @@ struct SHADERGRAPHPLUGIN_API FSUGGraphTextureParameter
     }
 };
 
+USTRUCT(BlueprintType)
+struct SHADERGRAPHPLUGIN_API FSUGGraphStreamingTile
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly)
+    FIntPoint Coordinates = FIntPoint::ZeroValue;
+
+    // World space origin (minimum corner) of the tile
+    UPROPERTY(EditAnywhere, BlueprintReadOnly)
+    FVector2D Origin = FVector2D::ZeroVector;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly)
+    float Size = 0.f;
+};
+
+USTRUCT(BlueprintType)
+struct SHADERGRAPHPLUGIN_API FSUGGraphTiledExecutionConfig
+{
+    GENERATED_BODY()
+
+    // Split graph output domain into tiles, each tile is executed separately
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    bool bEnabled = false;
+
+    // Maximum tile render size including halo margins
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, meta=(ClampMin="1"))
+    int32 MaxTileSize = 2048;
+
+    // Halo margin added on top of the margin derived from task footprints
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, meta=(ClampMin="0"))
+    int32 ExtraHaloMargin = 0;
+};
+
+USTRUCT(BlueprintType)
+struct SHADERGRAPHPLUGIN_API FSUGGraphExecutionTile
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly)
+    FIntPoint TileIndex = FIntPoint::ZeroValue;
+
+    UPROPERTY(BlueprintReadOnly)
+    FIntPoint TileCount = FIntPoint::ZeroValue;
+
+    UPROPERTY(BlueprintReadOnly)
+    FIntPoint DomainSize = FIntPoint::ZeroValue;
+
+    // Resolved tile region in graph domain pixels
+    FIntRect InteriorRect;
+
+    // Rendered tile region including halo margins in graph domain pixels
+    FIntRect RenderRect;
+
+    FORCEINLINE bool IsValid() const
+    {
+        return TileCount.X > 0 && TileCount.Y > 0;
+    }
+
+    FORCEINLINE int32 GetLinearIndex() const
+    {
+        return TileIndex.Y * TileCount.X + TileIndex.X;
+    }
+};
+
+// Coarse occupancy of a task output, unoccupied tiles only contain empty
+// pixels. Invalid (uninitialized) occupancy is treated as fully occupied.
+struct SHADERGRAPHPLUGIN_API FSUGGraphTileOccupancy
+{
+    FIntPoint Dimension = FIntPoint::ZeroValue;
+    FIntPoint TileCount = FIntPoint::ZeroValue;
+    int32 TileSize = 0;
+    TBitArray<> OccupiedTiles;
+
+    FORCEINLINE bool IsValid() const
+    {
+        return OccupiedTiles.Num() > 0;
+    }
+
+    void Init(const FIntPoint& InDimension, int32 InTileSize);
+    void Reset();
+    bool IsFullyOccupied() const;
+    void MarkRect(const FIntRect& Rect);
+    void MergeOccupancy(const FSUGGraphTileOccupancy& Occupancy, int32 DilationRadius);
+    void GetOccupiedRects(TArray<FIntRect>& OutRects) const;
+};
 
 USTRUCT(BlueprintType)
 struct SHADERGRAPHPLUGIN_API FSUGGraphParameterNameMap
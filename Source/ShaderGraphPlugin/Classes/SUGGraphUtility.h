@@ -39,12 +39,20 @@ class UTextureRenderTarget2D;
 class USUGGraphTask;
 class USUGGraphTask_ApplyMaterial;
 class USUGGraphTask_AutoLevel;
+class USUGGraphTask_BoxFilter;
+class USUGGraphTask_Convolution;
 class USUGGraphTask_DrawTaskToOutput;
 class USUGGraphTask_DrawTaskToTexture;
 class USUGGraphTask_DrawGeometry;
 class USUGGraphTask_DrawMaterialPoly;
 class USUGGraphTask_DrawMaterialQuad;
+class USUGGraphTask_GaussianBlur;
+class USUGGraphTask_Histogram;
+class USUGGraphTask_HydraulicErosion;
+class USUGGraphTask_JumpFlood;
+class USUGGraphTask_Morphology;
 class USUGGraphTask_ResolveOutput;
+class USUGGraphTask_SummedAreaTable;
 
 UCLASS()
 class SHADERGRAPHPLUGIN_API USUGGraphUtility : public UBlueprintFunctionLibrary
@@ -194,6 +202,109 @@ public:
         USUGGraphTask* OutputTask,
         FSUGGraphTextureInput SourceTexture,
         bool bApplyLevelMin = true,
-        bool bApplyLevelMax = true
+        bool bApplyLevelMax = true,
+        bool bUseNativeShader = false
+        );
+
+    UFUNCTION(BlueprintCallable, meta=(DefaultToSelf="Graph", DisplayName="Gaussian Blur", AutoCreateRefTerm="TaskConfig", AdvancedDisplay="Graph,TaskType,TaskConfig,ConfigMethod,OutputTask,BlurSigma,BlurMethod"))
+    static USUGGraphTask_GaussianBlur* AddGaussianBlurTask(
+        USUGGraph* Graph,
+        TSubclassOf<USUGGraphTask_GaussianBlur> TaskType,
+        const FSUGGraphTaskConfig& TaskConfig,
+        TEnumAsByte<enum ESUGGraphConfigMethod> ConfigMethod,
+        USUGGraphTask* OutputTask,
+        FSUGGraphTextureInput SourceTexture,
+        int32 BlurRadius = 4,
+        float BlurSigma = 0.f,
+        TEnumAsByte<enum ESUGGraphBlurMethod> BlurMethod = SUG_BM_Auto
+        );
+
+    UFUNCTION(BlueprintCallable, meta=(DefaultToSelf="Graph", DisplayName="Jump Flood Distance", AutoCreateRefTerm="TaskConfig", AdvancedDisplay="Graph,TaskType,TaskConfig,ConfigMethod,OutputTask"))
+    static USUGGraphTask_JumpFlood* AddJumpFloodTask(
+        USUGGraph* Graph,
+        TSubclassOf<USUGGraphTask_JumpFlood> TaskType,
+        const FSUGGraphTaskConfig& TaskConfig,
+        TEnumAsByte<enum ESUGGraphConfigMethod> ConfigMethod,
+        USUGGraphTask* OutputTask,
+        FSUGGraphTextureInput SourceTexture,
+        float SeedThreshold = .5f,
+        float MaxDistance = 0.f
+        );
+
+    UFUNCTION(BlueprintCallable, meta=(DefaultToSelf="Graph", DisplayName="Histogram", AutoCreateRefTerm="TaskConfig", AdvancedDisplay="Graph,TaskType,TaskConfig,OutputTask,RangeMin,RangeMax"))
+    static USUGGraphTask_Histogram* AddHistogramTask(
+        USUGGraph* Graph,
+        TSubclassOf<USUGGraphTask_Histogram> TaskType,
+        const FSUGGraphTaskConfig& TaskConfig,
+        USUGGraphTask* OutputTask,
+        FSUGGraphTextureInput SourceTexture,
+        TEnumAsByte<enum ESUGGraphHistogramBinCount> BinCount = SUG_HBC_256,
+        int32 SourceChannel = 0,
+        float PercentileLo = .01f,
+        float PercentileHi = .99f,
+        float RangeMin = 0.f,
+        float RangeMax = 1.f
+        );
+
+    UFUNCTION(BlueprintCallable, meta=(DefaultToSelf="Graph", DisplayName="Hydraulic Erosion", AutoCreateRefTerm="TaskConfig", AdvancedDisplay="Graph,TaskType,TaskConfig,ConfigMethod,OutputTask"))
+    static USUGGraphTask_HydraulicErosion* AddHydraulicErosionTask(
+        USUGGraph* Graph,
+        TSubclassOf<USUGGraphTask_HydraulicErosion> TaskType,
+        const FSUGGraphTaskConfig& TaskConfig,
+        TEnumAsByte<enum ESUGGraphConfigMethod> ConfigMethod,
+        USUGGraphTask* OutputTask,
+        FSUGGraphTextureInput SourceTexture,
+        FName SimulationName = TEXT("HydraulicErosion"),
+        int32 StepCount = 1024,
+        int32 StepsPerExecution = 32
+        );
+
+    UFUNCTION(BlueprintCallable, meta=(DefaultToSelf="Graph", DisplayName="Morphology", AutoCreateRefTerm="TaskConfig", AdvancedDisplay="Graph,TaskType,TaskConfig,ConfigMethod,OutputTask"))
+    static USUGGraphTask_Morphology* AddMorphologyTask(
+        USUGGraph* Graph,
+        TSubclassOf<USUGGraphTask_Morphology> TaskType,
+        const FSUGGraphTaskConfig& TaskConfig,
+        TEnumAsByte<enum ESUGGraphConfigMethod> ConfigMethod,
+        USUGGraphTask* OutputTask,
+        FSUGGraphTextureInput SourceTexture,
+        TEnumAsByte<enum ESUGGraphMorphologyOp> Operation = SUG_MO_Dilate,
+        int32 Radius = 1
+        );
+
+    UFUNCTION(BlueprintCallable, meta=(DefaultToSelf="Graph", DisplayName="Summed Area Table", AutoCreateRefTerm="TaskConfig", AdvancedDisplay="Graph,TaskType,TaskConfig,ConfigMethod,OutputTask"))
+    static USUGGraphTask_SummedAreaTable* AddSummedAreaTableTask(
+        USUGGraph* Graph,
+        TSubclassOf<USUGGraphTask_SummedAreaTable> TaskType,
+        const FSUGGraphTaskConfig& TaskConfig,
+        TEnumAsByte<enum ESUGGraphConfigMethod> ConfigMethod,
+        USUGGraphTask* OutputTask,
+        FSUGGraphTextureInput SourceTexture,
+        bool bSubtractSourceMean = true,
+        float ValueOffset = .5f
+        );
+
+    UFUNCTION(BlueprintCallable, meta=(DefaultToSelf="Graph", DisplayName="Box Filter", AutoCreateRefTerm="TaskConfig", AdvancedDisplay="Graph,TaskType,TaskConfig,ConfigMethod,OutputTask"))
+    static USUGGraphTask_BoxFilter* AddBoxFilterTask(
+        USUGGraph* Graph,
+        TSubclassOf<USUGGraphTask_BoxFilter> TaskType,
+        const FSUGGraphTaskConfig& TaskConfig,
+        TEnumAsByte<enum ESUGGraphConfigMethod> ConfigMethod,
+        USUGGraphTask* OutputTask,
+        FSUGGraphTextureInput SummedAreaTable,
+        FSUGGraphTextureInput RadiusTexture,
+        float Radius = 1.f
+        );
+
+    UFUNCTION(BlueprintCallable, meta=(DefaultToSelf="Graph", DisplayName="Convolution", AutoCreateRefTerm="TaskConfig", AdvancedDisplay="Graph,TaskType,TaskConfig,ConfigMethod,OutputTask"))
+    static USUGGraphTask_Convolution* AddConvolutionTask(
+        USUGGraph* Graph,
+        TSubclassOf<USUGGraphTask_Convolution> TaskType,
+        const FSUGGraphTaskConfig& TaskConfig,
+        TEnumAsByte<enum ESUGGraphConfigMethod> ConfigMethod,
+        USUGGraphTask* OutputTask,
+        FSUGGraphTextureInput SourceTexture,
+        FSUGGraphTextureInput KernelTexture,
+        bool bNormalizeKernel = true,
+        int32 MaxDirectKernelSize = 15
         );
 };
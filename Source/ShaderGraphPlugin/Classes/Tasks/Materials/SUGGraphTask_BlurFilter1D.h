@@ -54,4 +54,12 @@ public:
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite)
     FName SourceTextureParameterName;
+
+    // Material scalar parameter holding the blur sample count, determines
+    // the task footprint radius
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    FName BlurSampleCountParameterName = TEXT("BlurSampleCount");
+
+    virtual int32 GetFootprintRadius() const override;
+    virtual bool SupportsRegionExecution() const override;
 };
@@ -42,13 +42,44 @@ class SHADERGRAPHPLUGIN_API USUGGraphTask_ErodeFilter : public USUGGraphTask_App
 
 protected:
 
+    // Number of filter iterations run by the last execution
+    UPROPERTY(Transient, VisibleInstanceOnly)
+    int32 ExecutedIterationCount = 0;
+
     virtual void ExecuteMaterialFunction(USUGGraph& Graph, UMaterialInstanceDynamic& MID);
 
+    void ExecuteConvergingIterations(USUGGraph& Graph, UMaterialInstanceDynamic& MID);
+
 public:
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite)
     FName SourceTextureParameterName;
 
+    // Iteration count, the maximum iteration count if iterations stop on
+    // convergence
     UPROPERTY(EditAnywhere, BlueprintReadWrite)
     int32 IterationCount;
+
+    // Measure change between iterations and stop once the filter converges
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    bool bStopOnConvergence = false;
+
+    // Iterations between convergence checks. Each check waits for the GPU
+    // to finish the iterations run so far.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, meta=(ClampMin="1", EditCondition="bStopOnConvergence"))
+    int32 ConvergenceCheckInterval = 8;
+
+    // Iterations stop once no texel changes by more than the threshold
+    // between two consecutive iterations
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, meta=(ClampMin="0", EditCondition="bStopOnConvergence"))
+    float ConvergenceThreshold = .0001f;
+
+    virtual int32 GetFootprintRadius() const override;
+    virtual bool SupportsRegionExecution() const override;
+
+    UFUNCTION(BlueprintCallable)
+    FORCEINLINE int32 GetExecutedIterationCount() const
+    {
+        return ExecutedIterationCount;
+    }
 };
@@ -44,16 +44,70 @@ class SHADERGRAPHPLUGIN_API USUGGraphTask_ApplyMaterial : public USUGGraphTask
 
 protected:
 
-    UPROPERTY(Transient)
-    TMap<FName, UTexture*> ResolvedTextureInputMap;
+    // Runtime parameters, populated by parameter setters and merged with
+    // the editor facing input maps on initialization
+    UPROPERTY(VisibleInstanceOnly)
+    FSUGGraphParameterBlock ParameterBlock;
+
+    // Pool handle of the MID in use, invalid for non pooled MIDs
+    FSUGGraphPooledMIDHandle PooledMID;
+
+    // Parameter layout and last applied parameter values of the pooled MID
+    // in use, only valid until the next pooled MID lookup
+    bool FindPooledMIDState(const FSUGGraphMaterialParameterLayout*& OutLayout, FSUGGraphMIDParameterState*& OutState) const;
+
+    // Material parameter layout index of every parameter block entry,
+    // resolved once per material parameter layout and parameter block layout
+    TArray<int32> ScalarLayoutIndices;
+    TArray<int32> VectorLayoutIndices;
+    TArray<int32> TextureLayoutIndices;
+
+    // Layout index of restored vector parameters not part of the block
+    TArray<TPair<FName, int32>> RestoredVectorLayoutIndices;
+
+    uint32 SlotMapLayoutId = 0;
+    uint32 SlotMapBlockVersion = 0;
+
+    void ResolveParameterSlots(const FSUGGraphMaterialParameterLayout& Layout);
+
+    int32 ApplyScalarParameter(UMaterialInstanceDynamic& MID, int32 BlockIndex, const FSUGGraphMaterialParameterLayout& Layout, FSUGGraphMIDParameterState& State);
+    int32 ApplyVectorParameter(UMaterialInstanceDynamic& MID, int32 BlockIndex, const FSUGGraphMaterialParameterLayout& Layout, FSUGGraphMIDParameterState& State);
+    void ApplyTextureParameters(UMaterialInstanceDynamic& MID, const FSUGGraphMaterialParameterLayout* Layout, FSUGGraphMIDParameterState* State);
+    void RestoreVectorParameter(UMaterialInstanceDynamic& MID, FName ParameterName);
+
+    // Scalar parameter value to be applied to the material, valid before
+    // editor facing inputs have been merged on initialization
+    float GetScalarParameterValue(FName ParameterName, float DefaultValue = 0.f) const;
+
+    // Mark tracked parameter values of the pooled MID in use stale, must be
+    // called after writing parameters to the MID directly, e.g. by multi
+    // pass draws
+    void InvalidateParameterState();
 
     virtual void ExecuteMaterialFunction(USUGGraph& Graph, UMaterialInstanceDynamic& MID);
 
+    FIntPoint GetRegionTargetSize(const FIntPoint& RegionSize) const;
+    void ExecuteMaterialRegion(USUGGraph& Graph, UMaterialInstanceDynamic& MID, const FIntRect& Region);
+    void ExecuteMaterialTiles(USUGGraph& Graph, UMaterialInstanceDynamic& MID);
+
+    // Geometry hash and occupancy bounds union of the last execution
+    uint32 LastGeometryHash = 0;
+    FBox2D LastGeometryBounds = FBox2D(ForceInit);
+    bool bHasGeometryState = false;
+
+    // Mark the union of previous and current geometry bounds dirty if the
+    // geometry hash has changed. Changed geometry without bounds marks the
+    // whole output dirty.
+    void MarkGeometryChangedRegions(const USUGGraph& Graph, uint32 GeometryHash, const TArray<FBox2D>& GeometryBounds);
+
 public:
 
     UPROPERTY(EditAnywhere, BlueprintReadOnly)
     FSUGGraphMaterialRef MaterialRef;
 
+    // Editor facing parameter inputs, runtime parameters are assigned with
+    // the parameter setters
+
     UPROPERTY(EditAnywhere, BlueprintReadWrite)
     TMap<FName, float> ScalarInputMap;
 
@@ -63,8 +117,16 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite)
     TMap<FName, FSUGGraphTextureInput> TextureInputMap;
 
+    // Material maps output UV through the region UV transform parameter and
+    // is able to render output sub regions during incremental execution
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    bool bRegionAwareMaterial = false;
+
     virtual void Initialize(USUGGraph* Graph) override;
     virtual void Execute(USUGGraph* Graph) override;
+    virtual bool SupportsRegionExecution() const override;
+    virtual void GatherAssetReferences(TArray<FSoftObjectPath>& OutAssetPaths) const override;
+    virtual void GatherMaterialWarmUpEntries(const USUGGraph& Graph, TArray<FSUGGraphMaterialWarmUpEntry>& OutEntries) const override;
 
     UFUNCTION(BlueprintCallable)
     void SetScalarParameterValue(FName ParameterName, float ParameterValue);
@@ -39,6 +39,10 @@ class SHADERGRAPHPLUGIN_API USUGGraphTask_AutoLevel : public USUGGraphTask
 {
 	GENERATED_BODY()
 
+protected:
+
+    void ExecuteNativeShader(USUGGraph& Graph, UTexture* Texture);
+
 public:
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite)
@@ -50,6 +54,14 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite)
     bool bApplyLevelMax;
 
+    // Reduce source value range and apply levels on the GPU with built-in
+    // global shaders. The source range is the range over every color
+    // channel, results differ from the default auto levels of multi-channel
+    // sources.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    bool bUseNativeShader = false;
+
     virtual void Initialize(USUGGraph* Graph) override;
     virtual void Execute(USUGGraph* Graph) override;
+    virtual void GatherAssetReferences(TArray<FSoftObjectPath>& OutAssetPaths) const override;
 };
@@ -0,0 +1,89 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tasks/SUGGraphTask_ApplyMaterial.h"
+#include "SUGGraphTask_BaseOp.generated.h"
+
+struct FSUGGraphBaseOpParameters;
+struct FSUGGraphFusedOpParameters;
+
+// Base material library operation, rendered either with the task material
+// or with the built-in global shader of the operation
+UCLASS()
+class SHADERGRAPHPLUGIN_API USUGGraphTask_BaseOp : public USUGGraphTask_ApplyMaterial
+{
+	GENERATED_BODY()
+
+protected:
+
+    // Dependant task evaluating this task output within its own pass
+    UPROPERTY(Transient)
+    USUGGraphTask_BaseOp* FusedConsumer;
+
+    // Input name of the fused input task, evaluated as the previous stage
+    FName FusedInputName;
+
+    // Number of fused operation stages ending with this task
+    int32 FusedStageCount = 1;
+
+    // Fused stages of input tasks, passed on by the last fused input task
+    TSharedPtr<FSUGGraphFusedOpParameters> FusedParameters;
+
+    static bool GetOperationInputNames(TEnumAsByte<enum ESUGGraphBaseOpType> InOperation, FName (&OutInputNames)[3]);
+
+    bool IsFusable() const;
+    bool ResolveNativeParameters(FSUGGraphBaseOpParameters& OutParameters) const;
+    void ExecuteNativeShader(USUGGraph& Graph);
+    void ResetFusion();
+
+public:
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    TEnumAsByte<enum ESUGGraphBaseOpType> Operation;
+
+    // Render operation with its built-in global shader instead of the task
+    // material, parameters are read by their base material library names
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    bool bUseNativeShader = true;
+
+    // Native levels input remap range, (InRemapValueLo, InRemapValueHi) are
+    // read on the GPU from the first texel such as histogram task outputs
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    FSUGGraphTextureInput RangeTexture;
+
+    virtual void Initialize(USUGGraph* Graph) override;
+
+    virtual void Execute(USUGGraph* Graph) override;
+    virtual void PostExecute(USUGGraph* Graph) override;
+    virtual void ResolveFusion(USUGGraph& Graph) override;
+    virtual bool SupportsRegionExecution() const override;
+    virtual void GatherAssetReferences(TArray<FSoftObjectPath>& OutAssetPaths) const override;
+    virtual void GatherMaterialWarmUpEntries(const USUGGraph& Graph, TArray<FSUGGraphMaterialWarmUpEntry>& OutEntries) const override;
+};
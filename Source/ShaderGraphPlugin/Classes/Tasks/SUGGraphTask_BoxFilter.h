@@ -0,0 +1,63 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SUGGraphTask.h"
+#include "SUGGraphTypes.h"
+#include "SUGGraphTask_BoxFilter.generated.h"
+
+class USUGGraph;
+
+// Box filtered local mean of a summed area table with a single lookup pass,
+// cost is independent of the box radius and the radius may vary per pixel
+UCLASS()
+class SHADERGRAPHPLUGIN_API USUGGraphTask_BoxFilter : public USUGGraphTask
+{
+	GENERATED_BODY()
+
+public:
+
+    // Summed area table, value offset is resolved from summed area table
+    // tasks and is zero for other textures
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    FSUGGraphTextureInput SummedAreaTable;
+
+    // Optional per pixel radius scale in the [0, 1] range, red channel
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    FSUGGraphTextureInput RadiusTexture;
+
+    // Box radius in summed area table texels
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, meta=(ClampMin="0"))
+    float Radius = 1.f;
+
+    virtual void Initialize(USUGGraph* Graph) override;
+    virtual void Execute(USUGGraph* Graph) override;
+    virtual int32 GetFootprintRadius() const override;
+    virtual void GatherAssetReferences(TArray<FSoftObjectPath>& OutAssetPaths) const override;
+};
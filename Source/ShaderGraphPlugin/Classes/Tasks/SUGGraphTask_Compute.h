@@ -0,0 +1,79 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SUGGraphComputeTypes.h"
+#include "SUGGraphTask.h"
+#include "SUGGraphTypes.h"
+#include "SUGGraphTask_Compute.generated.h"
+
+class USUGGraph;
+
+// Task dispatching compute kernels. Task output is written through an
+// unordered access view, texture inputs participate in dependency resolution
+// like other task inputs.
+UCLASS(Abstract)
+class SHADERGRAPHPLUGIN_API USUGGraphTask_Compute : public USUGGraphTask
+{
+	GENERATED_BODY()
+
+protected:
+
+    // Textures resolved from texture inputs during execution
+    TMap<FName, UTexture*> ResolvedTextureMap;
+
+    void ResolveTaskInputMap();
+
+    // Create compute kernel with a copy of the task parameters, returns null
+    // to skip the dispatch
+    virtual FSUGGraphComputeKernelPtr CreateComputeKernel(USUGGraph& Graph);
+
+    void DispatchKernel(USUGGraph& Graph, const FSUGGraphComputeKernelPtr& Kernel, UTextureRenderTarget2D* TargetTexture);
+
+public:
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    TMap<FName, float> ScalarInputMap;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    TMap<FName, FLinearColor> VectorInputMap;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    TMap<FName, FSUGGraphTextureInput> TextureInputMap;
+
+    virtual void Initialize(USUGGraph* Graph) override;
+    virtual void Execute(USUGGraph* Graph) override;
+    virtual bool SupportsRegionExecution() const override;
+    virtual bool RequiresUAVOutput() const override;
+    virtual void GatherAssetReferences(TArray<FSoftObjectPath>& OutAssetPaths) const override;
+
+    float GetScalarInput(FName InputName, float DefaultValue = 0.f) const;
+    FLinearColor GetVectorInput(FName InputName, const FLinearColor& DefaultValue = FLinearColor::Black) const;
+    UTexture* GetResolvedTexture(FName InputName) const;
+};
@@ -0,0 +1,65 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tasks/SUGGraphTask_Compute.h"
+#include "SUGGraphTask_Convolution.generated.h"
+
+class USUGGraph;
+
+// Convolution of the SourceTexture input with the red channel of an
+// arbitrary KernelTexture input centered at half the kernel dimension,
+// source texels are clamped at the edges. Small kernels are evaluated
+// directly, larger kernels are multiplied in the frequency domain with the
+// cost independent of the kernel dimension. Outputs exceeding a single
+// transform are convolved in overlapping blocks.
+UCLASS()
+class SHADERGRAPHPLUGIN_API USUGGraphTask_Convolution : public USUGGraphTask_Compute
+{
+	GENERATED_BODY()
+
+protected:
+
+    virtual FSUGGraphComputeKernelPtr CreateComputeKernel(USUGGraph& Graph) override;
+
+public:
+
+    // Divide convolution by the kernel weight sum
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    bool bNormalizeKernel = true;
+
+    // Kernels with width and height within this dimension are evaluated
+    // directly instead of through the FFT path. Larger kernels always use
+    // the FFT path and must not exceed half the maximum transform dimension,
+    // 512 texels.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, meta=(ClampMin="0"))
+    int32 MaxDirectKernelSize = 15;
+
+    virtual int32 GetFootprintRadius() const override;
+};
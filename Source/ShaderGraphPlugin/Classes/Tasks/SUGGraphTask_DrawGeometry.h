@@ -51,4 +51,5 @@ public:
     FIntPoint Dimension;
 
     virtual void Execute(USUGGraph* Graph) override;
+    virtual void ResolveTileOccupancy(const USUGGraph& Graph) override;
 };
@@ -41,8 +41,18 @@ protected:
 
     virtual void ExecuteMaterialFunction(USUGGraph& Graph, UMaterialInstanceDynamic& MID);
 
+    // Conservative pixel bounds of every geometry instance, used to generate
+    // tile occupancy and to mark regions of geometry changes
+    void GetGeometryBounds(TArray<FBox2D>& OutBounds) const;
+
 public:
 
+    // Geometry in output pixels, in graph domain pixels during tiled
+    // execution
     UPROPERTY(EditAnywhere, BlueprintReadWrite)
     TArray<FGULPolyGeometryInstance> Polys;
+
+    virtual bool SupportsRegionExecution() const override;
+    virtual void ResolveTileOccupancy(const USUGGraph& Graph) override;
+    virtual void MarkChangedRegions(const USUGGraph& Graph) override;
 };
@@ -0,0 +1,72 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SUGGraphTask.h"
+#include "SUGGraphTypes.h"
+#include "SUGGraphTask_GaussianBlur.generated.h"
+
+class USUGGraph;
+
+// Two dimensional gaussian blur rendered as separable horizontal and vertical
+// passes through a pooled scratch render target. Large radii are blurred at a
+// downsampled pyramid level with a pass count logarithmic to the radius.
+UCLASS()
+class SHADERGRAPHPLUGIN_API USUGGraphTask_GaussianBlur : public USUGGraphTask
+{
+	GENERATED_BODY()
+
+protected:
+
+    int32 GetPyramidLevelCount() const;
+    void ExecuteSeparableBlur(USUGGraph& Graph, UTexture* Texture);
+    void ExecutePyramidBlur(USUGGraph& Graph, UTexture* Texture, int32 LevelCount);
+
+public:
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    FSUGGraphTextureInput SourceTexture;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    TEnumAsByte<enum ESUGGraphBlurMethod> BlurMethod = SUG_BM_Auto;
+
+    // Blur radius in source pixels, separable blurs are limited to 64 pixels
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, meta=(ClampMin="0"))
+    int32 BlurRadius = 4;
+
+    // Gaussian standard deviation in source pixels, derived from the blur
+    // radius if not positive
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    float BlurSigma = 0.f;
+
+    virtual void Initialize(USUGGraph* Graph) override;
+    virtual void Execute(USUGGraph* Graph) override;
+    virtual int32 GetFootprintRadius() const override;
+    virtual void GatherAssetReferences(TArray<FSoftObjectPath>& OutAssetPaths) const override;
+};
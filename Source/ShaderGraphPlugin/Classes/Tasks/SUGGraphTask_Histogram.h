@@ -0,0 +1,77 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tasks/SUGGraphTask_Compute.h"
+#include "SUGGraphTask_Histogram.generated.h"
+
+class USUGGraph;
+
+// Value histogram and percentile statistics of the source texture computed
+// on the GPU. Output is a single row texture with a texel per histogram bin
+// as (PercentileLo, PercentileHi, BinFraction, CumulativeFraction), the first
+// texel doubles as a value range texture of native level operations.
+UCLASS()
+class SHADERGRAPHPLUGIN_API USUGGraphTask_Histogram : public USUGGraphTask_Compute
+{
+	GENERATED_BODY()
+
+protected:
+
+    virtual FSUGGraphComputeKernelPtr CreateComputeKernel(USUGGraph& Graph) override;
+
+public:
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    TEnumAsByte<enum ESUGGraphHistogramBinCount> BinCount = SUG_HBC_256;
+
+    // Source channel index of histogram values
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, meta=(ClampMin="0", ClampMax="3"))
+    int32 SourceChannel = 0;
+
+    // Source value range covered by the histogram bins
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    float RangeMin = 0.f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    float RangeMax = 1.f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, meta=(ClampMin="0", ClampMax="1"))
+    float PercentileLo = .01f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, meta=(ClampMin="0", ClampMax="1"))
+    float PercentileHi = .99f;
+
+    virtual void ResolveOutputConfig(const USUGGraph& Graph) override;
+
+    FORCEINLINE int32 GetBinCount() const
+    {
+        return (BinCount == SUG_HBC_1024) ? 1024 : 256;
+    }
+};
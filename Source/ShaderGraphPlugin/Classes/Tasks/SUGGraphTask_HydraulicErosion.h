@@ -0,0 +1,117 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SUGGraphTask.h"
+#include "SUGGraphTypes.h"
+#include "SUGGraphTask_HydraulicErosion.generated.h"
+
+class USUGGraph;
+
+// Pipe model hydraulic erosion simulation of a source height texture. Height,
+// water, sediment and flux state persists in the graph manager across graph
+// executions, each execution advances the simulation by a limited number of
+// steps and outputs the current height. Incremental graphs re-execute the
+// task until the simulation is complete. Simulations restart when the source
+// changes and are not supported by tiled executions.
+UCLASS()
+class SHADERGRAPHPLUGIN_API USUGGraphTask_HydraulicErosion : public USUGGraphTask
+{
+	GENERATED_BODY()
+
+protected:
+
+    // Simulation steps completed after the last execution
+    UPROPERTY(Transient, VisibleInstanceOnly)
+    int32 CompletedStepCount = 0;
+
+public:
+
+    // Initial height, red channel
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    FSUGGraphTextureInput SourceTexture;
+
+    // Simulation state key, tasks of successive graph preparations sharing
+    // the name continue the same simulation
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    FName SimulationName = TEXT("HydraulicErosion");
+
+    // Total simulation step count
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, meta=(ClampMin="0"))
+    int32 StepCount = 1024;
+
+    // Simulation step budget of a single execution
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, meta=(ClampMin="1"))
+    int32 StepsPerExecution = 32;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Simulation")
+    float TimeStep = .02f;
+
+    // Horizontal size of a simulation cell in source height units
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Simulation")
+    float CellSize = 1.f / 512.f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Simulation")
+    float Gravity = 9.81f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Simulation")
+    float RainRate = .01f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Simulation")
+    float EvaporationRate = .015f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Simulation")
+    float SedimentCapacity = 1.f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Simulation")
+    float DissolvingRate = .5f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Simulation")
+    float DepositionRate = 1.f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Simulation")
+    float MinimumTilt = .05f;
+
+    virtual void Initialize(USUGGraph* Graph) override;
+    virtual void Execute(USUGGraph* Graph) override;
+    virtual void PostExecute(USUGGraph* Graph) override;
+    virtual void GatherAssetReferences(TArray<FSoftObjectPath>& OutAssetPaths) const override;
+
+    UFUNCTION(BlueprintCallable)
+    FORCEINLINE int32 GetCompletedStepCount() const
+    {
+        return CompletedStepCount;
+    }
+
+    UFUNCTION(BlueprintCallable)
+    FORCEINLINE bool IsSimulationComplete() const
+    {
+        return CompletedStepCount >= StepCount;
+    }
+};
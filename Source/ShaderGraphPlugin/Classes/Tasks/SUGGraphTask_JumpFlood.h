@@ -0,0 +1,65 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SUGGraphTask.h"
+#include "SUGGraphTypes.h"
+#include "SUGGraphTask_JumpFlood.generated.h"
+
+class USUGGraph;
+
+// Jump flood distance transform of a seed mask. Output is written as
+// (Distance, NearestSeedU, NearestSeedV, NearestSeedId) with nearest seed
+// values usable as voronoi cells.
+UCLASS()
+class SHADERGRAPHPLUGIN_API USUGGraphTask_JumpFlood : public USUGGraphTask
+{
+	GENERATED_BODY()
+
+public:
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    FSUGGraphTextureInput SourceTexture;
+
+    // Source red channel value at or above which source texels are seeds
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    float SeedThreshold = .5f;
+
+    // Distance range in output pixels, limits the flood pass count and
+    // normalizes output distance. Distances are unlimited and written in
+    // pixels if not positive, or normalized to the output diagonal for
+    // non-float output formats. Tiled executions require a positive range.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    float MaxDistance = 0.f;
+
+    virtual void Initialize(USUGGraph* Graph) override;
+    virtual void Execute(USUGGraph* Graph) override;
+    virtual int32 GetFootprintRadius() const override;
+    virtual void GatherAssetReferences(TArray<FSoftObjectPath>& OutAssetPaths) const override;
+};
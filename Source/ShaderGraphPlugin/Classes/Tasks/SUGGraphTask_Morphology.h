@@ -0,0 +1,58 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tasks/SUGGraphTask_Compute.h"
+#include "SUGGraphTask_Morphology.generated.h"
+
+class USUGGraph;
+
+// Dilate or erode of the source texture with a square structuring element.
+// Separable van Herk/Gil-Werman passes perform constant work per pixel
+// regardless of the radius.
+UCLASS()
+class SHADERGRAPHPLUGIN_API USUGGraphTask_Morphology : public USUGGraphTask_Compute
+{
+	GENERATED_BODY()
+
+protected:
+
+    virtual FSUGGraphComputeKernelPtr CreateComputeKernel(USUGGraph& Graph) override;
+
+public:
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    TEnumAsByte<enum ESUGGraphMorphologyOp> Operation = SUG_MO_Dilate;
+
+    // Structuring element radius in output pixels
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, meta=(ClampMin="0"))
+    int32 Radius = 1;
+
+    virtual int32 GetFootprintRadius() const override;
+};
@@ -0,0 +1,68 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tasks/SUGGraphTask_Compute.h"
+#include "SUGGraphTask_SummedAreaTable.generated.h"
+
+class USUGGraph;
+
+// Full precision summed area table of the source texture built with row and
+// column parallel prefix sums. Output texels hold the sum of source texels at
+// or above and left of the texel, each offset by the source mean or the value
+// offset. Tables centered on the source mean hold the mean in the last texel
+// instead of its zero sum.
+//
+// Box sums are exact up to float rounding of the four table lookups, the
+// absolute error grows with the largest centered partial sum. Sources with
+// large regions away from the mean, e.g. a 1024x1024 mask with one half set,
+// still reach partial sums near 2.6e5 with a lookup step near 0.03.
+UCLASS()
+class SHADERGRAPHPLUGIN_API USUGGraphTask_SummedAreaTable : public USUGGraphTask_Compute
+{
+	GENERATED_BODY()
+
+protected:
+
+    virtual FSUGGraphComputeKernelPtr CreateComputeKernel(USUGGraph& Graph) override;
+
+public:
+
+    // Subtract the source mean reduced on the GPU before summation, keeps
+    // table sums small and preserves precision of large tables
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    bool bSubtractSourceMean = true;
+
+    // Offset subtracted from source values before summation if the source
+    // mean is not subtracted
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, meta=(EditCondition="!bSubtractSourceMean"))
+    float ValueOffset = .5f;
+
+    virtual void ResolveOutputConfig(const USUGGraph& Graph) override;
+};
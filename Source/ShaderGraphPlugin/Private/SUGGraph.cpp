@@ -29,8 +29,25 @@
 #include "Engine/TextureRenderTarget2D.h"
 #include "Shaders/RULShaderLibrary.h"
 #include "SUGGraphManager.h"
+#include "SUGGraphRenderUtils.h"
 #include "SUGGraphTask.h"
 
+void FSUGGraphOutputEntry::SwapBuffers()
+{
+    if (bPendingSwap)
+    {
+        Swap(RenderTarget, BackRenderTarget);
+        bPendingVersion = true;
+        bPendingSwap = false;
+    }
+
+    if (bPendingVersion)
+    {
+        ++Version;
+        bPendingVersion = false;
+    }
+}
+
 USUGGraph::USUGGraph(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
@@ -84,18 +101,26 @@ void USUGGraph::GetOutputConfig(FRULShaderOutputConfig& OutConfig) const
     OutConfig = OutputConfig;
 }
 
-void USUGGraph::AssignOutput(USUGGraphTask& Task)
+bool USUGGraph::AssignOutput(USUGGraphTask& Task)
 {
     check(HasGraphManager());
 
-    // Assign output from free output
     if (! Task.HasValidOutput())
     {
         FRULShaderOutputConfig TaskOutputConfig;
         Task.GetResolvedOutputConfig(TaskOutputConfig);
 
-        GraphManager->FindFreeOutputRT(TaskOutputConfig, Task.GetOutputRef());
+        // Assign output retained by the task
+        if (IsIncrementalExecution())
+        {
+            return Task.AssignPersistentOutput(*GraphManager, TaskOutputConfig);
+        }
+
+        // Assign output from free output
+        GraphManager->FindFreeOutputRT(TaskOutputConfig, Task.GetOutputRef(), Task.RequiresUAVOutput());
     }
+
+    return false;
 }
 
 FSUGGraphOutputEntry* USUGGraph::GetOutput(FName OutputName)
@@ -109,7 +134,34 @@ UTextureRenderTarget2D* USUGGraph::CreateOutputRenderTarget(FName OutputName, co
 
     if (OutputEntry && HasGraphManager())
     {
+        // Write to pooled tile render target, tile interior is resolved to
+        // the output once the tile execution has completed
+        if (IsTiledExecution())
+        {
+            GraphManager->FindFreeOutputRT(InOutputConfig, OutputEntry->TileOutput);
+            return OutputEntry->TileOutput.RenderTarget;
+        }
+
+        // Write to back buffer, front buffer is swapped after execution
+        if (OutputEntry->bDoubleBuffered)
+        {
+            UTextureRenderTarget2D* BackRT = OutputEntry->BackRenderTarget;
+
+            // Reuse back buffer if it still matches the output config
+            if (! IsValid(BackRT) || ! FSUGGraphOutputRT::CompareFormat(*BackRT, InOutputConfig))
+            {
+                BackRT = GraphManager->CreateOutputRenderTarget(InOutputConfig);
+                OutputEntry->BackRenderTarget = BackRT;
+            }
+
+            OutputEntry->bPendingSwap = IsValid(BackRT);
+
+            return BackRT;
+        }
+
         OutputEntry->RenderTarget = GraphManager->CreateOutputRenderTarget(InOutputConfig);
+        OutputEntry->bPendingVersion = IsValid(OutputEntry->RenderTarget);
+
         return OutputEntry->RenderTarget;
     }
     else
@@ -132,6 +184,57 @@ UTextureRenderTarget2D* USUGGraph::GetOutputRenderTarget(FName OutputName)
     }
 }
 
+int32 USUGGraph::GetOutputVersion(FName OutputName) const
+{
+    const FSUGGraphOutputEntry* OutputEntry = OutputMap.Find(OutputName);
+    return OutputEntry ? OutputEntry->Version : 0;
+}
+
+UTextureRenderTarget2D* USUGGraph::GetOutputTileRenderTarget(FName OutputName, FIntPoint TileIndex) const
+{
+    const FSUGGraphOutputEntry* OutputEntry = OutputMap.Find(OutputName);
+
+    if (OutputEntry &&
+        TileIndex.X >= 0 && TileIndex.X < OutputEntry->TileCount.X &&
+        TileIndex.Y >= 0 && TileIndex.Y < OutputEntry->TileCount.Y)
+    {
+        const int32 TileLinearIndex = TileIndex.Y * OutputEntry->TileCount.X + TileIndex.X;
+
+        if (OutputEntry->TileRenderTargets.IsValidIndex(TileLinearIndex))
+        {
+            return OutputEntry->TileRenderTargets[TileLinearIndex];
+        }
+    }
+
+    return nullptr;
+}
+
+FLinearColor USUGGraph::GetDomainUVTransform() const
+{
+    if (IsTiledExecution())
+    {
+        const FIntRect& RenderRect(ExecutionTile.RenderRect);
+        const FVector2D DomainSize(ExecutionTile.DomainSize);
+
+        return FLinearColor(
+            RenderRect.Min.X / DomainSize.X,
+            RenderRect.Min.Y / DomainSize.Y,
+            RenderRect.Width() / DomainSize.X,
+            RenderRect.Height() / DomainSize.Y
+            );
+    }
+
+    return FLinearColor(0.f, 0.f, 1.f, 1.f);
+}
+
+void USUGGraph::SwapOutputBuffers()
+{
+    for (auto& OutputPair : OutputMap)
+    {
+        OutputPair.Value.SwapBuffers();
+    }
+}
+
 UMaterialInstanceDynamic* USUGGraph::GetCachedMID(UMaterialInterface* BaseMaterial, bool bClearParameterValues)
 {
     if (! GraphManager)
@@ -160,6 +263,32 @@ UMaterialInstanceDynamic* USUGGraph::GetCachedMID(FName MaterialName, bool bClea
     return GraphManager->GetCachedMID(MaterialName, bClearParameterValues);
 }
 
+UMaterialInstanceDynamic* USUGGraph::GetPooledMID(UMaterialInterface* BaseMaterial, FSUGGraphPooledMIDHandle& OutHandle)
+{
+    OutHandle.Reset();
+
+    if (! GraphManager)
+    {
+        UE_LOG(LogSGP,Warning, TEXT("USUGGraph::GetPooledMID() ABORTED, GRAPH MANAGER HAS NOT BEEN ASSIGNED! MAKE SURE TO CALL DURING Execute()"));
+        return nullptr;
+    }
+
+    return GraphManager->GetPooledMID(BaseMaterial, OutHandle);
+}
+
+UMaterialInstanceDynamic* USUGGraph::GetPooledMID(FName MaterialName, FSUGGraphPooledMIDHandle& OutHandle)
+{
+    OutHandle.Reset();
+
+    if (! GraphManager)
+    {
+        UE_LOG(LogSGP,Warning, TEXT("USUGGraph::GetPooledMID() ABORTED, GRAPH MANAGER HAS NOT BEEN ASSIGNED! MAKE SURE TO CALL DURING Execute()"));
+        return nullptr;
+    }
+
+    return GraphManager->GetPooledMID(MaterialName, OutHandle);
+}
+
 void USUGGraph::ExecuteGraph(USUGGraphManager* InGraphManager)
 {
     if (! IsValid(InGraphManager))
@@ -171,6 +300,7 @@ void USUGGraph::ExecuteGraph(USUGGraphManager* InGraphManager)
     {
         UE_LOG(LogSGP,Warning, TEXT("USUGGraphUtility::ExecuteGraph() ABORTED, INVALID DIMENSION"));
     }
+    else
     if (IsExecutionInProgress())
     {
         UE_LOG(LogSGP,Warning, TEXT("USUGGraphUtility::ExecuteGraph() ABORTED, GRAPH EXECUTION IS IN PROGRESS"));
@@ -178,10 +308,29 @@ void USUGGraph::ExecuteGraph(USUGGraphManager* InGraphManager)
     else
     {
         GraphManager = InGraphManager;
+        bExecutionInProgress = true;
 
-        InitializeTasks();
-        ExecuteTasks();
+        if (TiledExecution.bEnabled)
+        {
+            ExecuteTiles();
+        }
+        else
+        {
+            InitializeTasks();
+            ExecuteTasks();
+        }
+
+        // Tasks are single use, prepare graph will queue new tasks on the
+        // next execution
+        if (! IsIncrementalExecution())
+        {
+            TaskQueue.Reset();
+        }
 
+        // All draw commands have been enqueued, publish back buffers
+        SwapOutputBuffers();
+
+        bExecutionInProgress = false;
         GraphManager = nullptr;
     }
 }
@@ -202,21 +351,325 @@ void USUGGraph::InitializeTasks()
     }
 }
 
+void USUGGraph::GatherAssetReferences(TArray<FSoftObjectPath>& OutAssetPaths) const
+{
+    for (const USUGGraphTask* Task : TaskQueue)
+    {
+        if (IsValid(Task))
+        {
+            Task->GatherAssetReferences(OutAssetPaths);
+        }
+    }
+}
+
+void USUGGraph::GatherMaterialWarmUpEntries(TArray<FSUGGraphMaterialWarmUpEntry>& OutEntries) const
+{
+    for (const USUGGraphTask* Task : TaskQueue)
+    {
+        if (IsValid(Task))
+        {
+            Task->GatherMaterialWarmUpEntries(*this, OutEntries);
+        }
+    }
+}
+
+void USUGGraph::DiscardPreparedTasks()
+{
+    check(! IsExecutionInProgress());
+
+    // Incremental graphs retain their prepared tasks between executions
+    if (! IsIncrementalExecution())
+    {
+        TaskQueue.Reset();
+    }
+}
+
+void USUGGraph::ResetIncrementalExecution()
+{
+    if (IsExecutionInProgress())
+    {
+        UE_LOG(LogSGP,Warning, TEXT("USUGGraph::ResetIncrementalExecution() ABORTED, GRAPH EXECUTION IS IN PROGRESS"));
+        return;
+    }
+
+    for (USUGGraphTask* Task : TaskQueue)
+    {
+        if (IsValid(Task))
+        {
+            Task->ResetIncrementalState();
+        }
+    }
+
+    TaskQueue.Reset();
+}
+
 void USUGGraph::ExecuteTasks()
 {
+    check(HasGraphManager());
+
+    const bool bIncremental = IsIncrementalExecution();
+
+    // Pooled material instances are assigned by order of use
+    GraphManager->ResetMIDPoolUsage();
+
+    // Tasks linked through output tasks draw on top of each other's output
+    // and are always re-rendered as a whole
+    TSet<const USUGGraphTask*> SharedOutputTasks;
+
+    if (bIncremental)
+    {
+        for (const USUGGraphTask* Task : TaskQueue)
+        {
+            if (IsValid(Task) && IsValid(Task->GetOutputTask()))
+            {
+                SharedOutputTasks.Emplace(Task);
+                SharedOutputTasks.Emplace(Task->GetOutputTask());
+            }
+        }
+    }
+
+    // Incremental executions retain every task output, only resolve task
+    // fusion for full executions
+    if (bFuseNativeTasks && ! bIncremental)
+    {
+        for (USUGGraphTask* Task : TaskQueue)
+        {
+            if (IsValid(Task))
+            {
+                Task->ResolveFusion(*this);
+            }
+        }
+    }
+
     for (int32 i=0; i<TaskQueue.Num(); ++i)
     {
         USUGGraphTask* Task = TaskQueue[i];
 
         if (IsValid(Task))
         {
-            if (Task->IsOutputRequired())
+            bool bOutputReallocated = false;
+
+            if (Task->IsOutputRequired() && ! Task->IsOutputElided())
+            {
+                bOutputReallocated = AssignOutput(*Task);
+            }
+
+            Task->ResolveTileOccupancy(*this);
+
+            if (bIncremental)
+            {
+                Task->MarkChangedRegions(*this);
+                Task->ResolveExecutionRegion(bOutputReallocated || SharedOutputTasks.Contains(Task));
+
+                // Clean tasks keep their retained output and only pass it
+                // on to dependant tasks
+                if (Task->HasExecutionRegion())
+                {
+                    Task->Execute(this);
+                }
+            }
+            else
             {
-                AssignOutput(*Task);
+                Task->Execute(this);
             }
 
-            Task->Execute(this);
             Task->PostExecute(this);
         }
     }
 }
+
+int32 USUGGraph::GetTaskFootprintRadius() const
+{
+    // Largest accumulated footprint along any input path, independent
+    // branches sample the same halo and don't add up
+
+    TMap<const USUGGraphTask*, int32> PathFootprintMap;
+    int32 FootprintRadius = 0;
+
+    for (const USUGGraphTask* Task : TaskQueue)
+    {
+        if (IsValid(Task))
+        {
+            FootprintRadius = FMath::Max(FootprintRadius, GetPathFootprintRadius(*Task, PathFootprintMap));
+        }
+    }
+
+    return FootprintRadius;
+}
+
+int32 USUGGraph::GetPathFootprintRadius(const USUGGraphTask& Task, TMap<const USUGGraphTask*, int32>& PathFootprintMap)
+{
+    if (const int32* PathFootprint = PathFootprintMap.Find(&Task))
+    {
+        return *PathFootprint;
+    }
+
+    // Guard against cyclic inputs
+    PathFootprintMap.Emplace(&Task, 0);
+
+    TArray<USUGGraphTask*> InputTasks;
+    Task.GatherInputTasks(InputTasks);
+
+    int32 InputFootprint = 0;
+
+    for (const USUGGraphTask* InputTask : InputTasks)
+    {
+        InputFootprint = FMath::Max(InputFootprint, GetPathFootprintRadius(*InputTask, PathFootprintMap));
+    }
+
+    const int32 PathFootprint = InputFootprint + Task.GetFootprintRadius();
+    PathFootprintMap.Emplace(&Task, PathFootprint);
+
+    return PathFootprint;
+}
+
+void USUGGraph::ExecuteTiles()
+{
+    const FRULShaderOutputConfig DomainConfig(OutputConfig);
+    const FIntPoint DomainSize(DomainConfig.SizeX, DomainConfig.SizeY);
+
+    // Tasks of the first tile have been queued by prepare graph, use them to
+    // find the halo margin required by the accumulated task footprints
+    const int32 HaloMargin = GetTaskFootprintRadius() + FMath::Max(0, TiledExecution.ExtraHaloMargin);
+    const int32 InteriorSize = TiledExecution.MaxTileSize - 2*HaloMargin;
+
+    if (InteriorSize <= 0)
+    {
+        UE_LOG(LogSGP,Warning, TEXT("USUGGraph::ExecuteTiles() ABORTED, HALO MARGIN (%d) EXCEEDS MAX TILE SIZE (%d)"), HaloMargin, TiledExecution.MaxTileSize);
+        return;
+    }
+
+    const FIntPoint TileCount(
+        FMath::DivideAndRoundUp(DomainSize.X, InteriorSize),
+        FMath::DivideAndRoundUp(DomainSize.Y, InteriorSize)
+        );
+    const FIntPoint HaloExtent(HaloMargin, HaloMargin);
+
+    PrepareOutputTiles(TileCount);
+
+    for (int32 TileY=0; TileY<TileCount.Y; ++TileY)
+    for (int32 TileX=0; TileX<TileCount.X; ++TileX)
+    {
+        FSUGGraphExecutionTile& Tile(ExecutionTile);
+        Tile.TileIndex = FIntPoint(TileX, TileY);
+        Tile.TileCount = TileCount;
+        Tile.DomainSize = DomainSize;
+
+        // Halo is clamped to the domain so tile borders sample the same
+        // values as a single non-tiled execution would
+        Tile.InteriorRect.Min = Tile.TileIndex * InteriorSize;
+        Tile.InteriorRect.Max = (Tile.InteriorRect.Min + FIntPoint(InteriorSize, InteriorSize)).ComponentMin(DomainSize);
+        Tile.RenderRect.Min = (Tile.InteriorRect.Min - HaloExtent).ComponentMax(FIntPoint::ZeroValue);
+        Tile.RenderRect.Max = (Tile.InteriorRect.Max + HaloExtent).ComponentMin(DomainSize);
+
+        OutputConfig.SizeX = Tile.RenderRect.Width();
+        OutputConfig.SizeY = Tile.RenderRect.Height();
+
+        // Queue tasks for subsequent tiles. Execution flag is lifted because
+        // tasks can't be added while execution is in progress.
+        if (TileX > 0 || TileY > 0)
+        {
+            bExecutionInProgress = false;
+            K2_PrepareGraph(GraphManager);
+            bExecutionInProgress = true;
+        }
+
+        InitializeTasks();
+        ExecuteTasks();
+        TaskQueue.Reset();
+
+        ResolveOutputTiles();
+    }
+
+    OutputConfig = DomainConfig;
+    ExecutionTile = FSUGGraphExecutionTile();
+}
+
+void USUGGraph::PrepareOutputTiles(const FIntPoint& TileCount)
+{
+    for (auto& OutputPair : OutputMap)
+    {
+        FSUGGraphOutputEntry& OutputEntry(OutputPair.Value);
+
+        if (OutputEntry.bStitchTiles)
+        {
+            OutputEntry.TileCount = FIntPoint::ZeroValue;
+            OutputEntry.TileRenderTargets.Reset();
+
+            // Stitched render target of the previous execution is reused by
+            // the first resolved tile if it still matches the domain config
+        }
+        else
+        {
+            OutputEntry.TileCount = TileCount;
+            OutputEntry.TileRenderTargets.SetNumZeroed(TileCount.X * TileCount.Y);
+        }
+    }
+}
+
+void USUGGraph::ResolveOutputTiles()
+{
+    check(HasGraphManager());
+    check(IsTiledExecution());
+
+    const FIntRect& InteriorRect(ExecutionTile.InteriorRect);
+    const FIntRect& RenderRect(ExecutionTile.RenderRect);
+    const FIntRect SourceRect(InteriorRect.Min - RenderRect.Min, InteriorRect.Max - RenderRect.Min);
+
+    for (auto& OutputPair : OutputMap)
+    {
+        FSUGGraphOutputEntry& OutputEntry(OutputPair.Value);
+        UTextureRenderTarget2D* TileRT = OutputEntry.TileOutput.RenderTarget;
+
+        if (! IsValid(TileRT))
+        {
+            continue;
+        }
+
+        FRULShaderOutputConfig TargetConfig;
+        TargetConfig.Format = TileRT->RenderTargetFormat;
+        TargetConfig.bForceLinearGamma = TileRT->bForceLinearGamma;
+
+        if (OutputEntry.bStitchTiles)
+        {
+            TargetConfig.SizeX = ExecutionTile.DomainSize.X;
+            TargetConfig.SizeY = ExecutionTile.DomainSize.Y;
+
+            UTextureRenderTarget2D*& StitchRT(OutputEntry.bDoubleBuffered
+                ? OutputEntry.BackRenderTarget
+                : OutputEntry.RenderTarget);
+
+            if (! IsValid(StitchRT) || ! FSUGGraphOutputRT::CompareFormat(*StitchRT, TargetConfig))
+            {
+                StitchRT = GraphManager->CreateOutputRenderTarget(TargetConfig);
+            }
+
+            OutputEntry.bPendingSwap = OutputEntry.bDoubleBuffered && IsValid(StitchRT);
+            OutputEntry.bPendingVersion = ! OutputEntry.bDoubleBuffered && IsValid(StitchRT);
+
+            FSUGGraphRenderUtils::CopyTextureRegion(TileRT, StitchRT, SourceRect, InteriorRect.Min);
+        }
+        else
+        {
+            TargetConfig.SizeX = InteriorRect.Width();
+            TargetConfig.SizeY = InteriorRect.Height();
+
+            const int32 TileLinearIndex = ExecutionTile.GetLinearIndex();
+            check(OutputEntry.TileRenderTargets.IsValidIndex(TileLinearIndex));
+
+            UTextureRenderTarget2D*& TargetRT(OutputEntry.TileRenderTargets[TileLinearIndex]);
+
+            if (! IsValid(TargetRT) || ! FSUGGraphOutputRT::CompareFormat(*TargetRT, TargetConfig))
+            {
+                TargetRT = GraphManager->CreateOutputRenderTarget(TargetConfig);
+            }
+
+            OutputEntry.bPendingVersion = true;
+
+            FSUGGraphRenderUtils::CopyTextureRegion(TileRT, TargetRT, SourceRect, FIntPoint::ZeroValue);
+        }
+
+        // Release pooled tile render target
+        OutputEntry.TileOutput = FSUGGraphOutputRT();
+    }
+}
@@ -31,6 +31,63 @@
 #include "SUGGraphTask.h"
 #include "SUGGraphUtility.h"
 #include "Tasks/SUGGraphTask_ApplyMaterial.h"
+#include "Tasks/SUGGraphTask_BaseOp.h"
+
+TSubclassOf<USUGGraphTask_ApplyMaterial> USUGGraphBaseMaterialLibrary::GetBaseTaskType(
+    TSubclassOf<USUGGraphTask_ApplyMaterial> TaskType,
+    bool bUseNativeShader
+    )
+{
+    UClass* TaskClass = TaskType.Get();
+
+    if (! bUseNativeShader)
+    {
+        return TaskType;
+    }
+
+    // Native operations require base operation task type
+    if (! TaskClass)
+    {
+        return USUGGraphTask_BaseOp::StaticClass();
+    }
+    else
+    if (! TaskClass->IsChildOf(USUGGraphTask_BaseOp::StaticClass()))
+    {
+        UE_LOG(LogSGP,Warning, TEXT("USUGGraphBaseMaterialLibrary::GetBaseTaskType() TASK TYPE '%s' IS NOT A BASE OPERATION TASK, USING OPERATION MATERIAL"), *TaskClass->GetName());
+    }
+
+    return TaskType;
+}
+
+bool USUGGraphBaseMaterialLibrary::SetNativeOperation(
+    USUGGraphTask_ApplyMaterial& Task,
+    TEnumAsByte<enum ESUGGraphBaseOpType> Operation,
+    bool bUseNativeShader,
+    const TArray<FScalarParam>& ScalarParameters,
+    const TArray<FTextureParam>& TextureParameters
+    )
+{
+    USUGGraphTask_BaseOp* BaseOpTask = Cast<USUGGraphTask_BaseOp>(&Task);
+
+    if (! BaseOpTask)
+    {
+        return false;
+    }
+
+    BaseOpTask->Operation = Operation;
+    BaseOpTask->bUseNativeShader = bUseNativeShader;
+
+    if (! bUseNativeShader)
+    {
+        return false;
+    }
+
+    // Native shader reads parameters by their base names, parameter name
+    // category mapping only applies to materials
+    BaseOpTask->SetParameters(ScalarParameters, { }, TextureParameters);
+
+    return true;
+}
 
 USUGGraphTask_ApplyMaterial* USUGGraphBaseMaterialLibrary::AddLevelsTask(
     USUGGraph* Graph,
@@ -48,13 +105,14 @@ USUGGraphTask_ApplyMaterial* USUGGraphBaseMaterialLibrary::AddLevelsTask(
     float InRemapValueHi,
     float OutRemapValueLo,
     float OutRemapValueHi,
-    float MidPoint
+    float MidPoint,
+    bool bUseNativeShader
     )
 {
     USUGGraphTask_ApplyMaterial* Task;
     Task = USUGGraphUtility::AddApplyMaterialTaskWithParameters(
         Graph,
-        TaskType,
+        GetBaseTaskType(TaskType, bUseNativeShader),
         TaskConfig,
         ConfigMethod,
         OutputTask,
@@ -76,14 +134,17 @@ USUGGraphTask_ApplyMaterial* USUGGraphBaseMaterialLibrary::AddLevelsTask(
         MappedScalars.Emplace(TEXT("MidPoint"), MidPoint);
         MappedTextures.Emplace(TEXT("SourceTexture"), SourceTexture);
 
-        Task->SetParameters(
-            *Graph,
-            ParameterCategoryName,
-            TEXT("Levels"),
-            MappedScalars,
-            { },
-            MappedTextures
-            );
+        if (! SetNativeOperation(*Task, SUG_BOP_Levels, bUseNativeShader, MappedScalars, MappedTextures))
+        {
+            Task->SetParameters(
+                *Graph,
+                ParameterCategoryName,
+                TEXT("Levels"),
+                MappedScalars,
+                { },
+                MappedTextures
+                );
+        }
     }
 
     return Task;
@@ -108,13 +169,14 @@ USUGGraphTask_ApplyMaterial* USUGGraphBaseMaterialLibrary::AddLevelsManualTask(
     float LevelsLo,
     float LevelsMi,
     float LevelsHi,
-    float MidPoint
+    float MidPoint,
+    bool bUseNativeShader
     )
 {
     USUGGraphTask_ApplyMaterial* Task;
     Task = USUGGraphUtility::AddApplyMaterialTaskWithParameters(
         Graph,
-        TaskType,
+        GetBaseTaskType(TaskType, bUseNativeShader),
         TaskConfig,
         ConfigMethod,
         OutputTask,
@@ -139,14 +201,17 @@ USUGGraphTask_ApplyMaterial* USUGGraphBaseMaterialLibrary::AddLevelsManualTask(
         MappedScalars.Emplace(TEXT("MidPoint"), MidPoint);
         MappedTextures.Emplace(TEXT("SourceTexture"), SourceTexture);
 
-        Task->SetParameters(
-            *Graph,
-            ParameterCategoryName,
-            TEXT("LevelsManual"),
-            MappedScalars,
-            { },
-            MappedTextures
-            );
+        if (! SetNativeOperation(*Task, SUG_BOP_LevelsManual, bUseNativeShader, MappedScalars, MappedTextures))
+        {
+            Task->SetParameters(
+                *Graph,
+                ParameterCategoryName,
+                TEXT("LevelsManual"),
+                MappedScalars,
+                { },
+                MappedTextures
+                );
+        }
     }
 
     return Task;
@@ -164,13 +229,14 @@ USUGGraphTask_ApplyMaterial* USUGGraphBaseMaterialLibrary::AddBlendTargetTask(
     const TArray<FSUGGraphTextureParameter>& TextureParameters,
     FName ParameterCategoryName,
     FSUGGraphTextureInput SourceTexture,
-    float Opacity
+    float Opacity,
+    bool bUseNativeShader
     )
 {
     USUGGraphTask_ApplyMaterial* Task;
     Task = USUGGraphUtility::AddApplyMaterialTaskWithParameters(
         Graph,
-        TaskType,
+        GetBaseTaskType(TaskType, bUseNativeShader),
         TaskConfig,
         ConfigMethod,
         OutputTask,
@@ -188,14 +254,17 @@ USUGGraphTask_ApplyMaterial* USUGGraphBaseMaterialLibrary::AddBlendTargetTask(
         MappedScalars.Emplace(TEXT("Opacity"), Opacity);
         MappedTextures.Emplace(TEXT("SourceTexture"), SourceTexture);
 
-        Task->SetParameters(
-            *Graph,
-            ParameterCategoryName,
-            TEXT("BlendTarget"),
-            MappedScalars,
-            { },
-            MappedTextures
-            );
+        if (! SetNativeOperation(*Task, SUG_BOP_BlendTarget, bUseNativeShader, MappedScalars, MappedTextures))
+        {
+            Task->SetParameters(
+                *Graph,
+                ParameterCategoryName,
+                TEXT("BlendTarget"),
+                MappedScalars,
+                { },
+                MappedTextures
+                );
+        }
     }
 
     return Task;
@@ -214,13 +283,14 @@ USUGGraphTask_ApplyMaterial* USUGGraphBaseMaterialLibrary::AddBlendTargetMaskedT
     FName ParameterCategoryName,
     FSUGGraphTextureInput SourceTexture,
     FSUGGraphTextureInput MaskTexture,
-    float Opacity
+    float Opacity,
+    bool bUseNativeShader
     )
 {
     USUGGraphTask_ApplyMaterial* Task;
     Task = USUGGraphUtility::AddApplyMaterialTaskWithParameters(
         Graph,
-        TaskType,
+        GetBaseTaskType(TaskType, bUseNativeShader),
         TaskConfig,
         ConfigMethod,
         OutputTask,
@@ -239,14 +309,17 @@ USUGGraphTask_ApplyMaterial* USUGGraphBaseMaterialLibrary::AddBlendTargetMaskedT
         MappedTextures.Emplace(TEXT("SourceTexture"), SourceTexture);
         MappedTextures.Emplace(TEXT("MaskTexture"), MaskTexture);
 
-        Task->SetParameters(
-            *Graph,
-            ParameterCategoryName,
-            TEXT("BlendTargetMasked"),
-            MappedScalars,
-            { },
-            MappedTextures
-            );
+        if (! SetNativeOperation(*Task, SUG_BOP_BlendTargetMasked, bUseNativeShader, MappedScalars, MappedTextures))
+        {
+            Task->SetParameters(
+                *Graph,
+                ParameterCategoryName,
+                TEXT("BlendTargetMasked"),
+                MappedScalars,
+                { },
+                MappedTextures
+                );
+        }
     }
 
     return Task;
@@ -265,13 +338,14 @@ USUGGraphTask_ApplyMaterial* USUGGraphBaseMaterialLibrary::AddBlendTask(
     FName ParameterCategoryName,
     FSUGGraphTextureInput BackgroundTexture,
     FSUGGraphTextureInput ForegroundTexture,
-    float Opacity
+    float Opacity,
+    bool bUseNativeShader
     )
 {
     USUGGraphTask_ApplyMaterial* Task;
     Task = USUGGraphUtility::AddApplyMaterialTaskWithParameters(
         Graph,
-        TaskType,
+        GetBaseTaskType(TaskType, bUseNativeShader),
         TaskConfig,
         ConfigMethod,
         OutputTask,
@@ -290,14 +364,17 @@ USUGGraphTask_ApplyMaterial* USUGGraphBaseMaterialLibrary::AddBlendTask(
         MappedTextures.Emplace(TEXT("BackgroundTexture"), BackgroundTexture);
         MappedTextures.Emplace(TEXT("ForegroundTexture"), ForegroundTexture);
 
-        Task->SetParameters(
-            *Graph,
-            ParameterCategoryName,
-            TEXT("Blend"),
-            MappedScalars,
-            { },
-            MappedTextures
-            );
+        if (! SetNativeOperation(*Task, SUG_BOP_Blend, bUseNativeShader, MappedScalars, MappedTextures))
+        {
+            Task->SetParameters(
+                *Graph,
+                ParameterCategoryName,
+                TEXT("Blend"),
+                MappedScalars,
+                { },
+                MappedTextures
+                );
+        }
     }
 
     return Task;
@@ -317,13 +394,14 @@ USUGGraphTask_ApplyMaterial* USUGGraphBaseMaterialLibrary::AddBlendMaskedTask(
     FSUGGraphTextureInput BackgroundTexture,
     FSUGGraphTextureInput ForegroundTexture,
     FSUGGraphTextureInput MaskTexture,
-    float Opacity
+    float Opacity,
+    bool bUseNativeShader
     )
 {
     USUGGraphTask_ApplyMaterial* Task;
     Task = USUGGraphUtility::AddApplyMaterialTaskWithParameters(
         Graph,
-        TaskType,
+        GetBaseTaskType(TaskType, bUseNativeShader),
         TaskConfig,
         ConfigMethod,
         OutputTask,
@@ -343,14 +421,17 @@ USUGGraphTask_ApplyMaterial* USUGGraphBaseMaterialLibrary::AddBlendMaskedTask(
         MappedTextures.Emplace(TEXT("ForegroundTexture"), ForegroundTexture);
         MappedTextures.Emplace(TEXT("MaskTexture"), MaskTexture);
 
-        Task->SetParameters(
-            *Graph,
-            ParameterCategoryName,
-            TEXT("BlendMasked"),
-            MappedScalars,
-            { },
-            MappedTextures
-            );
+        if (! SetNativeOperation(*Task, SUG_BOP_BlendMasked, bUseNativeShader, MappedScalars, MappedTextures))
+        {
+            Task->SetParameters(
+                *Graph,
+                ParameterCategoryName,
+                TEXT("BlendMasked"),
+                MappedScalars,
+                { },
+                MappedTextures
+                );
+        }
     }
 
     return Task;
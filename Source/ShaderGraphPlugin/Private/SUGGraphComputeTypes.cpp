@@ -0,0 +1,149 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+#include "SUGGraphComputeTypes.h"
+#include "RenderUtils.h"
+
+FSUGGraphBufferPool::~FSUGGraphBufferPool()
+{
+    Empty();
+}
+
+FRWBufferStructured& FSUGGraphBufferPool::AcquireBuffer(uint32 BytesPerElement, uint32 NumElements)
+{
+    check(IsInRenderingThread());
+
+    // Reuse free buffer with matching layout
+    for (TUniquePtr<FPooledBuffer>& PooledBuffer : Buffers)
+    {
+        if (! PooledBuffer->bInUse &&
+            PooledBuffer->BytesPerElement == BytesPerElement &&
+            PooledBuffer->NumElements == NumElements)
+        {
+            PooledBuffer->bInUse = true;
+            return PooledBuffer->Buffer;
+        }
+    }
+
+    TUniquePtr<FPooledBuffer>& PooledBuffer(Buffers[Buffers.Emplace(MakeUnique<FPooledBuffer>())]);
+    PooledBuffer->Buffer.Initialize(BytesPerElement, NumElements, 0, TEXT("SUGGraphBufferPool"));
+    PooledBuffer->BytesPerElement = BytesPerElement;
+    PooledBuffer->NumElements = NumElements;
+    PooledBuffer->bInUse = true;
+
+    return PooledBuffer->Buffer;
+}
+
+void FSUGGraphBufferPool::ReleaseBuffers()
+{
+    for (TUniquePtr<FPooledBuffer>& PooledBuffer : Buffers)
+    {
+        PooledBuffer->bInUse = false;
+    }
+}
+
+void FSUGGraphBufferPool::Empty()
+{
+    for (TUniquePtr<FPooledBuffer>& PooledBuffer : Buffers)
+    {
+        PooledBuffer->Buffer.Release();
+    }
+
+    for (TUniquePtr<FCachedBuffer>& CachedBuffer : CachedBuffers)
+    {
+        CachedBuffer->Buffer.Release();
+    }
+
+    Buffers.Empty();
+    CachedBuffers.Empty();
+}
+
+FRWBufferStructured* FSUGGraphBufferPool::FindCachedBuffer(FTextureRHIParamRef KeyTexture, const FIntPoint& KeySize)
+{
+    check(IsInRenderingThread());
+
+    for (TUniquePtr<FCachedBuffer>& CachedBuffer : CachedBuffers)
+    {
+        if (CachedBuffer->KeyTexture == KeyTexture && CachedBuffer->KeySize == KeySize)
+        {
+            CachedBuffer->LastUse = ++CacheUseCounter;
+            return &CachedBuffer->Buffer;
+        }
+    }
+
+    return nullptr;
+}
+
+FRWBufferStructured& FSUGGraphBufferPool::AddCachedBuffer(FTextureRHIParamRef KeyTexture, const FIntPoint& KeySize, uint32 BytesPerElement, uint32 NumElements)
+{
+    check(IsInRenderingThread());
+
+    // Release buffer with matching key or the least recently used buffer
+    // if the cache is full
+
+    int32 ReleaseIndex = CachedBuffers.IndexOfByPredicate(
+        [KeyTexture, &KeySize](const TUniquePtr<FCachedBuffer>& CachedBuffer)
+        {
+            return CachedBuffer->KeyTexture == KeyTexture && CachedBuffer->KeySize == KeySize;
+        } );
+
+    if (ReleaseIndex == INDEX_NONE && CachedBuffers.Num() >= MaxCachedBuffers)
+    {
+        ReleaseIndex = 0;
+
+        for (int32 i=1; i<CachedBuffers.Num(); ++i)
+        {
+            if (CachedBuffers[i]->LastUse < CachedBuffers[ReleaseIndex]->LastUse)
+            {
+                ReleaseIndex = i;
+            }
+        }
+    }
+
+    if (ReleaseIndex != INDEX_NONE)
+    {
+        CachedBuffers[ReleaseIndex]->Buffer.Release();
+        CachedBuffers.RemoveAtSwap(ReleaseIndex);
+    }
+
+    TUniquePtr<FCachedBuffer>& CachedBuffer(CachedBuffers[CachedBuffers.Emplace(MakeUnique<FCachedBuffer>())]);
+    CachedBuffer->Buffer.Initialize(BytesPerElement, NumElements, 0, TEXT("SUGGraphBufferPoolCache"));
+    CachedBuffer->KeyTexture = KeyTexture;
+    CachedBuffer->KeySize = KeySize;
+    CachedBuffer->LastUse = ++CacheUseCounter;
+
+    return CachedBuffer->Buffer;
+}
+
+FTextureRHIParamRef FSUGGraphComputeContext::GetInputTexture(FName InputName) const
+{
+    const int32 InputIndex = InputNames.IndexOfByKey(InputName);
+
+    return (InputIndex != INDEX_NONE && InputTextures[InputIndex])
+        ? InputTextures[InputIndex]
+        : GBlackTexture->TextureRHI.GetReference();
+}
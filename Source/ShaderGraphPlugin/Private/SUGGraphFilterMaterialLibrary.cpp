@@ -69,6 +69,8 @@ USUGGraphTask_ApplyMaterial* USUGGraphFilterMaterialLibrary::AddDistanceFilterTa
         MappedScalars.Emplace(TEXT("DistanceSteps"), DistanceSteps);
         MappedTextures.Emplace(TEXT("SourceTexture"), SourceTexture);
 
+        Task->FootprintRadius = FMath::CeilToInt(DistanceSteps);
+
         check(Graph != nullptr);
 
         Task->SetParameters(
@@ -190,6 +192,12 @@ USUGGraphTask_BlurFilter1D* USUGGraphFilterMaterialLibrary::AddBlurFilter1DTask(
 
             Task->MaterialRef = MaterialRef;
 
+            Task->BlurSampleCountParameterName = Graph->GetParameterNameFromCategory(
+                ParameterCategoryName,
+                TEXT("BlurFilter1D"),
+                TEXT("BlurSampleCount")
+                );
+
             Task->DirectionXParameterName = Graph->GetParameterNameFromCategory(
                 ParameterCategoryName,
                 TEXT("BlurFilter1D"),
@@ -249,7 +257,9 @@ USUGGraphTask_ErodeFilter* USUGGraphFilterMaterialLibrary::AddErodeFilterTask(
     FName ParameterCategoryName,
     FSUGGraphTextureInput SourceTexture,
     FSUGGraphTextureInput WeightTexture,
-    int32 IterationCount
+    int32 IterationCount,
+    bool bStopOnConvergence,
+    float ConvergenceThreshold
     )
 {
     USUGGraphTask_ErodeFilter* Task = nullptr;
@@ -274,6 +284,8 @@ USUGGraphTask_ErodeFilter* USUGGraphFilterMaterialLibrary::AddErodeFilterTask(
 
             Task->MaterialRef = MaterialRef;
             Task->IterationCount = IterationCount;
+            Task->bStopOnConvergence = bStopOnConvergence;
+            Task->ConvergenceThreshold = ConvergenceThreshold;
 
             Task->SourceTextureParameterName = Graph->GetParameterNameFromCategory(
                 ParameterCategoryName,
@@ -26,7 +26,16 @@
 // 
 
 #include "SUGGraphManager.h"
+#include "Engine/AssetManager.h"
+#include "Engine/TextureRenderTarget2D.h"
 #include "Kismet/KismetRenderingLibrary.h"
+#include "Materials/MaterialInterface.h"
+#include "MaterialShared.h"
+#include "RenderingThread.h"
+#include "Shaders/RULShaderLibrary.h"
+#include "TimerManager.h"
+#include "SUGGraphComputeTypes.h"
+#include "SUGGraphScheduler.h"
 
 UTextureRenderTarget2D* USUGGraphManager::GetGraphOutput(FName OutputName)
 {
@@ -35,16 +44,41 @@ UTextureRenderTarget2D* USUGGraphManager::GetGraphOutput(FName OutputName)
         : nullptr;
 }
 
+int32 USUGGraphManager::GetGraphOutputVersion(FName OutputName) const
+{
+    return IsValid(Graph)
+        ? Graph->GetOutputVersion(OutputName)
+        : 0;
+}
+
 void USUGGraphManager::K2_ExecuteGraph(USUGGraph* GraphInstance)
 {
-    if (IsValid(Graph) && Graph->IsExecutionInProgress())
+    ExecuteGraph(GraphInstance);
+}
+
+void USUGGraphManager::K2_RequestExecuteGraph(USUGGraph* GraphInstance)
+{
+    USUGGraphScheduler* Scheduler = USUGGraphScheduler::Get();
+
+    if (IsValid(Scheduler))
     {
-        UE_LOG(LogSGP,Warning, TEXT("USUGGraphUtility::K2_ExecuteGraph() ABORTED, GRAPH EXECUTION IS IN PROGRESS"));
-        return;
+        Scheduler->RequestExecution(this, GraphInstance);
     }
+    // No scheduler available, execute immediately
+    else
+    {
+        ExecuteGraph(GraphInstance);
+    }
+}
 
-    Initialize(GraphInstance);
-    Execute();
+void USUGGraphManager::K2_CancelExecuteGraphRequest()
+{
+    USUGGraphScheduler* Scheduler = USUGGraphScheduler::Get();
+
+    if (IsValid(Scheduler))
+    {
+        Scheduler->CancelRequest(this);
+    }
 }
 
 void USUGGraphManager::K2_ClearOutputs()
@@ -52,8 +86,35 @@ void USUGGraphManager::K2_ClearOutputs()
     ClearOutputRTs();
 }
 
+void USUGGraphManager::K2_ClearMIDPool()
+{
+    ClearMIDPool();
+}
+
+void USUGGraphManager::K2_ResetSimulation(FName SimulationName)
+{
+    SimulationStateMap.Remove(SimulationName);
+}
+
+int32 USUGGraphManager::K2_GetSimulationStepCount(FName SimulationName) const
+{
+    const FSUGGraphSimulationState* State = FindSimulationState(SimulationName);
+    return State ? State->StepCount : 0;
+}
+
+bool USUGGraphManager::K2_IsAssetPreloadPending() const
+{
+    return IsAssetPreloadPending();
+}
+
+bool USUGGraphManager::K2_WarmUpGraph(USUGGraph* GraphInstance, bool bBlockOnShaderCompilation)
+{
+    return WarmUpGraph(GraphInstance, bBlockOnShaderCompilation);
+}
+
 void USUGGraphManager::Reset()
 {
+    CancelAssetPreload();
     Graph = nullptr;
 }
 
@@ -61,6 +122,12 @@ void USUGGraphManager::Initialize(USUGGraph* GraphInstance)
 {
     check(! IsValid(Graph) || ! Graph->IsExecutionInProgress());
 
+    // Switching graph instance, discard execution deferred by asset preload
+    if (IsValid(GraphInstance) && GraphInstance != Graph)
+    {
+        CancelAssetPreload();
+    }
+
     if (IsValid(GraphInstance))
     {
         Graph = GraphInstance;
@@ -87,17 +154,291 @@ void USUGGraphManager::Execute()
     if (IsValid(Graph))
     {
         check(! Graph->IsExecutionInProgress());
+
+        // Graph is already prepared and waiting for assets or shaders
+        if (IsExecutionDeferred())
+        {
+            return;
+        }
+
+        // Incremental graphs retain tasks queued by the first preparation
+        if (Graph->NeedsPrepare())
+        {
+            Graph->K2_PrepareGraph(this);
+        }
+
+        bExecutionDeferred = true;
+
+        // Defer execution until referenced assets have been streamed in
+        if (IsAssetPreloadPending() || (bPreloadAssets && StartAssetPreload()))
+        {
+            return;
+        }
+
+        ExecuteDeferred();
+    }
+}
+
+void USUGGraphManager::ExecuteDeferred()
+{
+    // Deferred execution has already been performed or discarded
+    if (! bExecutionDeferred)
+    {
+        return;
+    }
+
+    if (! IsValid(Graph))
+    {
+        bExecutionDeferred = false;
+        return;
+    }
+
+    check(! Graph->IsExecutionInProgress());
+
+    // Shaders still compiling, retry on the next frame
+    if (bDeferUntilShadersReady && ! WarmUpGraphMaterials(false))
+    {
+        UWorld* World = GetWorld();
+
+        if (World)
+        {
+            World->GetTimerManager().SetTimerForNextTick(
+                FTimerDelegate::CreateUObject(this, &USUGGraphManager::ExecuteDeferred)
+                );
+            return;
+        }
+
+        // No world to retry from, wait for compilation
+        WarmUpGraphMaterials(true);
+    }
+
+    bExecutionDeferred = false;
+    Graph->ExecuteGraph(this);
+}
+
+void USUGGraphManager::ExecuteGraph(USUGGraph* GraphInstance)
+{
+    if (IsValid(Graph) && Graph->IsExecutionInProgress())
+    {
+        UE_LOG(LogSGP,Warning, TEXT("USUGGraphUtility::ExecuteGraph() ABORTED, GRAPH EXECUTION IS IN PROGRESS"));
+        return;
+    }
+
+    Initialize(GraphInstance);
+    Execute();
+}
+
+bool USUGGraphManager::StartAssetPreload()
+{
+    check(IsValid(Graph));
+
+    TArray<FSoftObjectPath> AssetPaths;
+    Graph->GatherAssetReferences(AssetPaths);
+
+    if (AssetPaths.Num() == 0)
+    {
+        return false;
+    }
+
+    PreloadHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(
+        AssetPaths,
+        FStreamableDelegate::CreateUObject(this, &USUGGraphManager::OnAssetPreloadCompleted),
+        FStreamableManager::AsyncLoadHighPriority
+        );
+
+    return IsAssetPreloadPending();
+}
+
+void USUGGraphManager::CancelAssetPreload()
+{
+    if (PreloadHandle.IsValid())
+    {
+        PreloadHandle->CancelHandle();
+        PreloadHandle.Reset();
+    }
+
+    DiscardDeferredExecution();
+}
+
+void USUGGraphManager::DiscardDeferredExecution()
+{
+    if (bExecutionDeferred)
+    {
+        bExecutionDeferred = false;
+
+        if (IsValid(Graph) && ! Graph->IsExecutionInProgress())
+        {
+            Graph->DiscardPreparedTasks();
+        }
+    }
+}
+
+void USUGGraphManager::OnAssetPreloadCompleted()
+{
+    PreloadHandle.Reset();
+    ExecuteDeferred();
+}
+
+bool USUGGraphManager::WarmUpGraph(USUGGraph* GraphInstance, bool bBlockOnShaderCompilation)
+{
+    if (IsValid(Graph) && Graph->IsExecutionInProgress())
+    {
+        UE_LOG(LogSGP,Warning, TEXT("USUGGraphManager::WarmUpGraph() ABORTED, GRAPH EXECUTION IS IN PROGRESS"));
+        return false;
+    }
+
+    Initialize(GraphInstance);
+
+    if (! IsValid(Graph))
+    {
+        return false;
+    }
+
+    // Prepare graph to gather task materials, tasks are discarded afterwards
+    // unless retained by incremental execution
+    const bool bPrepareGraph = ! IsExecutionDeferred() && Graph->NeedsPrepare();
+
+    if (bPrepareGraph)
+    {
         Graph->K2_PrepareGraph(this);
-        Graph->ExecuteGraph(this);
     }
+
+    const bool bShadersReady = WarmUpGraphMaterials(bBlockOnShaderCompilation);
+
+    if (bPrepareGraph)
+    {
+        Graph->DiscardPreparedTasks();
+    }
+
+    return bShadersReady;
 }
 
-int32 USUGGraphManager::FindFreeRTIndex(const FRULShaderOutputConfig& OutputConfig)
+bool USUGGraphManager::WarmUpGraphMaterials(bool bBlockOnShaderCompilation)
+{
+    check(IsValid(Graph));
+
+    TArray<FSUGGraphMaterialWarmUpEntry> Entries;
+    Graph->GatherMaterialWarmUpEntries(Entries);
+
+    bool bShadersReady = true;
+
+    for (const FSUGGraphMaterialWarmUpEntry& Entry : Entries)
+    {
+        UMaterialInterface* Material = IsValid(Entry.Material)
+            ? Entry.Material
+            : GetNamedMaterial(Entry.MaterialName);
+
+        if (! IsValid(Material))
+        {
+            continue;
+        }
+
+        if (IsMaterialShaderReady(*Material, bBlockOnShaderCompilation))
+        {
+            WarmUpMaterialPipeline(*Material, Entry);
+        }
+        else
+        {
+            bShadersReady = false;
+        }
+    }
+
+    return bShadersReady;
+}
+
+bool USUGGraphManager::IsMaterialShaderReady(UMaterialInterface& Material, bool bBlockOnShaderCompilation) const
+{
+    const UWorld* World = GetWorld();
+    const ERHIFeatureLevel::Type FeatureLevel = World ? World->FeatureLevel.GetValue() : GMaxRHIFeatureLevel;
+
+    FMaterialResource* MaterialResource = Material.GetMaterialResource(FeatureLevel);
+
+    if (! MaterialResource)
+    {
+        return true;
+    }
+
+    if (! MaterialResource->IsCompilationFinished())
+    {
+        if (! bBlockOnShaderCompilation)
+        {
+            return false;
+        }
+
+        MaterialResource->FinishCompilation();
+    }
+
+    return true;
+}
+
+void USUGGraphManager::WarmUpMaterialPipeline(UMaterialInterface& Material, const FSUGGraphMaterialWarmUpEntry& Entry)
+{
+    TArray<uint16>& PipelineKeys(WarmedPipelineMap.FindOrAdd(&Material));
+    const uint16 PipelineKey = Entry.GetPipelineKey();
+
+    if (PipelineKeys.Contains(PipelineKey))
+    {
+        return;
+    }
+
+    UTextureRenderTarget2D* RenderTarget = GetWarmUpRenderTarget(Entry.Format);
+    UMaterialInstanceDynamic* MID = GetCachedMID(&Material);
+
+    if (IsValid(RenderTarget) && IsValid(MID))
+    {
+        // Draw material once with the task draw state so the pipeline state
+        // is created before the first graph execution
+        URULShaderLibrary::ApplyMaterial(this, MID, RenderTarget, Entry.DrawConfig);
+        PipelineKeys.Emplace(PipelineKey);
+    }
+}
+
+UTextureRenderTarget2D* USUGGraphManager::GetWarmUpRenderTarget(ETextureRenderTargetFormat Format)
+{
+    for (UTextureRenderTarget2D* RenderTarget : WarmUpRenderTargets)
+    {
+        if (IsValid(RenderTarget) && RenderTarget->RenderTargetFormat == Format)
+        {
+            return RenderTarget;
+        }
+    }
+
+    UTextureRenderTarget2D* RenderTarget = UKismetRenderingLibrary::CreateRenderTarget2D(this, 4, 4, Format);
+
+    if (IsValid(RenderTarget))
+    {
+        WarmUpRenderTargets.Emplace(RenderTarget);
+    }
+
+    return RenderTarget;
+}
+
+FVector USUGGraphManager::GetSchedulingLocation() const
+{
+    const AActor* Owner = GetOwner();
+    return IsValid(Owner) ? Owner->GetActorLocation() : FVector::ZeroVector;
+}
+
+bool USUGGraphManager::IsSchedulingOwnerVisible() const
+{
+    const AActor* Owner = GetOwner();
+    return IsValid(Owner) && Owner->WasRecentlyRendered();
+}
+
+void USUGGraphManager::BeginDestroy()
+{
+    ClearBufferPool();
+    Super::BeginDestroy();
+}
+
+int32 USUGGraphManager::FindFreeRTIndex(const FRULShaderOutputConfig& OutputConfig, bool bRequireUAV)
 {
     int32 OutputIndex = RenderTargetPool.IndexOfByPredicate(
-        [&OutputConfig](const FSUGGraphOutputRT& Output)
+        [&OutputConfig, bRequireUAV](const FSUGGraphOutputRT& Output)
         {
-            return Output.IsValidOutput() && Output.CompareFormat(OutputConfig);
+            return Output.IsValidOutput()
+                && Output.CompareFormat(OutputConfig)
+                && (! bRequireUAV || Output.RenderTarget->bCanCreateUAV);
         } );
     return OutputIndex;
 }
@@ -112,9 +453,31 @@ UTextureRenderTarget2D* USUGGraphManager::CreateOutputRenderTarget(const FRULSha
         );
 }
 
-void USUGGraphManager::FindFreeOutputRT(const FRULShaderOutputConfig& OutputConfig, FSUGGraphOutputRT& OutputRT)
+UTextureRenderTarget2D* USUGGraphManager::CreateUAVOutputRenderTarget(const FRULShaderOutputConfig& OutputConfig)
+{
+    if (OutputConfig.SizeX <= 0 || OutputConfig.SizeY <= 0)
+    {
+        UE_LOG(LogSGP,Warning, TEXT("USUGGraphManager::CreateUAVOutputRenderTarget() ABORTED, INVALID DIMENSION"));
+        return nullptr;
+    }
+
+    UTextureRenderTarget2D* RenderTarget = NewObject<UTextureRenderTarget2D>(this);
+
+    if (IsValid(RenderTarget))
+    {
+        RenderTarget->RenderTargetFormat = OutputConfig.Format;
+        RenderTarget->ClearColor = FLinearColor::Black;
+        RenderTarget->bCanCreateUAV = true;
+        RenderTarget->InitAutoFormat(OutputConfig.SizeX, OutputConfig.SizeY);
+        RenderTarget->UpdateResourceImmediate(true);
+    }
+
+    return RenderTarget;
+}
+
+void USUGGraphManager::FindFreeOutputRT(const FRULShaderOutputConfig& OutputConfig, FSUGGraphOutputRT& OutputRT, bool bRequireUAV)
 {
-    int32 OutputIndex = FindFreeRTIndex(OutputConfig);
+    int32 OutputIndex = FindFreeRTIndex(OutputConfig, bRequireUAV);
 
     // Reuse free output
     if (OutputIndex >= 0)
@@ -127,7 +490,9 @@ void USUGGraphManager::FindFreeOutputRT(const FRULShaderOutputConfig& OutputConf
     // Create new output
     else
     {
-        UTextureRenderTarget2D* NewRenderTarget = CreateOutputRenderTarget(OutputConfig);
+        UTextureRenderTarget2D* NewRenderTarget = bRequireUAV
+            ? CreateUAVOutputRenderTarget(OutputConfig)
+            : CreateOutputRenderTarget(OutputConfig);
 
         if (IsValid(NewRenderTarget))
         {
@@ -144,6 +509,33 @@ void USUGGraphManager::ClearOutputRTs()
     RenderTargetPool.Empty();
 }
 
+FSUGGraphBufferPoolPtr USUGGraphManager::GetBufferPool()
+{
+    if (! BufferPool.IsValid())
+    {
+        BufferPool = MakeShared<FSUGGraphBufferPool, ESPMode::ThreadSafe>();
+    }
+
+    return BufferPool;
+}
+
+void USUGGraphManager::ClearBufferPool()
+{
+    if (BufferPool.IsValid())
+    {
+        // Pooled buffers are released on the rendering thread once pending
+        // dispatches referencing the pool have completed
+        FSUGGraphBufferPoolPtr ReleasedPool = BufferPool;
+        BufferPool.Reset();
+
+        ENQUEUE_RENDER_COMMAND(SUGGraphManager_ClearBufferPool)(
+            [ReleasedPool](FRHICommandListImmediate& RHICmdList) mutable
+            {
+                ReleasedPool.Reset();
+            } );
+    }
+}
+
 UMaterialInstanceDynamic* USUGGraphManager::GetCachedMID(UMaterialInterface* BaseMaterial, bool bClearParameterValues)
 {
     auto* MIDPtr = BasedMIDCacheMap.Find(BaseMaterial);
@@ -194,33 +586,145 @@ UMaterialInstanceDynamic* USUGGraphManager::GetCachedMID(FName MaterialName, boo
     }
     else
     {
-        UMaterialInterface* Material = nullptr;
-
-        const URULShaderMaterialLibrary* Library = UShaderGraphPluginSettings::GetMaterialLibrary();
+        UMaterialInterface* Material = GetNamedMaterial(MaterialName);
 
-        if (IsValid(Library))
+        if (IsValid(Material))
         {
-            Material = Library->GetMaterial(MaterialName);
+            MID = UMaterialInstanceDynamic::Create(Material, this);
 
-            if (IsValid(Material))
-            {
-                MID = UMaterialInstanceDynamic::Create(Material, this);
-
-                if (IsValid(MID))
-                {
-                    NamedMIDCacheMap.Emplace(MaterialName, MID);
-                }
-            }
-            else
+            if (IsValid(MID))
             {
-                UE_LOG(LogSGP,Warning, TEXT("USUGGraphUtility::GetCachedMID() ABORTED, SOURCE MATERIAL '%s' NOT FOUND"), *MaterialName.ToString());
+                NamedMIDCacheMap.Emplace(MaterialName, MID);
             }
         }
-        else
+    }
+
+    return MID;
+}
+
+UMaterialInterface* USUGGraphManager::GetNamedMaterial(FName MaterialName) const
+{
+    UMaterialInterface* Material = nullptr;
+
+    const URULShaderMaterialLibrary* Library = UShaderGraphPluginSettings::GetMaterialLibrary();
+
+    if (IsValid(Library))
+    {
+        Material = Library->GetMaterial(MaterialName);
+
+        if (! IsValid(Material))
         {
-            UE_LOG(LogSGP,Warning, TEXT("USUGGraphUtility::GetCachedMID() ABORTED, MATERIAL LIBRARY NOT FOUND! (Check Rendering Utility Settings project settings)"));
+            UE_LOG(LogSGP,Warning, TEXT("USUGGraphUtility::GetNamedMaterial() ABORTED, SOURCE MATERIAL '%s' NOT FOUND"), *MaterialName.ToString());
         }
     }
+    else
+    {
+        UE_LOG(LogSGP,Warning, TEXT("USUGGraphUtility::GetNamedMaterial() ABORTED, MATERIAL LIBRARY NOT FOUND! (Check Rendering Utility Settings project settings)"));
+    }
 
-    return MID;
+    return Material;
+}
+
+UMaterialInstanceDynamic* USUGGraphManager::GetPooledMID(UMaterialInterface* BaseMaterial, FSUGGraphPooledMIDHandle& OutHandle)
+{
+    OutHandle.Reset();
+
+    if (! IsValid(BaseMaterial))
+    {
+        UE_LOG(LogSGP,Warning, TEXT("USUGGraphManager::GetPooledMID() ABORTED, INVALID MATERIAL"));
+        return nullptr;
+    }
+
+    FSUGGraphMIDPoolEntry& PoolEntry(MIDPoolMap.FindOrAdd(BaseMaterial));
+    const int32 InstanceIndex = PoolEntry.UseCount++;
+
+    if (! PoolEntry.ParameterLayout.bIsBuilt)
+    {
+        PoolEntry.ParameterLayout.Build(*BaseMaterial);
+    }
+
+    // Create new instance for uses beyond the pool size
+    if (! PoolEntry.Instances.IsValidIndex(InstanceIndex) || ! IsValid(PoolEntry.Instances[InstanceIndex]))
+    {
+        UMaterialInstanceDynamic* MID = UMaterialInstanceDynamic::Create(BaseMaterial, this);
+
+        if (! IsValid(MID))
+        {
+            return nullptr;
+        }
+
+        PoolEntry.Instances.SetNumZeroed(FMath::Max(PoolEntry.Instances.Num(), InstanceIndex+1));
+        PoolEntry.ParameterStates.SetNum(PoolEntry.Instances.Num());
+        PoolEntry.Instances[InstanceIndex] = MID;
+
+        PoolEntry.ParameterLayout.InitializeInstance(*MID, PoolEntry.ParameterStates[InstanceIndex]);
+    }
+
+    OutHandle.Manager = this;
+    OutHandle.BaseMaterial = BaseMaterial;
+    OutHandle.InstanceIndex = InstanceIndex;
+
+    return PoolEntry.Instances[InstanceIndex];
+}
+
+UMaterialInstanceDynamic* USUGGraphManager::GetPooledMID(FName MaterialName, FSUGGraphPooledMIDHandle& OutHandle)
+{
+    OutHandle.Reset();
+
+    UMaterialInterface* Material = GetNamedMaterial(MaterialName);
+
+    return IsValid(Material)
+        ? GetPooledMID(Material, OutHandle)
+        : nullptr;
+}
+
+bool USUGGraphManager::FindPooledMIDState(
+    const FSUGGraphPooledMIDHandle& Handle,
+    const FSUGGraphMaterialParameterLayout*& OutLayout,
+    FSUGGraphMIDParameterState*& OutState
+    )
+{
+    OutLayout = nullptr;
+    OutState = nullptr;
+
+    FSUGGraphMIDPoolEntry* PoolEntry = (Handle.Manager == this)
+        ? MIDPoolMap.Find(Handle.BaseMaterial)
+        : nullptr;
+
+    if (PoolEntry && PoolEntry->ParameterStates.IsValidIndex(Handle.InstanceIndex))
+    {
+        OutLayout = &PoolEntry->ParameterLayout;
+        OutState = &PoolEntry->ParameterStates[Handle.InstanceIndex];
+        return true;
+    }
+
+    return false;
+}
+
+void USUGGraphManager::ResetMIDPoolUsage()
+{
+    for (auto& PoolPair : MIDPoolMap)
+    {
+        PoolPair.Value.UseCount = 0;
+    }
+}
+
+void USUGGraphManager::ClearMIDPool()
+{
+    MIDPoolMap.Empty();
+}
+
+FSUGGraphSimulationState& USUGGraphManager::FindOrAddSimulationState(FName SimulationName)
+{
+    return SimulationStateMap.FindOrAdd(SimulationName);
+}
+
+const FSUGGraphSimulationState* USUGGraphManager::FindSimulationState(FName SimulationName) const
+{
+    return SimulationStateMap.Find(SimulationName);
+}
+
+void USUGGraphManager::ClearSimulationStates()
+{
+    SimulationStateMap.Empty();
 }
@@ -0,0 +1,1201 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+#include "SUGGraphRenderUtils.h"
+#include "CommonRenderResources.h"
+#include "Engine/Texture.h"
+#include "Engine/TextureRenderTarget2D.h"
+#include "PipelineStateCache.h"
+#include "RHICommandList.h"
+#include "RHIGPUReadback.h"
+#include "RHIStaticStates.h"
+#include "RenderUtils.h"
+#include "RenderingThread.h"
+#include "TextureResource.h"
+#include "SUGGraphShaders.h"
+
+bool FSUGGraphFusedOpParameters::AddStage(const FSUGGraphBaseOpParameters& Parameters, int32 ChainInputIndex)
+{
+    // Target blend operations read the render target and range textures are
+    // not supported by fused stages
+    if (Stages.Num() >= MaxStages ||
+        Parameters.RangeTexture != nullptr ||
+        Parameters.Operation == SUG_BOP_BlendTarget ||
+        Parameters.Operation == SUG_BOP_BlendTargetMasked ||
+        Parameters.Operation >= SUG_BOP_MAX)
+    {
+        return false;
+    }
+
+    FStage Stage;
+    Stage.Parameters = Parameters;
+
+    for (int32 i=0; i<3; ++i)
+    {
+        Stage.InputSlots[i] = (i == ChainInputIndex)
+            ? ChainSlot
+            : AddInput(Parameters.InputTextures[i]);
+
+        Stage.Parameters.InputTextures[i] = nullptr;
+    }
+
+    Stages.Emplace(Stage);
+
+    return true;
+}
+
+int32 FSUGGraphFusedOpParameters::AddInput(UTexture* InputTexture)
+{
+    if (! IsValid(InputTexture))
+    {
+        return DefaultSlot;
+    }
+
+    int32 Slot = InputTextures.Find(InputTexture);
+
+    if (Slot == INDEX_NONE)
+    {
+        check(InputTextures.Num() < MaxInputs);
+        Slot = InputTextures.Emplace(InputTexture);
+    }
+
+    return Slot;
+}
+
+void FSUGGraphGaussianBlurParameters::SetGaussianTaps(int32 Radius, float Sigma)
+{
+    Taps.Reset();
+
+    // Pixel radius is limited by the merged tap count, center tap and
+    // one tap per texel pair on each side
+    Radius = FMath::Clamp(Radius, 0, (int32) MaxRadius);
+
+    if (Sigma <= 0.f)
+    {
+        Sigma = FMath::Max(Radius / 3.f, .5f);
+    }
+
+    // Gaussian weights of the center and positive side texels
+
+    TArray<float, TInlineAllocator<MaxRadius+2>> Weights;
+    Weights.SetNumZeroed(Radius+2);
+
+    const float InvSigmaSq2 = 1.f / (2.f * Sigma * Sigma);
+    float WeightSum = 0.f;
+
+    for (int32 i=0; i<=Radius; ++i)
+    {
+        Weights[i] = FMath::Exp(-(i*i) * InvSigmaSq2);
+        WeightSum += (i > 0) ? (2.f * Weights[i]) : Weights[i];
+    }
+
+    for (int32 i=0; i<=Radius; ++i)
+    {
+        Weights[i] /= WeightSum;
+    }
+
+    // Center tap
+    Taps.Emplace(0.f, Weights[0], 0.f, 0.f);
+
+    // Merge adjacent texel pairs, a bilinear sample placed between texels
+    // at the weight centroid returns their weighted sum
+
+    for (int32 i=1; i<=Radius; i+=2)
+    {
+        const float Weight0 = Weights[i];
+        const float Weight1 = Weights[i+1];
+        const float Weight = Weight0 + Weight1;
+        const float Offset = (Weight > 0.f)
+            ? (i*Weight0 + (i+1)*Weight1) / Weight
+            : i;
+
+        Taps.Emplace(Offset, Weight, 0.f, 0.f);
+        Taps.Emplace(-Offset, Weight, 0.f, 0.f);
+    }
+
+    check(Taps.Num() <= MaxTaps);
+}
+
+void FSUGGraphRenderUtils::CopyTextureRegion(
+    UTexture* SourceTexture,
+    UTextureRenderTarget2D* TargetTexture,
+    const FIntRect& SourceRect,
+    const FIntPoint& TargetPosition
+    )
+{
+    if (! IsValid(SourceTexture) || ! IsValid(TargetTexture) || SourceRect.Area() <= 0)
+    {
+        return;
+    }
+
+    FTextureResource* SourceResource = SourceTexture->Resource;
+    FTextureRenderTargetResource* TargetResource = TargetTexture->GameThread_GetRenderTargetResource();
+
+    if (! SourceResource || ! TargetResource)
+    {
+        return;
+    }
+
+    const FIntRect TargetRect(TargetPosition, TargetPosition+SourceRect.Size());
+
+    ENQUEUE_RENDER_COMMAND(SUGGraphRenderUtils_CopyTextureRegion)(
+        [SourceResource, TargetResource, SourceRect, TargetRect](FRHICommandListImmediate& RHICmdList)
+        {
+            FTextureRHIParamRef SourceRHI = SourceResource->TextureRHI;
+            FTextureRHIParamRef TargetRHI = TargetResource->GetRenderTargetTexture();
+
+            if (! SourceRHI || ! TargetRHI)
+            {
+                return;
+            }
+
+            FResolveParams ResolveParams(
+                FResolveRect(SourceRect.Min.X, SourceRect.Min.Y, SourceRect.Max.X, SourceRect.Max.Y),
+                CubeFace_PosX,
+                0,
+                0,
+                0,
+                FResolveRect(TargetRect.Min.X, TargetRect.Min.Y, TargetRect.Max.X, TargetRect.Max.Y)
+                );
+
+            RHICmdList.CopyToResolveTarget(SourceRHI, TargetRHI, ResolveParams);
+        } );
+}
+
+void FSUGGraphRenderUtils::DrawBaseOp(const FSUGGraphBaseOpParameters& Parameters, UTextureRenderTarget2D* TargetTexture)
+{
+    if (! IsValid(TargetTexture) || Parameters.Operation >= SUG_BOP_MAX)
+    {
+        return;
+    }
+
+    FTextureRenderTargetResource* TargetResource = TargetTexture->GameThread_GetRenderTargetResource();
+
+    if (! TargetResource)
+    {
+        return;
+    }
+
+    FTextureResource* InputResources[3];
+
+    for (int32 i=0; i<3; ++i)
+    {
+        UTexture* InputTexture = Parameters.InputTextures[i];
+        InputResources[i] = IsValid(InputTexture) ? InputTexture->Resource : nullptr;
+    }
+
+    FTextureResource* RangeResource = IsValid(Parameters.RangeTexture)
+        ? Parameters.RangeTexture->Resource
+        : nullptr;
+
+    // Missing masks leave the source unmasked, other missing inputs are black
+    if (! InputResources[2])
+    {
+        InputResources[2] = GWhiteTexture;
+    }
+
+    const FIntPoint Dimension(TargetTexture->SizeX, TargetTexture->SizeY);
+    const FSUGGraphBaseOpParameters DrawParameters(Parameters);
+
+    ENQUEUE_RENDER_COMMAND(SUGGraphRenderUtils_DrawBaseOp)(
+        [TargetResource, InputResources, RangeResource, DrawParameters, Dimension](FRHICommandListImmediate& RHICmdList)
+        {
+            FTextureRHIParamRef TargetRHI = TargetResource->GetRenderTargetTexture();
+
+            if (! TargetRHI)
+            {
+                return;
+            }
+
+            FTextureRHIParamRef InputRHIs[3];
+
+            for (int32 i=0; i<3; ++i)
+            {
+                InputRHIs[i] = (InputResources[i] && InputResources[i]->TextureRHI)
+                    ? InputResources[i]->TextureRHI.GetReference()
+                    : GBlackTexture->TextureRHI.GetReference();
+            }
+
+            const bool bUseRangeTexture = RangeResource && RangeResource->TextureRHI;
+
+            FTextureRHIParamRef RangeRHI = bUseRangeTexture
+                ? RangeResource->TextureRHI.GetReference()
+                : GBlackTexture->TextureRHI.GetReference();
+
+            const bool bBlendTarget =
+                DrawParameters.Operation == SUG_BOP_BlendTarget ||
+                DrawParameters.Operation == SUG_BOP_BlendTargetMasked;
+
+            FSUGGraphBaseOpPS::FPermutationDomain PermutationVector;
+            PermutationVector.Set<FSUGGraphBaseOpPS::FOperationType>(DrawParameters.Operation);
+
+            TShaderMap<FGlobalShaderType>* ShaderMap = GetGlobalShaderMap(GMaxRHIFeatureLevel);
+            TShaderMapRef<FSUGGraphScreenVS> VertexShader(ShaderMap);
+            TShaderMapRef<FSUGGraphBaseOpPS> PixelShader(ShaderMap, PermutationVector);
+
+            // Target blend operations blend source color over the existing
+            // target color and retain target alpha
+            FRHIRenderPassInfo RenderPassInfo(
+                TargetRHI,
+                bBlendTarget ? ERenderTargetActions::Load_Store : ERenderTargetActions::DontLoad_Store
+                );
+
+            RHICmdList.BeginRenderPass(RenderPassInfo, TEXT("SUGGraphBaseOp"));
+
+            FGraphicsPipelineStateInitializer GraphicsPSOInit;
+            RHICmdList.ApplyCachedRenderTargets(GraphicsPSOInit);
+            GraphicsPSOInit.BlendState = bBlendTarget
+                ? TStaticBlendState<CW_RGBA, BO_Add, BF_SourceAlpha, BF_InverseSourceAlpha, BO_Add, BF_Zero, BF_One>::GetRHI()
+                : TStaticBlendState<>::GetRHI();
+            GraphicsPSOInit.RasterizerState = TStaticRasterizerState<>::GetRHI();
+            GraphicsPSOInit.DepthStencilState = TStaticDepthStencilState<false, CF_Always>::GetRHI();
+            GraphicsPSOInit.BoundShaderState.VertexDeclarationRHI = GEmptyVertexDeclaration.VertexDeclarationRHI;
+            GraphicsPSOInit.BoundShaderState.VertexShaderRHI = GETSAFERHISHADER_VERTEX(*VertexShader);
+            GraphicsPSOInit.BoundShaderState.PixelShaderRHI = GETSAFERHISHADER_PIXEL(*PixelShader);
+            GraphicsPSOInit.PrimitiveType = PT_TriangleList;
+            SetGraphicsPipelineState(RHICmdList, GraphicsPSOInit);
+
+            RHICmdList.SetViewport(0, 0, 0.f, Dimension.X, Dimension.Y, 1.f);
+
+            PixelShader->SetParameters(
+                RHICmdList,
+                InputRHIs[0],
+                InputRHIs[1],
+                InputRHIs[2],
+                DrawParameters.RemapParams,
+                DrawParameters.LevelsParams,
+                DrawParameters.Opacity,
+                RangeRHI,
+                bUseRangeTexture
+                );
+
+            RHICmdList.DrawPrimitive(0, 1, 1);
+            RHICmdList.EndRenderPass();
+        } );
+}
+
+void FSUGGraphRenderUtils::DrawFusedOps(const FSUGGraphFusedOpParameters& Parameters, UTextureRenderTarget2D* TargetTexture)
+{
+    if (! IsValid(TargetTexture) || ! Parameters.HasStages())
+    {
+        return;
+    }
+
+    FTextureRenderTargetResource* TargetResource = TargetTexture->GameThread_GetRenderTargetResource();
+
+    if (! TargetResource)
+    {
+        return;
+    }
+
+    typedef FSUGGraphFusedOpParameters FParams;
+
+    FTextureResource* InputResources[FParams::MaxInputs] = { nullptr };
+
+    for (int32 i=0; i<Parameters.InputTextures.Num(); ++i)
+    {
+        UTexture* InputTexture = Parameters.InputTextures[i];
+        InputResources[i] = IsValid(InputTexture) ? InputTexture->Resource : nullptr;
+    }
+
+    // Stage constants, operation and input slots are packed as
+    // (Operation, InputSlot0, InputSlot1, InputSlot2)
+
+    const int32 NumStages = Parameters.Stages.Num();
+
+    FVector4 StageOps[FParams::MaxStages];
+    FVector4 StageRemapParams[FParams::MaxStages];
+    FVector4 StageLevelsParams[FParams::MaxStages];
+    FVector4 StageOpacity(1.f, 1.f, 1.f, 1.f);
+
+    for (int32 i=0; i<NumStages; ++i)
+    {
+        const FParams::FStage& Stage(Parameters.Stages[i]);
+
+        StageOps[i] = FVector4(
+            Stage.Parameters.Operation,
+            Stage.InputSlots[0],
+            Stage.InputSlots[1],
+            Stage.InputSlots[2]
+            );
+        StageRemapParams[i] = Stage.Parameters.RemapParams;
+        StageLevelsParams[i] = Stage.Parameters.LevelsParams;
+        StageOpacity[i] = Stage.Parameters.Opacity;
+    }
+
+    const FIntPoint Dimension(TargetTexture->SizeX, TargetTexture->SizeY);
+
+    ENQUEUE_RENDER_COMMAND(SUGGraphRenderUtils_DrawFusedOps)(
+        [TargetResource, InputResources, NumStages, StageOps, StageRemapParams, StageLevelsParams, StageOpacity, Dimension](FRHICommandListImmediate& RHICmdList)
+        {
+            FTextureRHIParamRef TargetRHI = TargetResource->GetRenderTargetTexture();
+
+            if (! TargetRHI)
+            {
+                return;
+            }
+
+            FTextureRHIParamRef InputRHIs[FParams::MaxInputs];
+
+            for (int32 i=0; i<FParams::MaxInputs; ++i)
+            {
+                InputRHIs[i] = (InputResources[i] && InputResources[i]->TextureRHI)
+                    ? InputResources[i]->TextureRHI.GetReference()
+                    : GBlackTexture->TextureRHI.GetReference();
+            }
+
+            TShaderMap<FGlobalShaderType>* ShaderMap = GetGlobalShaderMap(GMaxRHIFeatureLevel);
+            TShaderMapRef<FSUGGraphScreenVS> VertexShader(ShaderMap);
+            TShaderMapRef<FSUGGraphFusedOpPS> PixelShader(ShaderMap);
+
+            FRHIRenderPassInfo RenderPassInfo(TargetRHI, ERenderTargetActions::DontLoad_Store);
+            RHICmdList.BeginRenderPass(RenderPassInfo, TEXT("SUGGraphFusedOps"));
+
+            FGraphicsPipelineStateInitializer GraphicsPSOInit;
+            RHICmdList.ApplyCachedRenderTargets(GraphicsPSOInit);
+            GraphicsPSOInit.BlendState = TStaticBlendState<>::GetRHI();
+            GraphicsPSOInit.RasterizerState = TStaticRasterizerState<>::GetRHI();
+            GraphicsPSOInit.DepthStencilState = TStaticDepthStencilState<false, CF_Always>::GetRHI();
+            GraphicsPSOInit.BoundShaderState.VertexDeclarationRHI = GEmptyVertexDeclaration.VertexDeclarationRHI;
+            GraphicsPSOInit.BoundShaderState.VertexShaderRHI = GETSAFERHISHADER_VERTEX(*VertexShader);
+            GraphicsPSOInit.BoundShaderState.PixelShaderRHI = GETSAFERHISHADER_PIXEL(*PixelShader);
+            GraphicsPSOInit.PrimitiveType = PT_TriangleList;
+            SetGraphicsPipelineState(RHICmdList, GraphicsPSOInit);
+
+            RHICmdList.SetViewport(0, 0, 0.f, Dimension.X, Dimension.Y, 1.f);
+
+            PixelShader->SetParameters(
+                RHICmdList,
+                InputRHIs,
+                NumStages,
+                StageOps,
+                StageRemapParams,
+                StageLevelsParams,
+                StageOpacity
+                );
+
+            RHICmdList.DrawPrimitive(0, 1, 1);
+            RHICmdList.EndRenderPass();
+        } );
+}
+
+void FSUGGraphRenderUtils::DrawGaussianBlur(
+    const FSUGGraphGaussianBlurParameters& Parameters,
+    UTexture* SourceTexture,
+    UTextureRenderTarget2D* ScratchTexture,
+    UTextureRenderTarget2D* TargetTexture
+    )
+{
+    if (! IsValid(SourceTexture) ||
+        ! IsValid(ScratchTexture) ||
+        ! IsValid(TargetTexture) ||
+        Parameters.Taps.Num() <= 0)
+    {
+        return;
+    }
+
+    FTextureResource* SourceResource = SourceTexture->Resource;
+    FTextureRenderTargetResource* ScratchResource = ScratchTexture->GameThread_GetRenderTargetResource();
+    FTextureRenderTargetResource* TargetResource = TargetTexture->GameThread_GetRenderTargetResource();
+
+    if (! SourceResource || ! ScratchResource || ! TargetResource)
+    {
+        return;
+    }
+
+    typedef FSUGGraphGaussianBlurParameters FParams;
+
+    const int32 NumTaps = Parameters.Taps.Num();
+    FVector4 Taps[FParams::MaxTaps];
+
+    for (int32 i=0; i<NumTaps; ++i)
+    {
+        Taps[i] = Parameters.Taps[i];
+    }
+
+    const FIntPoint SourceDimension(SourceResource->GetSizeX(), SourceResource->GetSizeY());
+    const FIntPoint ScratchDimension(ScratchTexture->SizeX, ScratchTexture->SizeY);
+    const FIntPoint TargetDimension(TargetTexture->SizeX, TargetTexture->SizeY);
+
+    ENQUEUE_RENDER_COMMAND(SUGGraphRenderUtils_DrawGaussianBlur)(
+        [SourceResource, ScratchResource, TargetResource, Taps, NumTaps, SourceDimension, ScratchDimension, TargetDimension](FRHICommandListImmediate& RHICmdList)
+        {
+            FTextureRHIParamRef SourceRHI = SourceResource->TextureRHI;
+            FTextureRHIParamRef ScratchRHI = ScratchResource->GetRenderTargetTexture();
+            FTextureRHIParamRef TargetRHI = TargetResource->GetRenderTargetTexture();
+
+            if (! SourceRHI || ! ScratchRHI || ! TargetRHI)
+            {
+                return;
+            }
+
+            TShaderMap<FGlobalShaderType>* ShaderMap = GetGlobalShaderMap(GMaxRHIFeatureLevel);
+            TShaderMapRef<FSUGGraphScreenVS> VertexShader(ShaderMap);
+            TShaderMapRef<FSUGGraphGaussianBlurPS> PixelShader(ShaderMap);
+
+            auto DrawPass = [&](FTextureRHIParamRef PassSourceRHI, FTextureRHIParamRef PassTargetRHI, const FIntPoint& PassDimension, const FVector2D& TexelStep)
+            {
+                FRHIRenderPassInfo RenderPassInfo(PassTargetRHI, ERenderTargetActions::DontLoad_Store);
+                RHICmdList.BeginRenderPass(RenderPassInfo, TEXT("SUGGraphGaussianBlur"));
+
+                FGraphicsPipelineStateInitializer GraphicsPSOInit;
+                RHICmdList.ApplyCachedRenderTargets(GraphicsPSOInit);
+                GraphicsPSOInit.BlendState = TStaticBlendState<>::GetRHI();
+                GraphicsPSOInit.RasterizerState = TStaticRasterizerState<>::GetRHI();
+                GraphicsPSOInit.DepthStencilState = TStaticDepthStencilState<false, CF_Always>::GetRHI();
+                GraphicsPSOInit.BoundShaderState.VertexDeclarationRHI = GEmptyVertexDeclaration.VertexDeclarationRHI;
+                GraphicsPSOInit.BoundShaderState.VertexShaderRHI = GETSAFERHISHADER_VERTEX(*VertexShader);
+                GraphicsPSOInit.BoundShaderState.PixelShaderRHI = GETSAFERHISHADER_PIXEL(*PixelShader);
+                GraphicsPSOInit.PrimitiveType = PT_TriangleList;
+                SetGraphicsPipelineState(RHICmdList, GraphicsPSOInit);
+
+                RHICmdList.SetViewport(0, 0, 0.f, PassDimension.X, PassDimension.Y, 1.f);
+
+                PixelShader->SetParameters(RHICmdList, PassSourceRHI, TexelStep, Taps, NumTaps);
+
+                RHICmdList.DrawPrimitive(0, 1, 1);
+                RHICmdList.EndRenderPass();
+            };
+
+            // Horizontal pass to scratch target, resolved before being
+            // sampled by the vertical pass
+
+            DrawPass(SourceRHI, ScratchRHI, ScratchDimension, FVector2D(1.f / FMath::Max(1, SourceDimension.X), 0.f));
+            RHICmdList.CopyToResolveTarget(ScratchRHI, ScratchRHI, FResolveParams());
+
+            DrawPass(ScratchRHI, TargetRHI, TargetDimension, FVector2D(0.f, 1.f / FMath::Max(1, ScratchDimension.Y)));
+        } );
+}
+
+void FSUGGraphRenderUtils::DrawPyramidBlurPass(UTexture* SourceTexture, UTextureRenderTarget2D* TargetTexture, bool bUpsample)
+{
+    if (! IsValid(SourceTexture) || ! IsValid(TargetTexture))
+    {
+        return;
+    }
+
+    FTextureResource* SourceResource = SourceTexture->Resource;
+    FTextureRenderTargetResource* TargetResource = TargetTexture->GameThread_GetRenderTargetResource();
+
+    if (! SourceResource || ! TargetResource)
+    {
+        return;
+    }
+
+    const FIntPoint SourceDimension(SourceResource->GetSizeX(), SourceResource->GetSizeY());
+    const FIntPoint TargetDimension(TargetTexture->SizeX, TargetTexture->SizeY);
+
+    ENQUEUE_RENDER_COMMAND(SUGGraphRenderUtils_DrawPyramidBlurPass)(
+        [SourceResource, TargetResource, SourceDimension, TargetDimension, bUpsample](FRHICommandListImmediate& RHICmdList)
+        {
+            FTextureRHIParamRef SourceRHI = SourceResource->TextureRHI;
+            FTextureRHIParamRef TargetRHI = TargetResource->GetRenderTargetTexture();
+
+            if (! SourceRHI || ! TargetRHI)
+            {
+                return;
+            }
+
+            FSUGGraphPyramidBlurPS::FPermutationDomain PermutationVector;
+            PermutationVector.Set<FSUGGraphPyramidBlurPS::FUpsample>(bUpsample);
+
+            TShaderMap<FGlobalShaderType>* ShaderMap = GetGlobalShaderMap(GMaxRHIFeatureLevel);
+            TShaderMapRef<FSUGGraphScreenVS> VertexShader(ShaderMap);
+            TShaderMapRef<FSUGGraphPyramidBlurPS> PixelShader(ShaderMap, PermutationVector);
+
+            FRHIRenderPassInfo RenderPassInfo(TargetRHI, ERenderTargetActions::DontLoad_Store);
+            RHICmdList.BeginRenderPass(RenderPassInfo, TEXT("SUGGraphPyramidBlur"));
+
+            FGraphicsPipelineStateInitializer GraphicsPSOInit;
+            RHICmdList.ApplyCachedRenderTargets(GraphicsPSOInit);
+            GraphicsPSOInit.BlendState = TStaticBlendState<>::GetRHI();
+            GraphicsPSOInit.RasterizerState = TStaticRasterizerState<>::GetRHI();
+            GraphicsPSOInit.DepthStencilState = TStaticDepthStencilState<false, CF_Always>::GetRHI();
+            GraphicsPSOInit.BoundShaderState.VertexDeclarationRHI = GEmptyVertexDeclaration.VertexDeclarationRHI;
+            GraphicsPSOInit.BoundShaderState.VertexShaderRHI = GETSAFERHISHADER_VERTEX(*VertexShader);
+            GraphicsPSOInit.BoundShaderState.PixelShaderRHI = GETSAFERHISHADER_PIXEL(*PixelShader);
+            GraphicsPSOInit.PrimitiveType = PT_TriangleList;
+            SetGraphicsPipelineState(RHICmdList, GraphicsPSOInit);
+
+            RHICmdList.SetViewport(0, 0, 0.f, TargetDimension.X, TargetDimension.Y, 1.f);
+
+            const FVector2D SourceTexelSize(
+                1.f / FMath::Max(1, SourceDimension.X),
+                1.f / FMath::Max(1, SourceDimension.Y)
+                );
+
+            PixelShader->SetParameters(RHICmdList, SourceRHI, SourceTexelSize);
+
+            RHICmdList.DrawPrimitive(0, 1, 1);
+            RHICmdList.EndRenderPass();
+        } );
+}
+
+void FSUGGraphRenderUtils::DrawJumpFlood(
+    const FSUGGraphJumpFloodParameters& Parameters,
+    UTexture* SourceTexture,
+    UTextureRenderTarget2D* FloodTexture0,
+    UTextureRenderTarget2D* FloodTexture1,
+    UTextureRenderTarget2D* TargetTexture
+    )
+{
+    if (! IsValid(SourceTexture) ||
+        ! IsValid(FloodTexture0) ||
+        ! IsValid(FloodTexture1) ||
+        ! IsValid(TargetTexture))
+    {
+        return;
+    }
+
+    FTextureResource* SourceResource = SourceTexture->Resource;
+    FTextureRenderTargetResource* FloodResource0 = FloodTexture0->GameThread_GetRenderTargetResource();
+    FTextureRenderTargetResource* FloodResource1 = FloodTexture1->GameThread_GetRenderTargetResource();
+    FTextureRenderTargetResource* TargetResource = TargetTexture->GameThread_GetRenderTargetResource();
+
+    if (! SourceResource || ! FloodResource0 || ! FloodResource1 || ! TargetResource)
+    {
+        return;
+    }
+
+    const FIntPoint Dimension(TargetTexture->SizeX, TargetTexture->SizeY);
+
+    // Flood step sizes halve from half the flood range down to a single
+    // pixel, log2 of the range in passes
+
+    int32 FloodRange = FMath::RoundUpToPowerOfTwo(FMath::Max(Dimension.X, Dimension.Y));
+
+    if (Parameters.MaxDistance > 0.f)
+    {
+        FloodRange = FMath::Min(FloodRange, (int32) FMath::RoundUpToPowerOfTwo(FMath::CeilToInt(Parameters.MaxDistance)+1));
+    }
+
+    TArray<int32, TInlineAllocator<16>> StepSizes;
+
+    for (int32 Step=FloodRange/2; Step>=1; Step/=2)
+    {
+        StepSizes.Emplace(Step);
+    }
+
+    if (Parameters.bExtraPass || StepSizes.Num() == 0)
+    {
+        StepSizes.Emplace(1);
+    }
+
+    const FSUGGraphJumpFloodParameters DrawParameters(Parameters);
+
+    ENQUEUE_RENDER_COMMAND(SUGGraphRenderUtils_DrawJumpFlood)(
+        [SourceResource, FloodResource0, FloodResource1, TargetResource, DrawParameters, StepSizes, Dimension](FRHICommandListImmediate& RHICmdList)
+        {
+            FTextureRHIParamRef SourceRHI = SourceResource->TextureRHI;
+            FTextureRHIParamRef FloodRHIs[2] = {
+                FloodResource0->GetRenderTargetTexture(),
+                FloodResource1->GetRenderTargetTexture()
+                };
+            FTextureRHIParamRef TargetRHI = TargetResource->GetRenderTargetTexture();
+
+            if (! SourceRHI || ! FloodRHIs[0] || ! FloodRHIs[1] || ! TargetRHI)
+            {
+                return;
+            }
+
+            typedef FSUGGraphJumpFloodPS FShader;
+
+            TShaderMap<FGlobalShaderType>* ShaderMap = GetGlobalShaderMap(GMaxRHIFeatureLevel);
+            TShaderMapRef<FSUGGraphScreenVS> VertexShader(ShaderMap);
+
+            auto DrawPass = [&](FShader::EPassType PassType, FTextureRHIParamRef FloodRHI, FTextureRHIParamRef PassTargetRHI, int32 StepSize)
+            {
+                FShader::FPermutationDomain PermutationVector;
+                PermutationVector.Set<FShader::FPassType>(PassType);
+
+                TShaderMapRef<FShader> PixelShader(ShaderMap, PermutationVector);
+
+                FRHIRenderPassInfo RenderPassInfo(PassTargetRHI, ERenderTargetActions::DontLoad_Store);
+                RHICmdList.BeginRenderPass(RenderPassInfo, TEXT("SUGGraphJumpFlood"));
+
+                FGraphicsPipelineStateInitializer GraphicsPSOInit;
+                RHICmdList.ApplyCachedRenderTargets(GraphicsPSOInit);
+                GraphicsPSOInit.BlendState = TStaticBlendState<>::GetRHI();
+                GraphicsPSOInit.RasterizerState = TStaticRasterizerState<>::GetRHI();
+                GraphicsPSOInit.DepthStencilState = TStaticDepthStencilState<false, CF_Always>::GetRHI();
+                GraphicsPSOInit.BoundShaderState.VertexDeclarationRHI = GEmptyVertexDeclaration.VertexDeclarationRHI;
+                GraphicsPSOInit.BoundShaderState.VertexShaderRHI = GETSAFERHISHADER_VERTEX(*VertexShader);
+                GraphicsPSOInit.BoundShaderState.PixelShaderRHI = GETSAFERHISHADER_PIXEL(*PixelShader);
+                GraphicsPSOInit.PrimitiveType = PT_TriangleList;
+                SetGraphicsPipelineState(RHICmdList, GraphicsPSOInit);
+
+                RHICmdList.SetViewport(0, 0, 0.f, Dimension.X, Dimension.Y, 1.f);
+
+                PixelShader->SetParameters(
+                    RHICmdList,
+                    SourceRHI,
+                    FloodRHI,
+                    DrawParameters.SeedThreshold,
+                    StepSize,
+                    DrawParameters.MaxDistance
+                    );
+
+                RHICmdList.DrawPrimitive(0, 1, 1);
+                RHICmdList.EndRenderPass();
+                RHICmdList.CopyToResolveTarget(PassTargetRHI, PassTargetRHI, FResolveParams());
+            };
+
+            // Seed pass, flood passes ping-pong between flood targets
+
+            int32 FloodIndex = 0;
+
+            DrawPass(FShader::PassSeed, GBlackTexture->TextureRHI, FloodRHIs[FloodIndex], 0);
+
+            for (int32 StepSize : StepSizes)
+            {
+                DrawPass(FShader::PassFlood, FloodRHIs[FloodIndex], FloodRHIs[1-FloodIndex], StepSize);
+                FloodIndex = 1-FloodIndex;
+            }
+
+            DrawPass(FShader::PassResolve, FloodRHIs[FloodIndex], TargetRHI, 0);
+        } );
+}
+
+void FSUGGraphRenderUtils::GetRangeReductionLevels(const FIntPoint& SourceDimension, TArray<FIntPoint>& OutDimensions)
+{
+    const int32 ReductionSize = FSUGGraphAutoLevelPS::ReductionSize;
+
+    OutDimensions.Reset();
+
+    FIntPoint Dimension(
+        FMath::Max(1, SourceDimension.X),
+        FMath::Max(1, SourceDimension.Y)
+        );
+
+    do
+    {
+        Dimension.X = FMath::DivideAndRoundUp(Dimension.X, ReductionSize);
+        Dimension.Y = FMath::DivideAndRoundUp(Dimension.Y, ReductionSize);
+        OutDimensions.Emplace(Dimension);
+    }
+    while (Dimension.X > 1 || Dimension.Y > 1);
+}
+
+void FSUGGraphRenderUtils::DrawAutoLevel(
+    UTexture* SourceTexture,
+    const TArray<UTextureRenderTarget2D*>& ReductionTextures,
+    UTextureRenderTarget2D* TargetTexture,
+    bool bApplyLevelMin,
+    bool bApplyLevelMax
+    )
+{
+    if (! IsValid(SourceTexture) || ! IsValid(TargetTexture) || ReductionTextures.Num() == 0)
+    {
+        return;
+    }
+
+    FTextureResource* SourceResource = SourceTexture->Resource;
+    FTextureRenderTargetResource* TargetResource = TargetTexture->GameThread_GetRenderTargetResource();
+
+    TArray<FTextureRenderTargetResource*, TInlineAllocator<16>> ReductionResources;
+    TArray<FIntPoint, TInlineAllocator<16>> ReductionDimensions;
+
+    for (UTextureRenderTarget2D* ReductionTexture : ReductionTextures)
+    {
+        FTextureRenderTargetResource* ReductionResource = IsValid(ReductionTexture)
+            ? ReductionTexture->GameThread_GetRenderTargetResource()
+            : nullptr;
+
+        if (! ReductionResource)
+        {
+            return;
+        }
+
+        ReductionResources.Emplace(ReductionResource);
+        ReductionDimensions.Emplace(ReductionTexture->SizeX, ReductionTexture->SizeY);
+    }
+
+    if (! SourceResource || ! TargetResource)
+    {
+        return;
+    }
+
+    const FIntPoint Dimension(TargetTexture->SizeX, TargetTexture->SizeY);
+    const FVector2D LevelMask(bApplyLevelMin ? 1.f : 0.f, bApplyLevelMax ? 1.f : 0.f);
+
+    ENQUEUE_RENDER_COMMAND(SUGGraphRenderUtils_DrawAutoLevel)(
+        [SourceResource, ReductionResources, ReductionDimensions, TargetResource, Dimension, LevelMask](FRHICommandListImmediate& RHICmdList)
+        {
+            FTextureRHIParamRef SourceRHI = SourceResource->TextureRHI;
+            FTextureRHIParamRef TargetRHI = TargetResource->GetRenderTargetTexture();
+
+            if (! SourceRHI || ! TargetRHI)
+            {
+                return;
+            }
+
+            typedef FSUGGraphAutoLevelPS FShader;
+
+            TShaderMap<FGlobalShaderType>* ShaderMap = GetGlobalShaderMap(GMaxRHIFeatureLevel);
+            TShaderMapRef<FSUGGraphScreenVS> VertexShader(ShaderMap);
+
+            auto DrawPass = [&](FShader::EPassType PassType, FTextureRHIParamRef RangeRHI, FTextureRHIParamRef PassTargetRHI, const FIntPoint& PassDimension)
+            {
+                FShader::FPermutationDomain PermutationVector;
+                PermutationVector.Set<FShader::FPassType>(PassType);
+
+                TShaderMapRef<FShader> PixelShader(ShaderMap, PermutationVector);
+
+                FRHIRenderPassInfo RenderPassInfo(PassTargetRHI, ERenderTargetActions::DontLoad_Store);
+                RHICmdList.BeginRenderPass(RenderPassInfo, TEXT("SUGGraphAutoLevel"));
+
+                FGraphicsPipelineStateInitializer GraphicsPSOInit;
+                RHICmdList.ApplyCachedRenderTargets(GraphicsPSOInit);
+                GraphicsPSOInit.BlendState = TStaticBlendState<>::GetRHI();
+                GraphicsPSOInit.RasterizerState = TStaticRasterizerState<>::GetRHI();
+                GraphicsPSOInit.DepthStencilState = TStaticDepthStencilState<false, CF_Always>::GetRHI();
+                GraphicsPSOInit.BoundShaderState.VertexDeclarationRHI = GEmptyVertexDeclaration.VertexDeclarationRHI;
+                GraphicsPSOInit.BoundShaderState.VertexShaderRHI = GETSAFERHISHADER_VERTEX(*VertexShader);
+                GraphicsPSOInit.BoundShaderState.PixelShaderRHI = GETSAFERHISHADER_PIXEL(*PixelShader);
+                GraphicsPSOInit.PrimitiveType = PT_TriangleList;
+                SetGraphicsPipelineState(RHICmdList, GraphicsPSOInit);
+
+                RHICmdList.SetViewport(0, 0, 0.f, PassDimension.X, PassDimension.Y, 1.f);
+
+                PixelShader->SetParameters(RHICmdList, SourceRHI, RangeRHI, LevelMask);
+
+                RHICmdList.DrawPrimitive(0, 1, 1);
+                RHICmdList.EndRenderPass();
+                RHICmdList.CopyToResolveTarget(PassTargetRHI, PassTargetRHI, FResolveParams());
+            };
+
+            // Reduce source to the first reduction level, then every level
+            // to the next until a single texel remains
+
+            FTextureRHIParamRef RangeRHI = GBlackTexture->TextureRHI;
+
+            for (int32 i=0; i<ReductionResources.Num(); ++i)
+            {
+                FTextureRHIParamRef ReductionRHI = ReductionResources[i]->GetRenderTargetTexture();
+
+                if (! ReductionRHI)
+                {
+                    return;
+                }
+
+                DrawPass(
+                    (i == 0) ? FShader::PassReduceSource : FShader::PassReduceRange,
+                    RangeRHI,
+                    ReductionRHI,
+                    ReductionDimensions[i]
+                    );
+
+                RangeRHI = ReductionRHI;
+            }
+
+            DrawPass(FShader::PassApply, RangeRHI, TargetRHI, Dimension);
+        } );
+}
+
+FSUGGraphDifferenceReadback::~FSUGGraphDifferenceReadback()
+{
+}
+
+bool FSUGGraphRenderUtils::EnqueueMaxDifference(
+    UTexture* SourceTextureA,
+    UTexture* SourceTextureB,
+    const TArray<UTextureRenderTarget2D*>& ReductionTextures,
+    const FSUGGraphDifferenceReadbackRef& Readback
+    )
+{
+    if (Readback->bPending ||
+        ! IsValid(SourceTextureA) ||
+        ! IsValid(SourceTextureB) ||
+        ReductionTextures.Num() == 0)
+    {
+        return false;
+    }
+
+    FTextureResource* SourceResourceA = SourceTextureA->Resource;
+    FTextureResource* SourceResourceB = SourceTextureB->Resource;
+
+    TArray<FTextureRenderTargetResource*, TInlineAllocator<16>> ReductionResources;
+    TArray<FIntPoint, TInlineAllocator<16>> ReductionDimensions;
+
+    for (UTextureRenderTarget2D* ReductionTexture : ReductionTextures)
+    {
+        FTextureRenderTargetResource* ReductionResource = IsValid(ReductionTexture)
+            ? ReductionTexture->GameThread_GetRenderTargetResource()
+            : nullptr;
+
+        if (! ReductionResource)
+        {
+            return false;
+        }
+
+        ReductionResources.Emplace(ReductionResource);
+        ReductionDimensions.Emplace(ReductionTexture->SizeX, ReductionTexture->SizeY);
+    }
+
+    if (! SourceResourceA || ! SourceResourceB)
+    {
+        return false;
+    }
+
+    Readback->bPending = true;
+    Readback->bResultReady = false;
+
+    ENQUEUE_RENDER_COMMAND(SUGGraphRenderUtils_EnqueueMaxDifference)(
+        [SourceResourceA, SourceResourceB, ReductionResources, ReductionDimensions, Readback](FRHICommandListImmediate& RHICmdList)
+        {
+            FTextureRHIParamRef SourceRHIA = SourceResourceA->TextureRHI;
+            FTextureRHIParamRef SourceRHIB = SourceResourceB->TextureRHI;
+
+            if (! SourceRHIA || ! SourceRHIB)
+            {
+                Readback->MaxDifference = TNumericLimits<float>::Max();
+                Readback->bResultReady = true;
+                return;
+            }
+
+            typedef FSUGGraphDifferenceReductionPS FShader;
+
+            TShaderMap<FGlobalShaderType>* ShaderMap = GetGlobalShaderMap(GMaxRHIFeatureLevel);
+            TShaderMapRef<FSUGGraphScreenVS> VertexShader(ShaderMap);
+
+            FTextureRHIParamRef ReductionRHI = GBlackTexture->TextureRHI;
+
+            for (int32 i=0; i<ReductionResources.Num(); ++i)
+            {
+                FTextureRHIParamRef LevelRHI = ReductionResources[i]->GetRenderTargetTexture();
+
+                if (! LevelRHI)
+                {
+                    Readback->MaxDifference = TNumericLimits<float>::Max();
+                    Readback->bResultReady = true;
+                    return;
+                }
+
+                FShader::FPermutationDomain PermutationVector;
+                PermutationVector.Set<FShader::FPassType>((i == 0) ? FShader::PassReduceSource : FShader::PassReduceMax);
+
+                TShaderMapRef<FShader> PixelShader(ShaderMap, PermutationVector);
+
+                FRHIRenderPassInfo RenderPassInfo(LevelRHI, ERenderTargetActions::DontLoad_Store);
+                RHICmdList.BeginRenderPass(RenderPassInfo, TEXT("SUGGraphDifferenceReduction"));
+
+                FGraphicsPipelineStateInitializer GraphicsPSOInit;
+                RHICmdList.ApplyCachedRenderTargets(GraphicsPSOInit);
+                GraphicsPSOInit.BlendState = TStaticBlendState<>::GetRHI();
+                GraphicsPSOInit.RasterizerState = TStaticRasterizerState<>::GetRHI();
+                GraphicsPSOInit.DepthStencilState = TStaticDepthStencilState<false, CF_Always>::GetRHI();
+                GraphicsPSOInit.BoundShaderState.VertexDeclarationRHI = GEmptyVertexDeclaration.VertexDeclarationRHI;
+                GraphicsPSOInit.BoundShaderState.VertexShaderRHI = GETSAFERHISHADER_VERTEX(*VertexShader);
+                GraphicsPSOInit.BoundShaderState.PixelShaderRHI = GETSAFERHISHADER_PIXEL(*PixelShader);
+                GraphicsPSOInit.PrimitiveType = PT_TriangleList;
+                SetGraphicsPipelineState(RHICmdList, GraphicsPSOInit);
+
+                RHICmdList.SetViewport(0, 0, 0.f, ReductionDimensions[i].X, ReductionDimensions[i].Y, 1.f);
+
+                PixelShader->SetParameters(RHICmdList, SourceRHIA, SourceRHIB, ReductionRHI);
+
+                RHICmdList.DrawPrimitive(0, 1, 1);
+                RHICmdList.EndRenderPass();
+                RHICmdList.CopyToResolveTarget(LevelRHI, LevelRHI, FResolveParams());
+
+                ReductionRHI = LevelRHI;
+            }
+
+            // Copy the single texel of the last reduction level to the
+            // staging read back, mapped once the result is read
+
+            if (! Readback->Readback.IsValid())
+            {
+                Readback->Readback = MakeUnique<FRHIGPUTextureReadback>(TEXT("SUGGraphDifferenceReadback"));
+            }
+
+            Readback->Readback->EnqueueCopy(RHICmdList, ReductionRHI, FResolveRect(0, 0, 1, 1));
+            Readback->bCopyPending = true;
+        } );
+
+    return true;
+}
+
+bool FSUGGraphRenderUtils::ReadMaxDifference(const FSUGGraphDifferenceReadbackRef& Readback, float& OutMaxDifference)
+{
+    if (! Readback->bPending)
+    {
+        return false;
+    }
+
+    ENQUEUE_RENDER_COMMAND(SUGGraphRenderUtils_ReadMaxDifference)(
+        [Readback](FRHICommandListImmediate& RHICmdList)
+        {
+            // Failed reductions have already assigned their result
+            if (! Readback->bCopyPending)
+            {
+                return;
+            }
+
+            // Wait for the reduction and staging copy to complete
+            RHICmdList.BlockUntilGPUIdle();
+
+            // Last reduction level is a full precision float texture
+            const float* Texel = static_cast<const float*>(Readback->Readback->Lock(sizeof(FLinearColor)));
+
+            Readback->MaxDifference = Texel ? Texel[0] : TNumericLimits<float>::Max();
+            Readback->Readback->Unlock();
+            Readback->bCopyPending = false;
+            Readback->bResultReady = true;
+        } );
+
+    FlushRenderingCommands();
+
+    OutMaxDifference = Readback->bResultReady
+        ? Readback->MaxDifference
+        : TNumericLimits<float>::Max();
+
+    Readback->bPending = false;
+    Readback->bResultReady = false;
+
+    return true;
+}
+
+void FSUGGraphRenderUtils::DrawHydraulicErosion(
+    const FSUGGraphHydraulicErosionParameters& Parameters,
+    UTexture* SourceTexture,
+    UTextureRenderTarget2D* TerrainTexture0,
+    UTextureRenderTarget2D* TerrainTexture1,
+    UTextureRenderTarget2D* FluxTexture0,
+    UTextureRenderTarget2D* FluxTexture1,
+    int32 StepCount,
+    UTextureRenderTarget2D* TargetTexture
+    )
+{
+    if (! IsValid(TerrainTexture0) ||
+        ! IsValid(TerrainTexture1) ||
+        ! IsValid(FluxTexture0) ||
+        ! IsValid(FluxTexture1) ||
+        ! IsValid(TargetTexture))
+    {
+        return;
+    }
+
+    FTextureResource* SourceResource = IsValid(SourceTexture) ? SourceTexture->Resource : nullptr;
+    FTextureRenderTargetResource* TerrainResource0 = TerrainTexture0->GameThread_GetRenderTargetResource();
+    FTextureRenderTargetResource* TerrainResource1 = TerrainTexture1->GameThread_GetRenderTargetResource();
+    FTextureRenderTargetResource* FluxResource0 = FluxTexture0->GameThread_GetRenderTargetResource();
+    FTextureRenderTargetResource* FluxResource1 = FluxTexture1->GameThread_GetRenderTargetResource();
+    FTextureRenderTargetResource* TargetResource = TargetTexture->GameThread_GetRenderTargetResource();
+
+    if (! TerrainResource0 || ! TerrainResource1 || ! FluxResource0 || ! FluxResource1 || ! TargetResource)
+    {
+        return;
+    }
+
+    const FIntPoint StateDimension(TerrainTexture0->SizeX, TerrainTexture0->SizeY);
+    const FIntPoint TargetDimension(TargetTexture->SizeX, TargetTexture->SizeY);
+    const bool bInitializeState = SourceResource != nullptr;
+
+    const FVector4 SimulationParams(
+        Parameters.TimeStep,
+        FMath::Max(Parameters.CellSize, KINDA_SMALL_NUMBER),
+        Parameters.Gravity,
+        Parameters.RainRate
+        );
+
+    const FVector4 ErosionParams(
+        Parameters.SedimentCapacity,
+        Parameters.DissolvingRate,
+        Parameters.DepositionRate,
+        Parameters.EvaporationRate
+        );
+
+    const FVector4 ErosionParams2(Parameters.MinimumTilt, 0.f, 0.f, 0.f);
+
+    ENQUEUE_RENDER_COMMAND(SUGGraphRenderUtils_DrawHydraulicErosion)(
+        [SourceResource, TerrainResource0, TerrainResource1, FluxResource0, FluxResource1, TargetResource, StateDimension, TargetDimension, bInitializeState, StepCount, SimulationParams, ErosionParams, ErosionParams2](FRHICommandListImmediate& RHICmdList)
+        {
+            FTextureRHIParamRef TerrainRHIs[2] = {
+                TerrainResource0->GetRenderTargetTexture(),
+                TerrainResource1->GetRenderTargetTexture()
+                };
+            FTextureRHIParamRef FluxRHIs[2] = {
+                FluxResource0->GetRenderTargetTexture(),
+                FluxResource1->GetRenderTargetTexture()
+                };
+            FTextureRHIParamRef TargetRHI = TargetResource->GetRenderTargetTexture();
+
+            if (! TerrainRHIs[0] || ! TerrainRHIs[1] || ! FluxRHIs[0] || ! FluxRHIs[1] || ! TargetRHI)
+            {
+                return;
+            }
+
+            FTextureRHIParamRef SourceRHI = SourceResource
+                ? SourceResource->TextureRHI.GetReference()
+                : GBlackTexture->TextureRHI.GetReference();
+
+            if (! SourceRHI)
+            {
+                return;
+            }
+
+            typedef FSUGGraphHydraulicErosionPS FShader;
+
+            TShaderMap<FGlobalShaderType>* ShaderMap = GetGlobalShaderMap(GMaxRHIFeatureLevel);
+            TShaderMapRef<FSUGGraphScreenVS> VertexShader(ShaderMap);
+
+            auto DrawPass = [&](FShader::EPassType PassType, FTextureRHIParamRef TerrainRHI, FTextureRHIParamRef FluxRHI, FTextureRHIParamRef PassTargetRHI, const FIntPoint& PassDimension)
+            {
+                FShader::FPermutationDomain PermutationVector;
+                PermutationVector.Set<FShader::FPassType>(PassType);
+
+                TShaderMapRef<FShader> PixelShader(ShaderMap, PermutationVector);
+
+                FRHIRenderPassInfo RenderPassInfo(PassTargetRHI, ERenderTargetActions::DontLoad_Store);
+                RHICmdList.BeginRenderPass(RenderPassInfo, TEXT("SUGGraphHydraulicErosion"));
+
+                FGraphicsPipelineStateInitializer GraphicsPSOInit;
+                RHICmdList.ApplyCachedRenderTargets(GraphicsPSOInit);
+                GraphicsPSOInit.BlendState = TStaticBlendState<>::GetRHI();
+                GraphicsPSOInit.RasterizerState = TStaticRasterizerState<>::GetRHI();
+                GraphicsPSOInit.DepthStencilState = TStaticDepthStencilState<false, CF_Always>::GetRHI();
+                GraphicsPSOInit.BoundShaderState.VertexDeclarationRHI = GEmptyVertexDeclaration.VertexDeclarationRHI;
+                GraphicsPSOInit.BoundShaderState.VertexShaderRHI = GETSAFERHISHADER_VERTEX(*VertexShader);
+                GraphicsPSOInit.BoundShaderState.PixelShaderRHI = GETSAFERHISHADER_PIXEL(*PixelShader);
+                GraphicsPSOInit.PrimitiveType = PT_TriangleList;
+                SetGraphicsPipelineState(RHICmdList, GraphicsPSOInit);
+
+                RHICmdList.SetViewport(0, 0, 0.f, PassDimension.X, PassDimension.Y, 1.f);
+
+                PixelShader->SetParameters(
+                    RHICmdList,
+                    SourceRHI,
+                    TerrainRHI,
+                    FluxRHI,
+                    SimulationParams,
+                    ErosionParams,
+                    ErosionParams2
+                    );
+
+                RHICmdList.DrawPrimitive(0, 1, 1);
+                RHICmdList.EndRenderPass();
+                RHICmdList.CopyToResolveTarget(PassTargetRHI, PassTargetRHI, FResolveParams());
+            };
+
+            FTextureRHIParamRef BlackRHI = GBlackTexture->TextureRHI;
+
+            if (bInitializeState)
+            {
+                DrawPass(FShader::PassInitTerrain, BlackRHI, BlackRHI, TerrainRHIs[0], StateDimension);
+                DrawPass(FShader::PassInitFlux, BlackRHI, BlackRHI, FluxRHIs[0], StateDimension);
+            }
+
+            // Each step updates flux to the other flux target, then updates
+            // terrain through the second terrain target and back
+
+            int32 FluxIndex = 0;
+
+            for (int32 Step=0; Step<StepCount; ++Step)
+            {
+                DrawPass(FShader::PassFlux, TerrainRHIs[0], FluxRHIs[FluxIndex], FluxRHIs[1-FluxIndex], StateDimension);
+                FluxIndex = 1-FluxIndex;
+
+                DrawPass(FShader::PassErosion, TerrainRHIs[0], FluxRHIs[FluxIndex], TerrainRHIs[1], StateDimension);
+                DrawPass(FShader::PassTransport, TerrainRHIs[1], FluxRHIs[FluxIndex], TerrainRHIs[0], StateDimension);
+            }
+
+            DrawPass(FShader::PassResolve, TerrainRHIs[0], BlackRHI, TargetRHI, TargetDimension);
+        } );
+}
+
+void FSUGGraphRenderUtils::DrawBoxFilter(
+    const FSUGGraphBoxFilterParameters& Parameters,
+    UTexture* SummedAreaTexture,
+    UTexture* RadiusTexture,
+    UTextureRenderTarget2D* TargetTexture
+    )
+{
+    if (! IsValid(SummedAreaTexture) || ! IsValid(TargetTexture))
+    {
+        return;
+    }
+
+    FTextureResource* SummedAreaResource = SummedAreaTexture->Resource;
+    FTextureResource* RadiusResource = IsValid(RadiusTexture) ? RadiusTexture->Resource : nullptr;
+    FTextureRenderTargetResource* TargetResource = TargetTexture->GameThread_GetRenderTargetResource();
+
+    if (! SummedAreaResource || ! TargetResource)
+    {
+        return;
+    }
+
+    const FIntPoint Dimension(TargetTexture->SizeX, TargetTexture->SizeY);
+    const FVector4 BoxParams(
+        FMath::Max(0.f, Parameters.Radius),
+        RadiusResource ? 1.f : 0.f,
+        Parameters.ValueOffset,
+        Parameters.bTableMean ? 1.f : 0.f
+        );
+
+    ENQUEUE_RENDER_COMMAND(SUGGraphRenderUtils_DrawBoxFilter)(
+        [SummedAreaResource, RadiusResource, TargetResource, Dimension, BoxParams](FRHICommandListImmediate& RHICmdList)
+        {
+            FTextureRHIParamRef SummedAreaRHI = SummedAreaResource->TextureRHI;
+            FTextureRHIParamRef TargetRHI = TargetResource->GetRenderTargetTexture();
+
+            if (! SummedAreaRHI || ! TargetRHI)
+            {
+                return;
+            }
+
+            FTextureRHIParamRef RadiusRHI = RadiusResource
+                ? RadiusResource->TextureRHI.GetReference()
+                : GWhiteTexture->TextureRHI.GetReference();
+
+            TShaderMap<FGlobalShaderType>* ShaderMap = GetGlobalShaderMap(GMaxRHIFeatureLevel);
+            TShaderMapRef<FSUGGraphScreenVS> VertexShader(ShaderMap);
+            TShaderMapRef<FSUGGraphBoxFilterPS> PixelShader(ShaderMap);
+
+            FRHIRenderPassInfo RenderPassInfo(TargetRHI, ERenderTargetActions::DontLoad_Store);
+            RHICmdList.BeginRenderPass(RenderPassInfo, TEXT("SUGGraphBoxFilter"));
+
+            FGraphicsPipelineStateInitializer GraphicsPSOInit;
+            RHICmdList.ApplyCachedRenderTargets(GraphicsPSOInit);
+            GraphicsPSOInit.BlendState = TStaticBlendState<>::GetRHI();
+            GraphicsPSOInit.RasterizerState = TStaticRasterizerState<>::GetRHI();
+            GraphicsPSOInit.DepthStencilState = TStaticDepthStencilState<false, CF_Always>::GetRHI();
+            GraphicsPSOInit.BoundShaderState.VertexDeclarationRHI = GEmptyVertexDeclaration.VertexDeclarationRHI;
+            GraphicsPSOInit.BoundShaderState.VertexShaderRHI = GETSAFERHISHADER_VERTEX(*VertexShader);
+            GraphicsPSOInit.BoundShaderState.PixelShaderRHI = GETSAFERHISHADER_PIXEL(*PixelShader);
+            GraphicsPSOInit.PrimitiveType = PT_TriangleList;
+            SetGraphicsPipelineState(RHICmdList, GraphicsPSOInit);
+
+            RHICmdList.SetViewport(0, 0, 0.f, Dimension.X, Dimension.Y, 1.f);
+
+            PixelShader->SetParameters(RHICmdList, SummedAreaRHI, RadiusRHI, BoxParams);
+
+            RHICmdList.DrawPrimitive(0, 1, 1);
+            RHICmdList.EndRenderPass();
+            RHICmdList.CopyToResolveTarget(TargetRHI, TargetRHI, FResolveParams());
+        } );
+}
@@ -0,0 +1,295 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SUGGraphTypes.h"
+
+class FRHIGPUTextureReadback;
+class UTexture;
+class UTextureRenderTarget2D;
+
+struct FSUGGraphBaseOpParameters
+{
+    TEnumAsByte<enum ESUGGraphBaseOpType> Operation = SUG_BOP_Levels;
+    UTexture* InputTextures[3] = { nullptr, nullptr, nullptr };
+
+    // (InRemapValueLo, InRemapValueHi, OutRemapValueLo, OutRemapValueHi)
+    FVector4 RemapParams = FVector4(0.f, 1.f, 0.f, 1.f);
+
+    // (LevelsLo, LevelsMi, LevelsHi, MidPoint)
+    FVector4 LevelsParams = FVector4(0.f, .5f, 1.f, .5f);
+
+    float Opacity = 1.f;
+
+    // Levels input remap range texture, (InRemapValueLo, InRemapValueHi) are
+    // read from the first texel and override remap parameters if specified
+    UTexture* RangeTexture = nullptr;
+};
+
+// Chain of pointwise base operations evaluated by a single draw, each stage
+// reads the result of the previous stage instead of an intermediate target
+struct FSUGGraphFusedOpParameters
+{
+    // Must match the fused operation shader limits
+    enum
+    {
+        MaxStages = 4,
+        MaxInputs = 9
+    };
+
+    // Stage input slot referring to the previous stage result
+    enum
+    {
+        ChainSlot = -1,
+        DefaultSlot = -2
+    };
+
+    struct FStage
+    {
+        FSUGGraphBaseOpParameters Parameters;
+        int32 InputSlots[3] = { DefaultSlot, DefaultSlot, DefaultSlot };
+    };
+
+    TArray<FStage, TInlineAllocator<MaxStages>> Stages;
+    TArray<UTexture*, TInlineAllocator<MaxInputs>> InputTextures;
+
+    // Add operation as the next stage, the input at ChainInputIndex reads the
+    // previous stage result
+    bool AddStage(const FSUGGraphBaseOpParameters& Parameters, int32 ChainInputIndex = INDEX_NONE);
+    int32 AddInput(UTexture* InputTexture);
+
+    FORCEINLINE bool HasStages() const
+    {
+        return Stages.Num() > 0;
+    }
+
+    FORCEINLINE void Reset()
+    {
+        Stages.Reset();
+        InputTextures.Reset();
+    }
+};
+
+// Separable gaussian blur kernel, adjacent texel pairs are merged into single
+// linear sampled taps
+struct FSUGGraphGaussianBlurParameters
+{
+    // Must match the gaussian blur shader tap limit
+    enum
+    {
+        MaxTaps = 65,
+        MaxRadius = MaxTaps-1,
+
+        // Largest blur radius of the blurred level of pyramid blurs
+        PyramidLevelRadius = 16
+    };
+
+    // Taps as (PixelOffset, Weight, 0, 0)
+    TArray<FVector4, TInlineAllocator<MaxTaps>> Taps;
+
+    // Build normalized taps of a gaussian kernel with the specified pixel
+    // radius, non-positive sigma is derived from the radius
+    void SetGaussianTaps(int32 Radius, float Sigma = 0.f);
+};
+
+struct FSUGGraphJumpFloodParameters
+{
+    // Source red channel value at or above which source texels are seeds
+    float SeedThreshold = .5f;
+
+    // Distance range in pixels, limits the flood pass count and normalizes
+    // output distances. Unlimited with distances written in pixels if not
+    // positive.
+    float MaxDistance = 0.f;
+
+    // Run an additional single pixel step pass to correct flood errors
+    bool bExtraPass = true;
+};
+
+struct FSUGGraphBoxFilterParameters
+{
+    // Box radius in summed area table texels, scaled per pixel by the red
+    // channel of the radius texture if specified
+    float Radius = 1.f;
+
+    // Offset subtracted from values summed into the summed area table
+    float ValueOffset = 0.f;
+
+    // Summed area table is centered on the source mean stored in its last
+    // texel, the value offset is ignored
+    bool bTableMean = false;
+};
+
+// Pipe model hydraulic erosion simulation step parameters. Heights and
+// water depths share the source height unit.
+struct FSUGGraphHydraulicErosionParameters
+{
+    float TimeStep = .02f;
+
+    // Horizontal size of a simulation cell in height units
+    float CellSize = 1.f / 512.f;
+
+    float Gravity = 9.81f;
+
+    // Water depth added per cell per unit time
+    float RainRate = .01f;
+
+    float SedimentCapacity = 1.f;
+    float DissolvingRate = .5f;
+    float DepositionRate = 1.f;
+    float EvaporationRate = .015f;
+
+    // Lower bound of the terrain tilt sine, keeps flat terrain eroding
+    float MinimumTilt = .05f;
+};
+
+// Asynchronous read back of difference reductions. Reduced differences are
+// copied to a staging texture and mapped by later polls once the GPU has
+// finished the copy, the game thread never waits for the GPU.
+struct FSUGGraphDifferenceReadback
+{
+    // Staging read back of the last reduction level, rendering thread only
+    TUniquePtr<FRHIGPUTextureReadback> Readback;
+
+    // Copy has been enqueued and not yet mapped, rendering thread only
+    bool bCopyPending = false;
+
+    // Reduction has been enqueued and its result not yet read, game thread
+    // only
+    bool bPending = false;
+
+    // Read back maximum difference, valid once the result is ready
+    float MaxDifference = TNumericLimits<float>::Max();
+    FThreadSafeBool bResultReady;
+
+    ~FSUGGraphDifferenceReadback();
+};
+
+typedef TSharedRef<FSUGGraphDifferenceReadback, ESPMode::ThreadSafe> FSUGGraphDifferenceReadbackRef;
+
+class FSUGGraphRenderUtils
+{
+public:
+
+    // Copy source texture region to the target render target at the
+    // specified position. Source and target must share the same pixel format.
+    static void CopyTextureRegion(
+        UTexture* SourceTexture,
+        UTextureRenderTarget2D* TargetTexture,
+        const FIntRect& SourceRect,
+        const FIntPoint& TargetPosition
+        );
+
+    // Draw base material library operation with its built-in global shader
+    static void DrawBaseOp(const FSUGGraphBaseOpParameters& Parameters, UTextureRenderTarget2D* TargetTexture);
+
+    // Draw fused base operation chain with a single full screen pass
+    static void DrawFusedOps(const FSUGGraphFusedOpParameters& Parameters, UTextureRenderTarget2D* TargetTexture);
+
+    // Draw horizontal blur pass of the source texture to the scratch render
+    // target followed by vertical blur pass to the target render target
+    static void DrawGaussianBlur(
+        const FSUGGraphGaussianBlurParameters& Parameters,
+        UTexture* SourceTexture,
+        UTextureRenderTarget2D* ScratchTexture,
+        UTextureRenderTarget2D* TargetTexture
+        );
+
+    // Draw dual filter downsample or upsample pass of the source texture to
+    // the target render target of the next blur pyramid level
+    static void DrawPyramidBlurPass(UTexture* SourceTexture, UTextureRenderTarget2D* TargetTexture, bool bUpsample);
+
+    // Dimension of every value range reduction level of the source
+    // dimension, ending with a single texel level
+    static void GetRangeReductionLevels(const FIntPoint& SourceDimension, TArray<FIntPoint>& OutDimensions);
+
+    // Reduce source value range to a single texel through the reduction
+    // level render targets and remap the source to the target using the
+    // reduced range without leaving the GPU
+    static void DrawAutoLevel(
+        UTexture* SourceTexture,
+        const TArray<UTextureRenderTarget2D*>& ReductionTextures,
+        UTextureRenderTarget2D* TargetTexture,
+        bool bApplyLevelMin,
+        bool bApplyLevelMax
+        );
+
+    // Reduce maximum absolute RGB difference of two equally sized textures
+    // to a single texel through the reduction level render targets and
+    // enqueue its read back. Returns false if the difference could not be
+    // evaluated or a read back has not been read yet.
+    static bool EnqueueMaxDifference(
+        UTexture* SourceTextureA,
+        UTexture* SourceTextureB,
+        const TArray<UTextureRenderTarget2D*>& ReductionTextures,
+        const FSUGGraphDifferenceReadbackRef& Readback
+        );
+
+    // Read the result of the enqueued difference reduction. Blocks until the
+    // GPU has finished the reduction. Returns false if no reduction has been
+    // enqueued.
+    static bool ReadMaxDifference(const FSUGGraphDifferenceReadbackRef& Readback, float& OutMaxDifference);
+
+    // Draw box filtered mean of the summed area table source to the target
+    // render target with a single lookup pass regardless of the radius
+    static void DrawBoxFilter(
+        const FSUGGraphBoxFilterParameters& Parameters,
+        UTexture* SummedAreaTexture,
+        UTexture* RadiusTexture,
+        UTextureRenderTarget2D* TargetTexture
+        );
+
+    // Step hydraulic erosion simulation state and draw the resulting
+    // height to the target render target. State is initialized from the
+    // source height if a source texture is specified. Terrain state is
+    // stored in the first terrain render target. Flux state is read from
+    // the first flux render target and left in the second one after an odd
+    // step count.
+    static void DrawHydraulicErosion(
+        const FSUGGraphHydraulicErosionParameters& Parameters,
+        UTexture* SourceTexture,
+        UTextureRenderTarget2D* TerrainTexture0,
+        UTextureRenderTarget2D* TerrainTexture1,
+        UTextureRenderTarget2D* FluxTexture0,
+        UTextureRenderTarget2D* FluxTexture1,
+        int32 StepCount,
+        UTextureRenderTarget2D* TargetTexture
+        );
+
+    // Draw jump flood distance transform of the source seed mask. Flood
+    // passes ping-pong between two RG32f render targets of the target size,
+    // the target receives (Distance, NearestSeedU, NearestSeedV, NearestSeedId).
+    static void DrawJumpFlood(
+        const FSUGGraphJumpFloodParameters& Parameters,
+        UTexture* SourceTexture,
+        UTextureRenderTarget2D* FloodTexture0,
+        UTextureRenderTarget2D* FloodTexture1,
+        UTextureRenderTarget2D* TargetTexture
+        );
+};
@@ -0,0 +1,235 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+#include "SUGGraphScheduler.h"
+#include "Engine/Engine.h"
+#include "GameFramework/PlayerController.h"
+#include "ShaderGraphPluginSettings.h"
+#include "SUGGraph.h"
+#include "SUGGraphManager.h"
+
+DECLARE_CYCLE_STAT(TEXT("Graph Scheduler Tick"), STAT_SUGGraphScheduler_Tick, STATGROUP_ShaderGraphPlugin);
+
+USUGGraphScheduler* USUGGraphScheduler::Get()
+{
+    return GEngine ? GEngine->GetEngineSubsystem<USUGGraphScheduler>() : nullptr;
+}
+
+void USUGGraphScheduler::RequestExecution(USUGGraphManager* GraphManager, USUGGraph* GraphInstance)
+{
+    if (! IsValid(GraphManager))
+    {
+        UE_LOG(LogSGP,Warning, TEXT("USUGGraphScheduler::RequestExecution() ABORTED, INVALID GRAPH MANAGER"));
+        return;
+    }
+
+    // Coalesce with pending request, keep the original request frame so
+    // repeated requests does not reset starvation protection
+    FSUGGraphExecutionRequest* Request = RequestQueue.FindByPredicate(
+        [GraphManager](const FSUGGraphExecutionRequest& QueuedRequest)
+        {
+            return QueuedRequest.GraphManager.Get() == GraphManager;
+        } );
+
+    if (Request)
+    {
+        Request->GraphInstance = GraphInstance;
+    }
+    else
+    {
+        FSUGGraphExecutionRequest NewRequest;
+        NewRequest.GraphManager = GraphManager;
+        NewRequest.GraphInstance = GraphInstance;
+        NewRequest.RequestFrame = GFrameCounter;
+        RequestQueue.Emplace(NewRequest);
+    }
+}
+
+void USUGGraphScheduler::CancelRequest(USUGGraphManager* GraphManager)
+{
+    RequestQueue.RemoveAll(
+        [GraphManager](const FSUGGraphExecutionRequest& QueuedRequest)
+        {
+            return QueuedRequest.GraphManager.Get() == GraphManager;
+        } );
+}
+
+bool USUGGraphScheduler::HasPendingRequest(USUGGraphManager* GraphManager) const
+{
+    return RequestQueue.ContainsByPredicate(
+        [GraphManager](const FSUGGraphExecutionRequest& QueuedRequest)
+        {
+            return QueuedRequest.GraphManager.Get() == GraphManager;
+        } );
+}
+
+void USUGGraphScheduler::GatherViewLocations(TArray<FVector>& OutViewLocations) const
+{
+    check(GEngine);
+
+    for (const FWorldContext& Context : GEngine->GetWorldContexts())
+    {
+        UWorld* World = Context.World();
+
+        if (! IsValid(World))
+        {
+            continue;
+        }
+
+        for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+        {
+            APlayerController* PlayerController = It->Get();
+
+            if (IsValid(PlayerController))
+            {
+                FVector ViewLocation;
+                FRotator ViewRotation;
+                PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+                OutViewLocations.Emplace(ViewLocation);
+            }
+        }
+    }
+}
+
+void USUGGraphScheduler::UpdateRequestPriorities()
+{
+    const UShaderGraphPluginSettings* Settings = GetDefault<UShaderGraphPluginSettings>();
+    check(Settings);
+
+    TArray<FVector> ViewLocations;
+    GatherViewLocations(ViewLocations);
+
+    const uint64 FrameCounter = GFrameCounter;
+    const uint64 MaxWaitFrames = FMath::Max(1, Settings->MaxScheduledRequestWaitFrames);
+    const float DistanceScale = FMath::Max(KINDA_SMALL_NUMBER, Settings->ScheduleDistanceScale);
+
+    for (FSUGGraphExecutionRequest& Request : RequestQueue)
+    {
+        USUGGraphManager* GraphManager = Request.GraphManager.Get();
+        check(GraphManager);
+
+        const uint64 WaitFrames = FrameCounter - Request.RequestFrame;
+
+        // Starving request, execute before anything else
+        if (WaitFrames >= MaxWaitFrames)
+        {
+            Request.Priority = TNumericLimits<float>::Max();
+            continue;
+        }
+
+        float Priority = GraphManager->ExecutionPriority;
+
+        if (GraphManager->bPrioritizeByViewDistance && ViewLocations.Num() > 0)
+        {
+            const FVector Location = GraphManager->GetSchedulingLocation();
+            float DistanceSq = TNumericLimits<float>::Max();
+
+            for (const FVector& ViewLocation : ViewLocations)
+            {
+                DistanceSq = FMath::Min(DistanceSq, FVector::DistSquared(Location, ViewLocation));
+            }
+
+            Priority -= Settings->ScheduleDistanceWeight * (FMath::Sqrt(DistanceSq) / DistanceScale);
+        }
+
+        if (GraphManager->bPrioritizeByVisibility && GraphManager->IsSchedulingOwnerVisible())
+        {
+            Priority += Settings->ScheduleVisibilityWeight;
+        }
+
+        Priority += Settings->ScheduleWaitFrameWeight * WaitFrames;
+
+        Request.Priority = Priority;
+    }
+}
+
+void USUGGraphScheduler::Tick(float DeltaTime)
+{
+    SCOPE_CYCLE_COUNTER(STAT_SUGGraphScheduler_Tick);
+
+    // Remove requests from destroyed graph managers
+    RequestQueue.RemoveAll(
+        [](const FSUGGraphExecutionRequest& QueuedRequest)
+        {
+            return ! QueuedRequest.GraphManager.IsValid();
+        } );
+
+    if (RequestQueue.Num() <= 0)
+    {
+        return;
+    }
+
+    const UShaderGraphPluginSettings* Settings = GetDefault<UShaderGraphPluginSettings>();
+    check(Settings);
+
+    UpdateRequestPriorities();
+
+    RequestQueue.StableSort(
+        [](const FSUGGraphExecutionRequest& A, const FSUGGraphExecutionRequest& B)
+        {
+            return A.Priority > B.Priority;
+        } );
+
+    const int32 MaxExecutions = Settings->MaxScheduledExecutionsPerFrame > 0
+        ? Settings->MaxScheduledExecutionsPerFrame
+        : RequestQueue.Num();
+    const double BudgetSeconds = Settings->ScheduledExecutionBudgetMs / 1000.0;
+    const double StartTime = FPlatformTime::Seconds();
+
+    int32 ExecutionCount = 0;
+
+    // Always execute at least the highest priority request so the queue
+    // keeps progressing even when a single graph exceeds the budget
+    while (RequestQueue.Num() > 0 && ExecutionCount < MaxExecutions)
+    {
+        if (ExecutionCount > 0 && BudgetSeconds > 0.0 && (FPlatformTime::Seconds()-StartTime) >= BudgetSeconds)
+        {
+            break;
+        }
+
+        FSUGGraphExecutionRequest Request(RequestQueue[0]);
+        RequestQueue.RemoveAt(0, 1, false);
+
+        USUGGraphManager* GraphManager = Request.GraphManager.Get();
+
+        if (IsValid(GraphManager))
+        {
+            GraphManager->ExecuteGraph(Request.GraphInstance);
+            ++ExecutionCount;
+        }
+    }
+}
+
+bool USUGGraphScheduler::IsTickable() const
+{
+    return ! HasAnyFlags(RF_ClassDefaultObject) && RequestQueue.Num() > 0;
+}
+
+TStatId USUGGraphScheduler::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(USUGGraphScheduler, STATGROUP_Tickables);
+}
@@ -0,0 +1,43 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+#include "SUGGraphShaders.h"
+
+IMPLEMENT_GLOBAL_SHADER(FSUGGraphScreenVS, "/Plugin/ShaderGraphPlugin/Private/SUGGraphScreenPass.usf", "MainVS", SF_Vertex);
+IMPLEMENT_GLOBAL_SHADER(FSUGGraphBaseOpPS, "/Plugin/ShaderGraphPlugin/Private/SUGGraphBaseOp.usf", "MainPS", SF_Pixel);
+IMPLEMENT_GLOBAL_SHADER(FSUGGraphFusedOpPS, "/Plugin/ShaderGraphPlugin/Private/SUGGraphFusedOp.usf", "MainPS", SF_Pixel);
+IMPLEMENT_GLOBAL_SHADER(FSUGGraphGaussianBlurPS, "/Plugin/ShaderGraphPlugin/Private/SUGGraphGaussianBlur.usf", "MainPS", SF_Pixel);
+IMPLEMENT_GLOBAL_SHADER(FSUGGraphPyramidBlurPS, "/Plugin/ShaderGraphPlugin/Private/SUGGraphPyramidBlur.usf", "MainPS", SF_Pixel);
+IMPLEMENT_GLOBAL_SHADER(FSUGGraphJumpFloodPS, "/Plugin/ShaderGraphPlugin/Private/SUGGraphJumpFlood.usf", "MainPS", SF_Pixel);
+IMPLEMENT_GLOBAL_SHADER(FSUGGraphAutoLevelPS, "/Plugin/ShaderGraphPlugin/Private/SUGGraphAutoLevel.usf", "MainPS", SF_Pixel);
+IMPLEMENT_GLOBAL_SHADER(FSUGGraphDifferenceReductionPS, "/Plugin/ShaderGraphPlugin/Private/SUGGraphDifferenceReduction.usf", "MainPS", SF_Pixel);
+IMPLEMENT_GLOBAL_SHADER(FSUGGraphHydraulicErosionPS, "/Plugin/ShaderGraphPlugin/Private/SUGGraphHydraulicErosion.usf", "MainPS", SF_Pixel);
+IMPLEMENT_GLOBAL_SHADER(FSUGGraphBoxFilterPS, "/Plugin/ShaderGraphPlugin/Private/SUGGraphBoxFilter.usf", "MainPS", SF_Pixel);
+IMPLEMENT_GLOBAL_SHADER(FSUGGraphHistogramCS, "/Plugin/ShaderGraphPlugin/Private/SUGGraphHistogram.usf", "MainCS", SF_Compute);
+IMPLEMENT_GLOBAL_SHADER(FSUGGraphMorphologyCS, "/Plugin/ShaderGraphPlugin/Private/SUGGraphMorphology.usf", "MainCS", SF_Compute);
+IMPLEMENT_GLOBAL_SHADER(FSUGGraphSummedAreaTableCS, "/Plugin/ShaderGraphPlugin/Private/SUGGraphSummedAreaTable.usf", "MainCS", SF_Compute);
+IMPLEMENT_GLOBAL_SHADER(FSUGGraphConvolutionCS, "/Plugin/ShaderGraphPlugin/Private/SUGGraphConvolution.usf", "MainCS", SF_Compute);
@@ -0,0 +1,1261 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GlobalShader.h"
+#include "ShaderParameters.h"
+#include "ShaderParameterUtils.h"
+#include "ShaderPermutation.h"
+#include "SUGGraphTypes.h"
+
+// Full screen triangle vertex shader, drawn without vertex buffers
+class FSUGGraphScreenVS : public FGlobalShader
+{
+    DECLARE_GLOBAL_SHADER(FSUGGraphScreenVS);
+
+public:
+
+    static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters)
+    {
+        return IsFeatureLevelSupported(Parameters.Platform, ERHIFeatureLevel::SM4);
+    }
+
+    FSUGGraphScreenVS() = default;
+
+    FSUGGraphScreenVS(const ShaderMetaType::CompiledShaderInitializerType& Initializer)
+        : FGlobalShader(Initializer)
+    {
+    }
+};
+
+class FSUGGraphBaseOpPS : public FGlobalShader
+{
+    DECLARE_GLOBAL_SHADER(FSUGGraphBaseOpPS);
+
+public:
+
+    class FOperationType : SHADER_PERMUTATION_INT("BASE_OP_TYPE", SUG_BOP_MAX);
+    typedef TShaderPermutationDomain<FOperationType> FPermutationDomain;
+
+    static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters)
+    {
+        return IsFeatureLevelSupported(Parameters.Platform, ERHIFeatureLevel::SM4);
+    }
+
+    FSUGGraphBaseOpPS() = default;
+
+    FSUGGraphBaseOpPS(const ShaderMetaType::CompiledShaderInitializerType& Initializer)
+        : FGlobalShader(Initializer)
+    {
+        InputTexture0.Bind(Initializer.ParameterMap, TEXT("InputTexture0"));
+        InputTexture1.Bind(Initializer.ParameterMap, TEXT("InputTexture1"));
+        InputTexture2.Bind(Initializer.ParameterMap, TEXT("InputTexture2"));
+        InputTexture0Sampler.Bind(Initializer.ParameterMap, TEXT("InputTexture0Sampler"));
+        InputTexture1Sampler.Bind(Initializer.ParameterMap, TEXT("InputTexture1Sampler"));
+        InputTexture2Sampler.Bind(Initializer.ParameterMap, TEXT("InputTexture2Sampler"));
+        RemapParams.Bind(Initializer.ParameterMap, TEXT("RemapParams"));
+        LevelsParams.Bind(Initializer.ParameterMap, TEXT("LevelsParams"));
+        Opacity.Bind(Initializer.ParameterMap, TEXT("Opacity"));
+        RangeTexture.Bind(Initializer.ParameterMap, TEXT("RangeTexture"));
+        UseRangeTexture.Bind(Initializer.ParameterMap, TEXT("UseRangeTexture"));
+    }
+
+    virtual bool Serialize(FArchive& Ar) override
+    {
+        bool bShaderHasOutdatedParameters = FGlobalShader::Serialize(Ar);
+        Ar << InputTexture0;
+        Ar << InputTexture1;
+        Ar << InputTexture2;
+        Ar << InputTexture0Sampler;
+        Ar << InputTexture1Sampler;
+        Ar << InputTexture2Sampler;
+        Ar << RemapParams;
+        Ar << LevelsParams;
+        Ar << Opacity;
+        Ar << RangeTexture;
+        Ar << UseRangeTexture;
+        return bShaderHasOutdatedParameters;
+    }
+
+    template<typename TRHICmdList>
+    void SetParameters(
+        TRHICmdList& RHICmdList,
+        FTextureRHIParamRef InputTexture0RHI,
+        FTextureRHIParamRef InputTexture1RHI,
+        FTextureRHIParamRef InputTexture2RHI,
+        const FVector4& RemapParamsValue,
+        const FVector4& LevelsParamsValue,
+        float OpacityValue,
+        FTextureRHIParamRef RangeTextureRHI,
+        bool bUseRangeTexture
+        )
+    {
+        FPixelShaderRHIParamRef ShaderRHI = GetPixelShader();
+        FSamplerStateRHIParamRef SamplerRHI = TStaticSamplerState<SF_Bilinear, AM_Clamp, AM_Clamp, AM_Clamp>::GetRHI();
+
+        SetTextureParameter(RHICmdList, ShaderRHI, InputTexture0, InputTexture0Sampler, SamplerRHI, InputTexture0RHI);
+        SetTextureParameter(RHICmdList, ShaderRHI, InputTexture1, InputTexture1Sampler, SamplerRHI, InputTexture1RHI);
+        SetTextureParameter(RHICmdList, ShaderRHI, InputTexture2, InputTexture2Sampler, SamplerRHI, InputTexture2RHI);
+        SetShaderValue(RHICmdList, ShaderRHI, RemapParams, RemapParamsValue);
+        SetShaderValue(RHICmdList, ShaderRHI, LevelsParams, LevelsParamsValue);
+        SetShaderValue(RHICmdList, ShaderRHI, Opacity, OpacityValue);
+        SetTextureParameter(RHICmdList, ShaderRHI, RangeTexture, RangeTextureRHI);
+        SetShaderValue(RHICmdList, ShaderRHI, UseRangeTexture, bUseRangeTexture ? 1.f : 0.f);
+    }
+
+private:
+
+    FShaderResourceParameter InputTexture0;
+    FShaderResourceParameter InputTexture1;
+    FShaderResourceParameter InputTexture2;
+    FShaderResourceParameter InputTexture0Sampler;
+    FShaderResourceParameter InputTexture1Sampler;
+    FShaderResourceParameter InputTexture2Sampler;
+    FShaderParameter RemapParams;
+    FShaderParameter LevelsParams;
+    FShaderParameter Opacity;
+    FShaderResourceParameter RangeTexture;
+    FShaderParameter UseRangeTexture;
+};
+
+// Chain of pointwise base operations evaluated in a single pass
+class FSUGGraphFusedOpPS : public FGlobalShader
+{
+    DECLARE_GLOBAL_SHADER(FSUGGraphFusedOpPS);
+
+public:
+
+    // Must match FSUGGraphFusedOpParameters limits
+    enum
+    {
+        MaxStages = 4,
+        MaxInputs = 9
+    };
+
+    static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters)
+    {
+        return IsFeatureLevelSupported(Parameters.Platform, ERHIFeatureLevel::SM4);
+    }
+
+    FSUGGraphFusedOpPS() = default;
+
+    FSUGGraphFusedOpPS(const ShaderMetaType::CompiledShaderInitializerType& Initializer)
+        : FGlobalShader(Initializer)
+    {
+        for (int32 i=0; i<MaxInputs; ++i)
+        {
+            FusedInputs[i].Bind(Initializer.ParameterMap, *FString::Printf(TEXT("FusedInput%d"), i));
+        }
+
+        FusedInputSampler.Bind(Initializer.ParameterMap, TEXT("FusedInputSampler"));
+        NumStages.Bind(Initializer.ParameterMap, TEXT("NumStages"));
+        StageOps.Bind(Initializer.ParameterMap, TEXT("StageOps"));
+        StageRemapParams.Bind(Initializer.ParameterMap, TEXT("StageRemapParams"));
+        StageLevelsParams.Bind(Initializer.ParameterMap, TEXT("StageLevelsParams"));
+        StageOpacity.Bind(Initializer.ParameterMap, TEXT("StageOpacity"));
+    }
+
+    virtual bool Serialize(FArchive& Ar) override
+    {
+        bool bShaderHasOutdatedParameters = FGlobalShader::Serialize(Ar);
+        for (int32 i=0; i<MaxInputs; ++i)
+        {
+            Ar << FusedInputs[i];
+        }
+        Ar << FusedInputSampler;
+        Ar << NumStages;
+        Ar << StageOps;
+        Ar << StageRemapParams;
+        Ar << StageLevelsParams;
+        Ar << StageOpacity;
+        return bShaderHasOutdatedParameters;
+    }
+
+    template<typename TRHICmdList>
+    void SetParameters(
+        TRHICmdList& RHICmdList,
+        const FTextureRHIParamRef (&InputRHIs)[MaxInputs],
+        int32 NumStagesValue,
+        const FVector4 (&StageOpsValue)[MaxStages],
+        const FVector4 (&StageRemapParamsValue)[MaxStages],
+        const FVector4 (&StageLevelsParamsValue)[MaxStages],
+        const FVector4& StageOpacityValue
+        )
+    {
+        FPixelShaderRHIParamRef ShaderRHI = GetPixelShader();
+        FSamplerStateRHIParamRef SamplerRHI = TStaticSamplerState<SF_Bilinear, AM_Clamp, AM_Clamp, AM_Clamp>::GetRHI();
+
+        for (int32 i=0; i<MaxInputs; ++i)
+        {
+            SetTextureParameter(RHICmdList, ShaderRHI, FusedInputs[i], InputRHIs[i]);
+        }
+
+        SetSamplerParameter(RHICmdList, ShaderRHI, FusedInputSampler, SamplerRHI);
+        SetShaderValue(RHICmdList, ShaderRHI, NumStages, NumStagesValue);
+        SetShaderValueArray(RHICmdList, ShaderRHI, StageOps, StageOpsValue, MaxStages);
+        SetShaderValueArray(RHICmdList, ShaderRHI, StageRemapParams, StageRemapParamsValue, MaxStages);
+        SetShaderValueArray(RHICmdList, ShaderRHI, StageLevelsParams, StageLevelsParamsValue, MaxStages);
+        SetShaderValue(RHICmdList, ShaderRHI, StageOpacity, StageOpacityValue);
+    }
+
+private:
+
+    FShaderResourceParameter FusedInputs[MaxInputs];
+    FShaderResourceParameter FusedInputSampler;
+    FShaderParameter NumStages;
+    FShaderParameter StageOps;
+    FShaderParameter StageRemapParams;
+    FShaderParameter StageLevelsParams;
+    FShaderParameter StageOpacity;
+};
+
+// Single direction pass of a separable gaussian blur with linear sampled taps
+class FSUGGraphGaussianBlurPS : public FGlobalShader
+{
+    DECLARE_GLOBAL_SHADER(FSUGGraphGaussianBlurPS);
+
+public:
+
+    // Must match FSUGGraphGaussianBlurParameters::MaxTaps
+    enum { MaxTaps = 65 };
+
+    static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters)
+    {
+        return IsFeatureLevelSupported(Parameters.Platform, ERHIFeatureLevel::SM4);
+    }
+
+    FSUGGraphGaussianBlurPS() = default;
+
+    FSUGGraphGaussianBlurPS(const ShaderMetaType::CompiledShaderInitializerType& Initializer)
+        : FGlobalShader(Initializer)
+    {
+        SourceTexture.Bind(Initializer.ParameterMap, TEXT("SourceTexture"));
+        SourceTextureSampler.Bind(Initializer.ParameterMap, TEXT("SourceTextureSampler"));
+        TexelStep.Bind(Initializer.ParameterMap, TEXT("TexelStep"));
+        NumTaps.Bind(Initializer.ParameterMap, TEXT("NumTaps"));
+        Taps.Bind(Initializer.ParameterMap, TEXT("Taps"));
+    }
+
+    virtual bool Serialize(FArchive& Ar) override
+    {
+        bool bShaderHasOutdatedParameters = FGlobalShader::Serialize(Ar);
+        Ar << SourceTexture;
+        Ar << SourceTextureSampler;
+        Ar << TexelStep;
+        Ar << NumTaps;
+        Ar << Taps;
+        return bShaderHasOutdatedParameters;
+    }
+
+    template<typename TRHICmdList>
+    void SetParameters(
+        TRHICmdList& RHICmdList,
+        FTextureRHIParamRef SourceTextureRHI,
+        const FVector2D& TexelStepValue,
+        const FVector4* TapsValue,
+        int32 NumTapsValue
+        )
+    {
+        check(NumTapsValue <= MaxTaps);
+
+        FPixelShaderRHIParamRef ShaderRHI = GetPixelShader();
+        FSamplerStateRHIParamRef SamplerRHI = TStaticSamplerState<SF_Bilinear, AM_Clamp, AM_Clamp, AM_Clamp>::GetRHI();
+
+        SetTextureParameter(RHICmdList, ShaderRHI, SourceTexture, SourceTextureSampler, SamplerRHI, SourceTextureRHI);
+        SetShaderValue(RHICmdList, ShaderRHI, TexelStep, TexelStepValue);
+        SetShaderValue(RHICmdList, ShaderRHI, NumTaps, NumTapsValue);
+        SetShaderValueArray(RHICmdList, ShaderRHI, Taps, TapsValue, NumTapsValue);
+    }
+
+private:
+
+    FShaderResourceParameter SourceTexture;
+    FShaderResourceParameter SourceTextureSampler;
+    FShaderParameter TexelStep;
+    FShaderParameter NumTaps;
+    FShaderParameter Taps;
+};
+
+// Dual filter downsample or upsample pass between blur pyramid levels
+class FSUGGraphPyramidBlurPS : public FGlobalShader
+{
+    DECLARE_GLOBAL_SHADER(FSUGGraphPyramidBlurPS);
+
+public:
+
+    class FUpsample : SHADER_PERMUTATION_BOOL("PYRAMID_UPSAMPLE");
+    typedef TShaderPermutationDomain<FUpsample> FPermutationDomain;
+
+    static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters)
+    {
+        return IsFeatureLevelSupported(Parameters.Platform, ERHIFeatureLevel::SM4);
+    }
+
+    FSUGGraphPyramidBlurPS() = default;
+
+    FSUGGraphPyramidBlurPS(const ShaderMetaType::CompiledShaderInitializerType& Initializer)
+        : FGlobalShader(Initializer)
+    {
+        SourceTexture.Bind(Initializer.ParameterMap, TEXT("SourceTexture"));
+        SourceTextureSampler.Bind(Initializer.ParameterMap, TEXT("SourceTextureSampler"));
+        SourceTexelSize.Bind(Initializer.ParameterMap, TEXT("SourceTexelSize"));
+    }
+
+    virtual bool Serialize(FArchive& Ar) override
+    {
+        bool bShaderHasOutdatedParameters = FGlobalShader::Serialize(Ar);
+        Ar << SourceTexture;
+        Ar << SourceTextureSampler;
+        Ar << SourceTexelSize;
+        return bShaderHasOutdatedParameters;
+    }
+
+    template<typename TRHICmdList>
+    void SetParameters(
+        TRHICmdList& RHICmdList,
+        FTextureRHIParamRef SourceTextureRHI,
+        const FVector2D& SourceTexelSizeValue
+        )
+    {
+        FPixelShaderRHIParamRef ShaderRHI = GetPixelShader();
+        FSamplerStateRHIParamRef SamplerRHI = TStaticSamplerState<SF_Bilinear, AM_Clamp, AM_Clamp, AM_Clamp>::GetRHI();
+
+        SetTextureParameter(RHICmdList, ShaderRHI, SourceTexture, SourceTextureSampler, SamplerRHI, SourceTextureRHI);
+        SetShaderValue(RHICmdList, ShaderRHI, SourceTexelSize, SourceTexelSizeValue);
+    }
+
+private:
+
+    FShaderResourceParameter SourceTexture;
+    FShaderResourceParameter SourceTextureSampler;
+    FShaderParameter SourceTexelSize;
+};
+
+// Jump flood distance transform seed, flood and resolve passes
+class FSUGGraphJumpFloodPS : public FGlobalShader
+{
+    DECLARE_GLOBAL_SHADER(FSUGGraphJumpFloodPS);
+
+public:
+
+    enum EPassType
+    {
+        PassSeed,
+        PassFlood,
+        PassResolve,
+        PassMAX
+    };
+
+    class FPassType : SHADER_PERMUTATION_INT("JUMP_FLOOD_PASS", PassMAX);
+    typedef TShaderPermutationDomain<FPassType> FPermutationDomain;
+
+    static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters)
+    {
+        return IsFeatureLevelSupported(Parameters.Platform, ERHIFeatureLevel::SM4);
+    }
+
+    FSUGGraphJumpFloodPS() = default;
+
+    FSUGGraphJumpFloodPS(const ShaderMetaType::CompiledShaderInitializerType& Initializer)
+        : FGlobalShader(Initializer)
+    {
+        SourceTexture.Bind(Initializer.ParameterMap, TEXT("SourceTexture"));
+        SourceTextureSampler.Bind(Initializer.ParameterMap, TEXT("SourceTextureSampler"));
+        FloodTexture.Bind(Initializer.ParameterMap, TEXT("FloodTexture"));
+        SeedThreshold.Bind(Initializer.ParameterMap, TEXT("SeedThreshold"));
+        StepSize.Bind(Initializer.ParameterMap, TEXT("StepSize"));
+        MaxDistance.Bind(Initializer.ParameterMap, TEXT("MaxDistance"));
+    }
+
+    virtual bool Serialize(FArchive& Ar) override
+    {
+        bool bShaderHasOutdatedParameters = FGlobalShader::Serialize(Ar);
+        Ar << SourceTexture;
+        Ar << SourceTextureSampler;
+        Ar << FloodTexture;
+        Ar << SeedThreshold;
+        Ar << StepSize;
+        Ar << MaxDistance;
+        return bShaderHasOutdatedParameters;
+    }
+
+    template<typename TRHICmdList>
+    void SetParameters(
+        TRHICmdList& RHICmdList,
+        FTextureRHIParamRef SourceTextureRHI,
+        FTextureRHIParamRef FloodTextureRHI,
+        float SeedThresholdValue,
+        int32 StepSizeValue,
+        float MaxDistanceValue
+        )
+    {
+        FPixelShaderRHIParamRef ShaderRHI = GetPixelShader();
+        FSamplerStateRHIParamRef SamplerRHI = TStaticSamplerState<SF_Bilinear, AM_Clamp, AM_Clamp, AM_Clamp>::GetRHI();
+
+        SetTextureParameter(RHICmdList, ShaderRHI, SourceTexture, SourceTextureSampler, SamplerRHI, SourceTextureRHI);
+        SetTextureParameter(RHICmdList, ShaderRHI, FloodTexture, FloodTextureRHI);
+        SetShaderValue(RHICmdList, ShaderRHI, SeedThreshold, SeedThresholdValue);
+        SetShaderValue(RHICmdList, ShaderRHI, StepSize, StepSizeValue);
+        SetShaderValue(RHICmdList, ShaderRHI, MaxDistance, MaxDistanceValue);
+    }
+
+private:
+
+    FShaderResourceParameter SourceTexture;
+    FShaderResourceParameter SourceTextureSampler;
+    FShaderResourceParameter FloodTexture;
+    FShaderParameter SeedThreshold;
+    FShaderParameter StepSize;
+    FShaderParameter MaxDistance;
+};
+
+// Hierarchical value range reduction and auto level application passes
+class FSUGGraphAutoLevelPS : public FGlobalShader
+{
+    DECLARE_GLOBAL_SHADER(FSUGGraphAutoLevelPS);
+
+public:
+
+    enum EPassType
+    {
+        PassReduceSource,
+        PassReduceRange,
+        PassApply,
+        PassMAX
+    };
+
+    // Must match reduction size of SUGGraphAutoLevel.usf
+    enum { ReductionSize = 4 };
+
+    class FPassType : SHADER_PERMUTATION_INT("AUTO_LEVEL_PASS", PassMAX);
+    typedef TShaderPermutationDomain<FPassType> FPermutationDomain;
+
+    static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters)
+    {
+        return IsFeatureLevelSupported(Parameters.Platform, ERHIFeatureLevel::SM4);
+    }
+
+    FSUGGraphAutoLevelPS() = default;
+
+    FSUGGraphAutoLevelPS(const ShaderMetaType::CompiledShaderInitializerType& Initializer)
+        : FGlobalShader(Initializer)
+    {
+        SourceTexture.Bind(Initializer.ParameterMap, TEXT("SourceTexture"));
+        SourceTextureSampler.Bind(Initializer.ParameterMap, TEXT("SourceTextureSampler"));
+        RangeTexture.Bind(Initializer.ParameterMap, TEXT("RangeTexture"));
+        LevelMask.Bind(Initializer.ParameterMap, TEXT("LevelMask"));
+    }
+
+    virtual bool Serialize(FArchive& Ar) override
+    {
+        bool bShaderHasOutdatedParameters = FGlobalShader::Serialize(Ar);
+        Ar << SourceTexture;
+        Ar << SourceTextureSampler;
+        Ar << RangeTexture;
+        Ar << LevelMask;
+        return bShaderHasOutdatedParameters;
+    }
+
+    template<typename TRHICmdList>
+    void SetParameters(
+        TRHICmdList& RHICmdList,
+        FTextureRHIParamRef SourceTextureRHI,
+        FTextureRHIParamRef RangeTextureRHI,
+        const FVector2D& LevelMaskValue
+        )
+    {
+        FPixelShaderRHIParamRef ShaderRHI = GetPixelShader();
+        FSamplerStateRHIParamRef SamplerRHI = TStaticSamplerState<SF_Bilinear, AM_Clamp, AM_Clamp, AM_Clamp>::GetRHI();
+
+        SetTextureParameter(RHICmdList, ShaderRHI, SourceTexture, SourceTextureSampler, SamplerRHI, SourceTextureRHI);
+        SetTextureParameter(RHICmdList, ShaderRHI, RangeTexture, RangeTextureRHI);
+        SetShaderValue(RHICmdList, ShaderRHI, LevelMask, LevelMaskValue);
+    }
+
+private:
+
+    FShaderResourceParameter SourceTexture;
+    FShaderResourceParameter SourceTextureSampler;
+    FShaderResourceParameter RangeTexture;
+    FShaderParameter LevelMask;
+};
+
+// Maximum absolute difference reduction of two equally sized textures
+class FSUGGraphDifferenceReductionPS : public FGlobalShader
+{
+    DECLARE_GLOBAL_SHADER(FSUGGraphDifferenceReductionPS);
+
+public:
+
+    enum EPassType
+    {
+        PassReduceSource,
+        PassReduceMax,
+        PassMAX
+    };
+
+    // Reduction levels are shared with value range reductions
+    enum { ReductionSize = FSUGGraphAutoLevelPS::ReductionSize };
+
+    class FPassType : SHADER_PERMUTATION_INT("DIFFERENCE_PASS", PassMAX);
+    typedef TShaderPermutationDomain<FPassType> FPermutationDomain;
+
+    static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters)
+    {
+        return IsFeatureLevelSupported(Parameters.Platform, ERHIFeatureLevel::SM4);
+    }
+
+    FSUGGraphDifferenceReductionPS() = default;
+
+    FSUGGraphDifferenceReductionPS(const ShaderMetaType::CompiledShaderInitializerType& Initializer)
+        : FGlobalShader(Initializer)
+    {
+        SourceTextureA.Bind(Initializer.ParameterMap, TEXT("SourceTextureA"));
+        SourceTextureB.Bind(Initializer.ParameterMap, TEXT("SourceTextureB"));
+        ReductionTexture.Bind(Initializer.ParameterMap, TEXT("ReductionTexture"));
+    }
+
+    virtual bool Serialize(FArchive& Ar) override
+    {
+        bool bShaderHasOutdatedParameters = FGlobalShader::Serialize(Ar);
+        Ar << SourceTextureA;
+        Ar << SourceTextureB;
+        Ar << ReductionTexture;
+        return bShaderHasOutdatedParameters;
+    }
+
+    template<typename TRHICmdList>
+    void SetParameters(
+        TRHICmdList& RHICmdList,
+        FTextureRHIParamRef SourceTextureARHI,
+        FTextureRHIParamRef SourceTextureBRHI,
+        FTextureRHIParamRef ReductionTextureRHI
+        )
+    {
+        FPixelShaderRHIParamRef ShaderRHI = GetPixelShader();
+
+        SetTextureParameter(RHICmdList, ShaderRHI, SourceTextureA, SourceTextureARHI);
+        SetTextureParameter(RHICmdList, ShaderRHI, SourceTextureB, SourceTextureBRHI);
+        SetTextureParameter(RHICmdList, ShaderRHI, ReductionTexture, ReductionTextureRHI);
+    }
+
+private:
+
+    FShaderResourceParameter SourceTextureA;
+    FShaderResourceParameter SourceTextureB;
+    FShaderResourceParameter ReductionTexture;
+};
+
+// Pipe model hydraulic erosion simulation passes
+class FSUGGraphHydraulicErosionPS : public FGlobalShader
+{
+    DECLARE_GLOBAL_SHADER(FSUGGraphHydraulicErosionPS);
+
+public:
+
+    enum EPassType
+    {
+        PassInitTerrain,
+        PassInitFlux,
+        PassFlux,
+        PassErosion,
+        PassTransport,
+        PassResolve,
+        PassMAX
+    };
+
+    class FPassType : SHADER_PERMUTATION_INT("EROSION_PASS", PassMAX);
+    typedef TShaderPermutationDomain<FPassType> FPermutationDomain;
+
+    static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters)
+    {
+        return IsFeatureLevelSupported(Parameters.Platform, ERHIFeatureLevel::SM4);
+    }
+
+    FSUGGraphHydraulicErosionPS() = default;
+
+    FSUGGraphHydraulicErosionPS(const ShaderMetaType::CompiledShaderInitializerType& Initializer)
+        : FGlobalShader(Initializer)
+    {
+        SourceTexture.Bind(Initializer.ParameterMap, TEXT("SourceTexture"));
+        SourceTextureSampler.Bind(Initializer.ParameterMap, TEXT("SourceTextureSampler"));
+        TerrainTexture.Bind(Initializer.ParameterMap, TEXT("TerrainTexture"));
+        FluxTexture.Bind(Initializer.ParameterMap, TEXT("FluxTexture"));
+        SimulationParams.Bind(Initializer.ParameterMap, TEXT("SimulationParams"));
+        ErosionParams.Bind(Initializer.ParameterMap, TEXT("ErosionParams"));
+        ErosionParams2.Bind(Initializer.ParameterMap, TEXT("ErosionParams2"));
+    }
+
+    virtual bool Serialize(FArchive& Ar) override
+    {
+        bool bShaderHasOutdatedParameters = FGlobalShader::Serialize(Ar);
+        Ar << SourceTexture;
+        Ar << SourceTextureSampler;
+        Ar << TerrainTexture;
+        Ar << FluxTexture;
+        Ar << SimulationParams;
+        Ar << ErosionParams;
+        Ar << ErosionParams2;
+        return bShaderHasOutdatedParameters;
+    }
+
+    template<typename TRHICmdList>
+    void SetParameters(
+        TRHICmdList& RHICmdList,
+        FTextureRHIParamRef SourceTextureRHI,
+        FTextureRHIParamRef TerrainTextureRHI,
+        FTextureRHIParamRef FluxTextureRHI,
+        const FVector4& SimulationParamsValue,
+        const FVector4& ErosionParamsValue,
+        const FVector4& ErosionParams2Value
+        )
+    {
+        FPixelShaderRHIParamRef ShaderRHI = GetPixelShader();
+        FSamplerStateRHIParamRef SamplerRHI = TStaticSamplerState<SF_Bilinear, AM_Clamp, AM_Clamp, AM_Clamp>::GetRHI();
+
+        SetTextureParameter(RHICmdList, ShaderRHI, SourceTexture, SourceTextureSampler, SamplerRHI, SourceTextureRHI);
+        SetTextureParameter(RHICmdList, ShaderRHI, TerrainTexture, TerrainTextureRHI);
+        SetTextureParameter(RHICmdList, ShaderRHI, FluxTexture, FluxTextureRHI);
+        SetShaderValue(RHICmdList, ShaderRHI, SimulationParams, SimulationParamsValue);
+        SetShaderValue(RHICmdList, ShaderRHI, ErosionParams, ErosionParamsValue);
+        SetShaderValue(RHICmdList, ShaderRHI, ErosionParams2, ErosionParams2Value);
+    }
+
+private:
+
+    FShaderResourceParameter SourceTexture;
+    FShaderResourceParameter SourceTextureSampler;
+    FShaderResourceParameter TerrainTexture;
+    FShaderResourceParameter FluxTexture;
+    FShaderParameter SimulationParams;
+    FShaderParameter ErosionParams;
+    FShaderParameter ErosionParams2;
+};
+
+// Box filter mean lookup of a summed area table
+class FSUGGraphBoxFilterPS : public FGlobalShader
+{
+    DECLARE_GLOBAL_SHADER(FSUGGraphBoxFilterPS);
+
+public:
+
+    static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters)
+    {
+        return IsFeatureLevelSupported(Parameters.Platform, ERHIFeatureLevel::SM4);
+    }
+
+    FSUGGraphBoxFilterPS() = default;
+
+    FSUGGraphBoxFilterPS(const ShaderMetaType::CompiledShaderInitializerType& Initializer)
+        : FGlobalShader(Initializer)
+    {
+        SummedAreaTexture.Bind(Initializer.ParameterMap, TEXT("SummedAreaTexture"));
+        RadiusTexture.Bind(Initializer.ParameterMap, TEXT("RadiusTexture"));
+        RadiusTextureSampler.Bind(Initializer.ParameterMap, TEXT("RadiusTextureSampler"));
+        BoxParams.Bind(Initializer.ParameterMap, TEXT("BoxParams"));
+    }
+
+    virtual bool Serialize(FArchive& Ar) override
+    {
+        bool bShaderHasOutdatedParameters = FGlobalShader::Serialize(Ar);
+        Ar << SummedAreaTexture;
+        Ar << RadiusTexture;
+        Ar << RadiusTextureSampler;
+        Ar << BoxParams;
+        return bShaderHasOutdatedParameters;
+    }
+
+    template<typename TRHICmdList>
+    void SetParameters(
+        TRHICmdList& RHICmdList,
+        FTextureRHIParamRef SummedAreaTextureRHI,
+        FTextureRHIParamRef RadiusTextureRHI,
+        const FVector4& BoxParamsValue
+        )
+    {
+        FPixelShaderRHIParamRef ShaderRHI = GetPixelShader();
+        FSamplerStateRHIParamRef SamplerRHI = TStaticSamplerState<SF_Bilinear, AM_Clamp, AM_Clamp, AM_Clamp>::GetRHI();
+
+        SetTextureParameter(RHICmdList, ShaderRHI, SummedAreaTexture, SummedAreaTextureRHI);
+        SetTextureParameter(RHICmdList, ShaderRHI, RadiusTexture, RadiusTextureSampler, SamplerRHI, RadiusTextureRHI);
+        SetShaderValue(RHICmdList, ShaderRHI, BoxParams, BoxParamsValue);
+    }
+
+private:
+
+    FShaderResourceParameter SummedAreaTexture;
+    FShaderResourceParameter RadiusTexture;
+    FShaderResourceParameter RadiusTextureSampler;
+    FShaderParameter BoxParams;
+};
+
+// Histogram accumulation and prefix sum percentile compute passes
+class FSUGGraphHistogramCS : public FGlobalShader
+{
+    DECLARE_GLOBAL_SHADER(FSUGGraphHistogramCS);
+
+public:
+
+    enum EPassType
+    {
+        PassAccumulate,
+        PassPercentile,
+        PassMAX
+    };
+
+    // Must match limits and group size of SUGGraphHistogram.usf
+    enum
+    {
+        MaxBinCount = 1024,
+        GroupSize = 8
+    };
+
+    class FPassType : SHADER_PERMUTATION_INT("HISTOGRAM_PASS", PassMAX);
+    typedef TShaderPermutationDomain<FPassType> FPermutationDomain;
+
+    static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters)
+    {
+        return IsFeatureLevelSupported(Parameters.Platform, ERHIFeatureLevel::SM5);
+    }
+
+    static void ModifyCompilationEnvironment(const FGlobalShaderPermutationParameters& Parameters, FShaderCompilerEnvironment& OutEnvironment)
+    {
+        FGlobalShader::ModifyCompilationEnvironment(Parameters, OutEnvironment);
+        OutEnvironment.SetDefine(TEXT("THREADGROUP_SIZEX"), GroupSize);
+        OutEnvironment.SetDefine(TEXT("THREADGROUP_SIZEY"), GroupSize);
+    }
+
+    FSUGGraphHistogramCS() = default;
+
+    FSUGGraphHistogramCS(const ShaderMetaType::CompiledShaderInitializerType& Initializer)
+        : FGlobalShader(Initializer)
+    {
+        BinCount.Bind(Initializer.ParameterMap, TEXT("BinCount"));
+        ValueRange.Bind(Initializer.ParameterMap, TEXT("ValueRange"));
+        SourceTexture.Bind(Initializer.ParameterMap, TEXT("SourceTexture"));
+        SourceSize.Bind(Initializer.ParameterMap, TEXT("SourceSize"));
+        ChannelMask.Bind(Initializer.ParameterMap, TEXT("ChannelMask"));
+        HistogramBuffer.Bind(Initializer.ParameterMap, TEXT("HistogramBuffer"));
+        Percentiles.Bind(Initializer.ParameterMap, TEXT("Percentiles"));
+        OutputTexture.Bind(Initializer.ParameterMap, TEXT("OutputTexture"));
+    }
+
+    virtual bool Serialize(FArchive& Ar) override
+    {
+        bool bShaderHasOutdatedParameters = FGlobalShader::Serialize(Ar);
+        Ar << BinCount;
+        Ar << ValueRange;
+        Ar << SourceTexture;
+        Ar << SourceSize;
+        Ar << ChannelMask;
+        Ar << HistogramBuffer;
+        Ar << Percentiles;
+        Ar << OutputTexture;
+        return bShaderHasOutdatedParameters;
+    }
+
+    template<typename TRHICmdList>
+    void SetAccumulateParameters(
+        TRHICmdList& RHICmdList,
+        FTextureRHIParamRef SourceTextureRHI,
+        const FIntPoint& SourceSizeValue,
+        const FVector4& ChannelMaskValue,
+        uint32 BinCountValue,
+        const FVector2D& ValueRangeValue,
+        FUnorderedAccessViewRHIParamRef HistogramUAV
+        )
+    {
+        FComputeShaderRHIParamRef ShaderRHI = GetComputeShader();
+
+        SetTextureParameter(RHICmdList, ShaderRHI, SourceTexture, SourceTextureRHI);
+        SetShaderValue(RHICmdList, ShaderRHI, SourceSize, SourceSizeValue);
+        SetShaderValue(RHICmdList, ShaderRHI, ChannelMask, ChannelMaskValue);
+        SetShaderValue(RHICmdList, ShaderRHI, BinCount, BinCountValue);
+        SetShaderValue(RHICmdList, ShaderRHI, ValueRange, ValueRangeValue);
+        SetUAVParameter(RHICmdList, ShaderRHI, HistogramBuffer, HistogramUAV);
+    }
+
+    template<typename TRHICmdList>
+    void SetPercentileParameters(
+        TRHICmdList& RHICmdList,
+        FShaderResourceViewRHIParamRef HistogramSRV,
+        uint32 BinCountValue,
+        const FVector2D& ValueRangeValue,
+        const FVector2D& PercentilesValue,
+        FUnorderedAccessViewRHIParamRef OutputUAV
+        )
+    {
+        FComputeShaderRHIParamRef ShaderRHI = GetComputeShader();
+
+        SetSRVParameter(RHICmdList, ShaderRHI, HistogramBuffer, HistogramSRV);
+        SetShaderValue(RHICmdList, ShaderRHI, BinCount, BinCountValue);
+        SetShaderValue(RHICmdList, ShaderRHI, ValueRange, ValueRangeValue);
+        SetShaderValue(RHICmdList, ShaderRHI, Percentiles, PercentilesValue);
+        SetUAVParameter(RHICmdList, ShaderRHI, OutputTexture, OutputUAV);
+    }
+
+    template<typename TRHICmdList>
+    void UnbindBuffers(TRHICmdList& RHICmdList)
+    {
+        FComputeShaderRHIParamRef ShaderRHI = GetComputeShader();
+
+        SetUAVParameter(RHICmdList, ShaderRHI, HistogramBuffer, nullptr);
+        SetUAVParameter(RHICmdList, ShaderRHI, OutputTexture, nullptr);
+    }
+
+private:
+
+    FShaderParameter BinCount;
+    FShaderParameter ValueRange;
+    FShaderResourceParameter SourceTexture;
+    FShaderParameter SourceSize;
+    FShaderParameter ChannelMask;
+    FShaderResourceParameter HistogramBuffer;
+    FShaderParameter Percentiles;
+    FShaderResourceParameter OutputTexture;
+};
+
+// Van Herk/Gil-Werman separable morphology compute passes
+class FSUGGraphMorphologyCS : public FGlobalShader
+{
+    DECLARE_GLOBAL_SHADER(FSUGGraphMorphologyCS);
+
+public:
+
+    enum EPassType
+    {
+        PassScanX,
+        PassCombineX,
+        PassScanY,
+        PassCombineY,
+        PassMAX
+    };
+
+    // Must match group sizes of SUGGraphMorphology.usf
+    enum
+    {
+        GroupSize = 8,
+        ScanGroupSize = 64
+    };
+
+    class FPassType : SHADER_PERMUTATION_INT("MORPHOLOGY_PASS", PassMAX);
+    class FDilate : SHADER_PERMUTATION_BOOL("MORPHOLOGY_DILATE");
+    typedef TShaderPermutationDomain<FPassType, FDilate> FPermutationDomain;
+
+    static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters)
+    {
+        return IsFeatureLevelSupported(Parameters.Platform, ERHIFeatureLevel::SM5);
+    }
+
+    static void ModifyCompilationEnvironment(const FGlobalShaderPermutationParameters& Parameters, FShaderCompilerEnvironment& OutEnvironment)
+    {
+        FGlobalShader::ModifyCompilationEnvironment(Parameters, OutEnvironment);
+        OutEnvironment.SetDefine(TEXT("THREADGROUP_SIZEX"), GroupSize);
+        OutEnvironment.SetDefine(TEXT("THREADGROUP_SIZEY"), GroupSize);
+    }
+
+    FSUGGraphMorphologyCS() = default;
+
+    FSUGGraphMorphologyCS(const ShaderMetaType::CompiledShaderInitializerType& Initializer)
+        : FGlobalShader(Initializer)
+    {
+        Size.Bind(Initializer.ParameterMap, TEXT("Size"));
+        Radius.Bind(Initializer.ParameterMap, TEXT("Radius"));
+        SourceTexture.Bind(Initializer.ParameterMap, TEXT("SourceTexture"));
+        PrefixBuffer.Bind(Initializer.ParameterMap, TEXT("PrefixBuffer"));
+        SuffixBuffer.Bind(Initializer.ParameterMap, TEXT("SuffixBuffer"));
+        IntermediateBuffer.Bind(Initializer.ParameterMap, TEXT("IntermediateBuffer"));
+        OutputTexture.Bind(Initializer.ParameterMap, TEXT("OutputTexture"));
+    }
+
+    virtual bool Serialize(FArchive& Ar) override
+    {
+        bool bShaderHasOutdatedParameters = FGlobalShader::Serialize(Ar);
+        Ar << Size;
+        Ar << Radius;
+        Ar << SourceTexture;
+        Ar << PrefixBuffer;
+        Ar << SuffixBuffer;
+        Ar << IntermediateBuffer;
+        Ar << OutputTexture;
+        return bShaderHasOutdatedParameters;
+    }
+
+    // Scan passes read the source texture (horizontal) or the intermediate
+    // buffer (vertical) and write segment prefix and suffix buffers
+    template<typename TRHICmdList>
+    void SetScanParameters(
+        TRHICmdList& RHICmdList,
+        const FIntPoint& SizeValue,
+        uint32 RadiusValue,
+        FTextureRHIParamRef SourceTextureRHI,
+        FShaderResourceViewRHIParamRef IntermediateSRV,
+        FUnorderedAccessViewRHIParamRef PrefixUAV,
+        FUnorderedAccessViewRHIParamRef SuffixUAV
+        )
+    {
+        FComputeShaderRHIParamRef ShaderRHI = GetComputeShader();
+
+        SetShaderValue(RHICmdList, ShaderRHI, Size, SizeValue);
+        SetShaderValue(RHICmdList, ShaderRHI, Radius, RadiusValue);
+        SetTextureParameter(RHICmdList, ShaderRHI, SourceTexture, SourceTextureRHI);
+        SetSRVParameter(RHICmdList, ShaderRHI, IntermediateBuffer, IntermediateSRV);
+        SetUAVParameter(RHICmdList, ShaderRHI, PrefixBuffer, PrefixUAV);
+        SetUAVParameter(RHICmdList, ShaderRHI, SuffixBuffer, SuffixUAV);
+    }
+
+    // Combine passes read prefix and suffix buffers and write the
+    // intermediate buffer (horizontal) or the output texture (vertical)
+    template<typename TRHICmdList>
+    void SetCombineParameters(
+        TRHICmdList& RHICmdList,
+        const FIntPoint& SizeValue,
+        uint32 RadiusValue,
+        FShaderResourceViewRHIParamRef PrefixSRV,
+        FShaderResourceViewRHIParamRef SuffixSRV,
+        FUnorderedAccessViewRHIParamRef IntermediateUAV,
+        FUnorderedAccessViewRHIParamRef OutputUAV
+        )
+    {
+        FComputeShaderRHIParamRef ShaderRHI = GetComputeShader();
+
+        SetShaderValue(RHICmdList, ShaderRHI, Size, SizeValue);
+        SetShaderValue(RHICmdList, ShaderRHI, Radius, RadiusValue);
+        SetSRVParameter(RHICmdList, ShaderRHI, PrefixBuffer, PrefixSRV);
+        SetSRVParameter(RHICmdList, ShaderRHI, SuffixBuffer, SuffixSRV);
+        SetUAVParameter(RHICmdList, ShaderRHI, IntermediateBuffer, IntermediateUAV);
+        SetUAVParameter(RHICmdList, ShaderRHI, OutputTexture, OutputUAV);
+    }
+
+    template<typename TRHICmdList>
+    void UnbindBuffers(TRHICmdList& RHICmdList)
+    {
+        FComputeShaderRHIParamRef ShaderRHI = GetComputeShader();
+
+        SetUAVParameter(RHICmdList, ShaderRHI, PrefixBuffer, nullptr);
+        SetUAVParameter(RHICmdList, ShaderRHI, SuffixBuffer, nullptr);
+        SetUAVParameter(RHICmdList, ShaderRHI, IntermediateBuffer, nullptr);
+        SetUAVParameter(RHICmdList, ShaderRHI, OutputTexture, nullptr);
+    }
+
+private:
+
+    FShaderParameter Size;
+    FShaderParameter Radius;
+    FShaderResourceParameter SourceTexture;
+    FShaderResourceParameter PrefixBuffer;
+    FShaderResourceParameter SuffixBuffer;
+    FShaderResourceParameter IntermediateBuffer;
+    FShaderResourceParameter OutputTexture;
+};
+
+// Summed area table row total, source mean, row and column prefix sum
+// compute passes
+class FSUGGraphSummedAreaTableCS : public FGlobalShader
+{
+    DECLARE_GLOBAL_SHADER(FSUGGraphSummedAreaTableCS);
+
+public:
+
+    enum EPassType
+    {
+        PassRows,
+        PassColumns,
+        PassTotals,
+        PassMean,
+        PassMAX
+    };
+
+    // Must match scan group size of SUGGraphSummedAreaTable.usf
+    enum { ScanGroupSize = 256 };
+
+    class FPassType : SHADER_PERMUTATION_INT("SUMMED_AREA_PASS", PassMAX);
+    typedef TShaderPermutationDomain<FPassType> FPermutationDomain;
+
+    static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters)
+    {
+        return IsFeatureLevelSupported(Parameters.Platform, ERHIFeatureLevel::SM5);
+    }
+
+    FSUGGraphSummedAreaTableCS() = default;
+
+    FSUGGraphSummedAreaTableCS(const ShaderMetaType::CompiledShaderInitializerType& Initializer)
+        : FGlobalShader(Initializer)
+    {
+        Size.Bind(Initializer.ParameterMap, TEXT("Size"));
+        ValueOffset.Bind(Initializer.ParameterMap, TEXT("ValueOffset"));
+        SubtractMean.Bind(Initializer.ParameterMap, TEXT("SubtractMean"));
+        SourceTexture.Bind(Initializer.ParameterMap, TEXT("SourceTexture"));
+        RowTotalBuffer.Bind(Initializer.ParameterMap, TEXT("RowTotalBuffer"));
+        MeanBuffer.Bind(Initializer.ParameterMap, TEXT("MeanBuffer"));
+        RowSumBuffer.Bind(Initializer.ParameterMap, TEXT("RowSumBuffer"));
+        OutputTexture.Bind(Initializer.ParameterMap, TEXT("OutputTexture"));
+    }
+
+    virtual bool Serialize(FArchive& Ar) override
+    {
+        bool bShaderHasOutdatedParameters = FGlobalShader::Serialize(Ar);
+        Ar << Size;
+        Ar << ValueOffset;
+        Ar << SubtractMean;
+        Ar << SourceTexture;
+        Ar << RowTotalBuffer;
+        Ar << MeanBuffer;
+        Ar << RowSumBuffer;
+        Ar << OutputTexture;
+        return bShaderHasOutdatedParameters;
+    }
+
+    template<typename TRHICmdList>
+    void SetTotalParameters(
+        TRHICmdList& RHICmdList,
+        const FIntPoint& SizeValue,
+        FTextureRHIParamRef SourceTextureRHI,
+        FUnorderedAccessViewRHIParamRef RowTotalUAV
+        )
+    {
+        FComputeShaderRHIParamRef ShaderRHI = GetComputeShader();
+
+        SetShaderValue(RHICmdList, ShaderRHI, Size, SizeValue);
+        SetTextureParameter(RHICmdList, ShaderRHI, SourceTexture, SourceTextureRHI);
+        SetUAVParameter(RHICmdList, ShaderRHI, RowTotalBuffer, RowTotalUAV);
+    }
+
+    template<typename TRHICmdList>
+    void SetMeanParameters(
+        TRHICmdList& RHICmdList,
+        const FIntPoint& SizeValue,
+        FShaderResourceViewRHIParamRef RowTotalSRV,
+        FUnorderedAccessViewRHIParamRef MeanUAV
+        )
+    {
+        FComputeShaderRHIParamRef ShaderRHI = GetComputeShader();
+
+        SetShaderValue(RHICmdList, ShaderRHI, Size, SizeValue);
+        SetSRVParameter(RHICmdList, ShaderRHI, RowTotalBuffer, RowTotalSRV);
+        SetUAVParameter(RHICmdList, ShaderRHI, MeanBuffer, MeanUAV);
+    }
+
+    template<typename TRHICmdList>
+    void SetRowParameters(
+        TRHICmdList& RHICmdList,
+        const FIntPoint& SizeValue,
+        float ValueOffsetValue,
+        bool bSubtractMean,
+        FTextureRHIParamRef SourceTextureRHI,
+        FShaderResourceViewRHIParamRef MeanSRV,
+        FUnorderedAccessViewRHIParamRef RowSumUAV
+        )
+    {
+        FComputeShaderRHIParamRef ShaderRHI = GetComputeShader();
+
+        SetShaderValue(RHICmdList, ShaderRHI, Size, SizeValue);
+        SetShaderValue(RHICmdList, ShaderRHI, ValueOffset, ValueOffsetValue);
+        SetShaderValue(RHICmdList, ShaderRHI, SubtractMean, bSubtractMean ? 1u : 0u);
+        SetTextureParameter(RHICmdList, ShaderRHI, SourceTexture, SourceTextureRHI);
+        SetSRVParameter(RHICmdList, ShaderRHI, MeanBuffer, MeanSRV);
+        SetUAVParameter(RHICmdList, ShaderRHI, RowSumBuffer, RowSumUAV);
+    }
+
+    template<typename TRHICmdList>
+    void SetColumnParameters(
+        TRHICmdList& RHICmdList,
+        const FIntPoint& SizeValue,
+        bool bSubtractMean,
+        FShaderResourceViewRHIParamRef MeanSRV,
+        FShaderResourceViewRHIParamRef RowSumSRV,
+        FUnorderedAccessViewRHIParamRef OutputUAV
+        )
+    {
+        FComputeShaderRHIParamRef ShaderRHI = GetComputeShader();
+
+        SetShaderValue(RHICmdList, ShaderRHI, Size, SizeValue);
+        SetShaderValue(RHICmdList, ShaderRHI, SubtractMean, bSubtractMean ? 1u : 0u);
+        SetSRVParameter(RHICmdList, ShaderRHI, MeanBuffer, MeanSRV);
+        SetSRVParameter(RHICmdList, ShaderRHI, RowSumBuffer, RowSumSRV);
+        SetUAVParameter(RHICmdList, ShaderRHI, OutputTexture, OutputUAV);
+    }
+
+    template<typename TRHICmdList>
+    void UnbindBuffers(TRHICmdList& RHICmdList)
+    {
+        FComputeShaderRHIParamRef ShaderRHI = GetComputeShader();
+
+        SetUAVParameter(RHICmdList, ShaderRHI, RowTotalBuffer, nullptr);
+        SetUAVParameter(RHICmdList, ShaderRHI, MeanBuffer, nullptr);
+        SetUAVParameter(RHICmdList, ShaderRHI, RowSumBuffer, nullptr);
+        SetUAVParameter(RHICmdList, ShaderRHI, OutputTexture, nullptr);
+    }
+
+private:
+
+    FShaderParameter Size;
+    FShaderParameter ValueOffset;
+    FShaderParameter SubtractMean;
+    FShaderResourceParameter SourceTexture;
+    FShaderResourceParameter RowTotalBuffer;
+    FShaderResourceParameter MeanBuffer;
+    FShaderResourceParameter RowSumBuffer;
+    FShaderResourceParameter OutputTexture;
+};
+
+// Direct and FFT convolution compute passes. FFT passes transform a single
+// line per group, the kernel spectrum is built by its own row and column
+// passes and may be reused across dispatches. Source, convolve and resolve
+// passes run once per output block.
+class FSUGGraphConvolutionCS : public FGlobalShader
+{
+    DECLARE_GLOBAL_SHADER(FSUGGraphConvolutionCS);
+
+public:
+
+    enum EPassType
+    {
+        PassDirect,
+        PassKernelRows,
+        PassKernelColumns,
+        PassSourceRows,
+        PassConvolveColumns,
+        PassResolveRows,
+        PassMAX
+    };
+
+    // Must match group sizes and transform limit of SUGGraphConvolution.usf
+    enum
+    {
+        GroupSize = 8,
+        LineGroupSize = 256,
+        MaxFFTSize = 1024
+    };
+
+    class FPassType : SHADER_PERMUTATION_INT("CONVOLUTION_PASS", PassMAX);
+    typedef TShaderPermutationDomain<FPassType> FPermutationDomain;
+
+    static bool ShouldCompilePermutation(const FGlobalShaderPermutationParameters& Parameters)
+    {
+        return IsFeatureLevelSupported(Parameters.Platform, ERHIFeatureLevel::SM5);
+    }
+
+    static void ModifyCompilationEnvironment(const FGlobalShaderPermutationParameters& Parameters, FShaderCompilerEnvironment& OutEnvironment)
+    {
+        FGlobalShader::ModifyCompilationEnvironment(Parameters, OutEnvironment);
+        OutEnvironment.SetDefine(TEXT("THREADGROUP_SIZEX"), GroupSize);
+        OutEnvironment.SetDefine(TEXT("THREADGROUP_SIZEY"), GroupSize);
+    }
+
+    FSUGGraphConvolutionCS() = default;
+
+    FSUGGraphConvolutionCS(const ShaderMetaType::CompiledShaderInitializerType& Initializer)
+        : FGlobalShader(Initializer)
+    {
+        Size.Bind(Initializer.ParameterMap, TEXT("Size"));
+        FFTSize.Bind(Initializer.ParameterMap, TEXT("FFTSize"));
+        BlockOrigin.Bind(Initializer.ParameterMap, TEXT("BlockOrigin"));
+        BlockSize.Bind(Initializer.ParameterMap, TEXT("BlockSize"));
+        KernelSize.Bind(Initializer.ParameterMap, TEXT("KernelSize"));
+        NormalizeKernel.Bind(Initializer.ParameterMap, TEXT("NormalizeKernel"));
+        SourceTexture.Bind(Initializer.ParameterMap, TEXT("SourceTexture"));
+        KernelTexture.Bind(Initializer.ParameterMap, TEXT("KernelTexture"));
+        SpectrumBuffer.Bind(Initializer.ParameterMap, TEXT("SpectrumBuffer"));
+        KernelSpectrumBuffer.Bind(Initializer.ParameterMap, TEXT("KernelSpectrumBuffer"));
+        OutputTexture.Bind(Initializer.ParameterMap, TEXT("OutputTexture"));
+    }
+
+    virtual bool Serialize(FArchive& Ar) override
+    {
+        bool bShaderHasOutdatedParameters = FGlobalShader::Serialize(Ar);
+        Ar << Size;
+        Ar << FFTSize;
+        Ar << BlockOrigin;
+        Ar << BlockSize;
+        Ar << KernelSize;
+        Ar << NormalizeKernel;
+        Ar << SourceTexture;
+        Ar << KernelTexture;
+        Ar << SpectrumBuffer;
+        Ar << KernelSpectrumBuffer;
+        Ar << OutputTexture;
+        return bShaderHasOutdatedParameters;
+    }
+
+    // Resources not read or written by the pass are ignored
+    template<typename TRHICmdList>
+    void SetParameters(
+        TRHICmdList& RHICmdList,
+        const FIntPoint& SizeValue,
+        const FIntPoint& FFTSizeValue,
+        const FIntPoint& BlockOriginValue,
+        const FIntPoint& BlockSizeValue,
+        const FIntPoint& KernelSizeValue,
+        bool bNormalizeKernel,
+        FTextureRHIParamRef SourceTextureRHI,
+        FTextureRHIParamRef KernelTextureRHI,
+        FUnorderedAccessViewRHIParamRef SpectrumUAV,
+        FShaderResourceViewRHIParamRef KernelSpectrumSRV,
+        FUnorderedAccessViewRHIParamRef OutputUAV
+        )
+    {
+        FComputeShaderRHIParamRef ShaderRHI = GetComputeShader();
+
+        SetShaderValue(RHICmdList, ShaderRHI, Size, SizeValue);
+        SetShaderValue(RHICmdList, ShaderRHI, FFTSize, FFTSizeValue);
+        SetShaderValue(RHICmdList, ShaderRHI, BlockOrigin, BlockOriginValue);
+        SetShaderValue(RHICmdList, ShaderRHI, BlockSize, BlockSizeValue);
+        SetShaderValue(RHICmdList, ShaderRHI, KernelSize, KernelSizeValue);
+        SetShaderValue(RHICmdList, ShaderRHI, NormalizeKernel, bNormalizeKernel ? 1u : 0u);
+        SetTextureParameter(RHICmdList, ShaderRHI, SourceTexture, SourceTextureRHI);
+        SetTextureParameter(RHICmdList, ShaderRHI, KernelTexture, KernelTextureRHI);
+        SetUAVParameter(RHICmdList, ShaderRHI, SpectrumBuffer, SpectrumUAV);
+        SetSRVParameter(RHICmdList, ShaderRHI, KernelSpectrumBuffer, KernelSpectrumSRV);
+        SetUAVParameter(RHICmdList, ShaderRHI, OutputTexture, OutputUAV);
+    }
+
+    template<typename TRHICmdList>
+    void UnbindBuffers(TRHICmdList& RHICmdList)
+    {
+        FComputeShaderRHIParamRef ShaderRHI = GetComputeShader();
+
+        SetUAVParameter(RHICmdList, ShaderRHI, SpectrumBuffer, nullptr);
+        SetUAVParameter(RHICmdList, ShaderRHI, OutputTexture, nullptr);
+    }
+
+private:
+
+    FShaderParameter Size;
+    FShaderParameter FFTSize;
+    FShaderParameter BlockOrigin;
+    FShaderParameter BlockSize;
+    FShaderParameter KernelSize;
+    FShaderParameter NormalizeKernel;
+    FShaderResourceParameter SourceTexture;
+    FShaderResourceParameter KernelTexture;
+    FShaderResourceParameter SpectrumBuffer;
+    FShaderResourceParameter KernelSpectrumBuffer;
+    FShaderResourceParameter OutputTexture;
+};
@@ -27,11 +27,67 @@
 
 #include "SUGGraphTask.h"
 #include "SUGGraph.h"
+#include "SUGGraphManager.h"
+#include "UObject/UnrealType.h"
+
+static void GatherPropertyInputTasks(const UProperty* Property, const void* ValuePtr, TArray<USUGGraphTask*>& OutTasks)
+{
+    if (const UStructProperty* StructProperty = Cast<const UStructProperty>(Property))
+    {
+        if (StructProperty->Struct == FSUGGraphTextureInput::StaticStruct())
+        {
+            USUGGraphTask* Task = static_cast<const FSUGGraphTextureInput*>(ValuePtr)->Task;
+
+            if (IsValid(Task))
+            {
+                OutTasks.AddUnique(Task);
+            }
+        }
+    }
+    else
+    if (const UObjectProperty* ObjectProperty = Cast<const UObjectProperty>(Property))
+    {
+        USUGGraphTask* Task = Cast<USUGGraphTask>(ObjectProperty->GetObjectPropertyValue(ValuePtr));
+
+        if (IsValid(Task))
+        {
+            OutTasks.AddUnique(Task);
+        }
+    }
+    else
+    if (const UArrayProperty* ArrayProperty = Cast<const UArrayProperty>(Property))
+    {
+        FScriptArrayHelper ArrayHelper(ArrayProperty, ValuePtr);
+
+        for (int32 i=0; i<ArrayHelper.Num(); ++i)
+        {
+            GatherPropertyInputTasks(ArrayProperty->Inner, ArrayHelper.GetRawPtr(i), OutTasks);
+        }
+    }
+    else
+    if (const UMapProperty* MapProperty = Cast<const UMapProperty>(Property))
+    {
+        FScriptMapHelper MapHelper(MapProperty, ValuePtr);
+
+        for (int32 i=0; i<MapHelper.GetMaxIndex(); ++i)
+        {
+            if (MapHelper.IsValidIndex(i))
+            {
+                GatherPropertyInputTasks(MapProperty->ValueProp, MapHelper.GetValuePtr(i), OutTasks);
+            }
+        }
+    }
+}
 
 USUGGraphTask::USUGGraphTask(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
     , ConfigMethod(RUL_CM_Parent)
     , bRequireOutput(true)
+    , FootprintRadius(0)
+    , bGenerateTileOccupancy(false)
+    , bSkipEmptyTiles(false)
+    , OccupancyTileSize(64)
+    , PersistentOutputRT(nullptr)
 {
 }
 
@@ -75,6 +131,422 @@ void USUGGraphTask::PostExecute(USUGGraph* Graph)
 
     // Clear output RT
     Output = FSUGGraphOutputRT();
+    bOutputElided = false;
+}
+
+int32 USUGGraphTask::GetFootprintRadius() const
+{
+    return FMath::Max(0, FootprintRadius);
+}
+
+void USUGGraphTask::GatherAssetReferences(TArray<FSoftObjectPath>& OutAssetPaths) const
+{
+    // Blank implementation
+}
+
+void USUGGraphTask::GatherInputTasks(TArray<USUGGraphTask*>& OutTasks) const
+{
+    // Output tasks are drawn over, not sampled
+    const FName OutputTaskName(GET_MEMBER_NAME_CHECKED(USUGGraphTask, OutputTask));
+
+    for (TFieldIterator<UProperty> It(GetClass()); It; ++It)
+    {
+        const UProperty* Property = *It;
+
+        if (Property->GetFName() == OutputTaskName ||
+            Property->HasAnyPropertyFlags(CPF_Transient))
+        {
+            continue;
+        }
+
+        for (int32 i=0; i<Property->ArrayDim; ++i)
+        {
+            GatherPropertyInputTasks(Property, Property->ContainerPtrToValuePtr<void>(this, i), OutTasks);
+        }
+    }
+
+    OutTasks.Remove(const_cast<USUGGraphTask*>(this));
+}
+
+void USUGGraphTask::GatherMaterialWarmUpEntries(const USUGGraph& Graph, TArray<FSUGGraphMaterialWarmUpEntry>& OutEntries) const
+{
+    // Blank implementation
+}
+
+bool USUGGraphTask::RequiresUAVOutput() const
+{
+    return false;
+}
+
+void USUGGraphTask::ResolveFusion(USUGGraph& Graph)
+{
+    // Blank implementation
+}
+
+bool USUGGraphTask::SupportsRegionExecution() const
+{
+    return false;
+}
+
+void USUGGraphTask::MarkDirty()
+{
+    bPendingFullDirty = true;
+}
+
+void USUGGraphTask::MarkDirtyRegion(FIntPoint RegionMin, FIntPoint RegionMax)
+{
+    const FIntRect Region(RegionMin.ComponentMin(RegionMax), RegionMin.ComponentMax(RegionMax));
+
+    if (Region.Area() <= 0)
+    {
+        return;
+    }
+
+    if (bHasPendingDirtyRegion)
+    {
+        PendingDirtyRegion.Union(Region);
+    }
+    else
+    {
+        PendingDirtyRegion = Region;
+        bHasPendingDirtyRegion = true;
+    }
+}
+
+void USUGGraphTask::ResolveTileOccupancy(const USUGGraph& Graph)
+{
+    TileOccupancy.Reset();
+
+    // Tasks drawing on top of another task output can't clear skipped tiles.
+    // Tasks without region execution still render every tile but pass
+    // input occupancy on to dependant tasks.
+    if (! bSkipEmptyTiles || IsValid(OutputTask))
+    {
+        return;
+    }
+
+    TileOccupancy.Init(ResolvedOutputConfig.GetDimension(), OccupancyTileSize);
+
+    // Output occupancy is the union of task input occupancies dilated by
+    // the task footprint, inputs without occupancy occupy every tile
+
+    const int32 Footprint = GetFootprintRadius();
+    int32 InputCount = 0;
+
+    for (const auto& Dependency : DependencyMap)
+    {
+        const USUGGraphTask* InputTask = Dependency.Value.Task;
+
+        if (! IsValid(InputTask))
+        {
+            continue;
+        }
+        else
+        if (! InputTask->GetTileOccupancy().IsValid())
+        {
+            TileOccupancy.Reset();
+            return;
+        }
+
+        TileOccupancy.MergeOccupancy(InputTask->GetTileOccupancy(), Footprint);
+        ++InputCount;
+    }
+
+    if (InputCount == 0)
+    {
+        TileOccupancy.Reset();
+    }
+}
+
+void USUGGraphTask::GenerateTileOccupancy(const USUGGraph& Graph, const TArray<FBox2D>& Bounds)
+{
+    TileOccupancy.Init(ResolvedOutputConfig.GetDimension(), OccupancyTileSize);
+
+    // Bounds are specified in graph domain pixels, translate to tile
+    // render region during tiled execution
+    const FIntPoint Offset = Graph.IsTiledExecution()
+        ? Graph.ExecutionTile.RenderRect.Min
+        : FIntPoint::ZeroValue;
+
+    for (const FBox2D& Box : Bounds)
+    {
+        if (Box.bIsValid)
+        {
+            const FIntRect Rect(
+                FMath::FloorToInt(Box.Min.X) - Offset.X,
+                FMath::FloorToInt(Box.Min.Y) - Offset.Y,
+                FMath::CeilToInt(Box.Max.X) - Offset.X,
+                FMath::CeilToInt(Box.Max.Y) - Offset.Y
+                );
+
+            TileOccupancy.MarkRect(Rect);
+        }
+    }
+}
+
+bool USUGGraphTask::HasSparseTileOccupancy() const
+{
+    return bSkipEmptyTiles && SupportsRegionExecution() && ! TileOccupancy.IsFullyOccupied();
+}
+
+bool USUGGraphTask::IsPartialExecutionRegion() const
+{
+    const FIntRect FullRegion(FIntPoint::ZeroValue, ResolvedOutputConfig.GetDimension());
+    return bHasExecutionRegion && ExecutionRegion != FullRegion;
+}
+
+uint32 USUGGraphTask::CalculateStateHash(FTaskHashMap* TaskHashMap) const
+{
+    // Hash values of editable properties. Transient properties only hold
+    // per execution state and are skipped.
+
+    uint32 StateHash = 0;
+
+    for (TFieldIterator<UProperty> It(GetClass()); It; ++It)
+    {
+        const UProperty* Property = *It;
+
+        if (Property->HasAnyPropertyFlags(CPF_Edit | CPF_BlueprintVisible) &&
+            ! Property->HasAnyPropertyFlags(CPF_Transient))
+        {
+            for (int32 i=0; i<Property->ArrayDim; ++i)
+            {
+                StateHash = HashPropertyValue(*Property, Property->ContainerPtrToValuePtr<void>(this, i), StateHash, TaskHashMap);
+            }
+        }
+    }
+
+    return StateHash;
+}
+
+uint32 USUGGraphTask::CalculatePropertyHash(FName PropertyName, FTaskHashMap* TaskHashMap) const
+{
+    const UProperty* Property = FindField<UProperty>(GetClass(), PropertyName);
+    uint32 PropertyHash = 0;
+
+    if (Property)
+    {
+        for (int32 i=0; i<Property->ArrayDim; ++i)
+        {
+            PropertyHash = HashPropertyValue(*Property, Property->ContainerPtrToValuePtr<void>(this, i), PropertyHash, TaskHashMap);
+        }
+    }
+
+    return PropertyHash;
+}
+
+uint32 USUGGraphTask::HashPropertyValue(const UProperty& Property, const void* ValuePtr, uint32 Hash, FTaskHashMap* TaskHashMap)
+{
+    // Task references are hashed by the referenced task state if a task hash
+    // map is specified, equal task chains hash equal across graph preparations
+
+    const UObjectPropertyBase* ObjectProperty = TaskHashMap ? Cast<const UObjectPropertyBase>(&Property) : nullptr;
+    const USUGGraphTask* Task = ObjectProperty ? Cast<const USUGGraphTask>(ObjectProperty->GetObjectPropertyValue(ValuePtr)) : nullptr;
+
+    if (Task)
+    {
+        if (const uint32* CachedTaskHash = TaskHashMap->Find(Task))
+        {
+            return HashCombine(Hash, *CachedTaskHash);
+        }
+
+        // Guard against cyclic inputs
+        TaskHashMap->Emplace(Task, 0);
+
+        const uint32 TaskHash = HashCombine(GetTypeHash(Task->GetClass()->GetFName()), Task->CalculateStateHash(TaskHashMap));
+        TaskHashMap->Emplace(Task, TaskHash);
+
+        return HashCombine(Hash, TaskHash);
+    }
+
+    // Hash property memory directly where possible, text export is only
+    // used for properties without a value hash
+
+    if (const UBoolProperty* BoolProperty = Cast<const UBoolProperty>(&Property))
+    {
+        return HashCombine(Hash, BoolProperty->GetPropertyValue(ValuePtr) ? 1u : 0u);
+    }
+    else
+    if (Property.HasAnyPropertyFlags(CPF_IsPlainOldData))
+    {
+        return FCrc::MemCrc32(ValuePtr, Property.ElementSize, Hash);
+    }
+    else
+    if (Property.HasAnyPropertyFlags(CPF_HasGetValueTypeHash))
+    {
+        return HashCombine(Hash, Property.GetValueTypeHash(ValuePtr));
+    }
+    else
+    if (const UStructProperty* StructProperty = Cast<const UStructProperty>(&Property))
+    {
+        for (TFieldIterator<UProperty> It(StructProperty->Struct); It; ++It)
+        {
+            for (int32 i=0; i<It->ArrayDim; ++i)
+            {
+                Hash = HashPropertyValue(**It, It->ContainerPtrToValuePtr<void>(ValuePtr, i), Hash, TaskHashMap);
+            }
+        }
+
+        return Hash;
+    }
+    else
+    if (const UArrayProperty* ArrayProperty = Cast<const UArrayProperty>(&Property))
+    {
+        FScriptArrayHelper ArrayHelper(ArrayProperty, ValuePtr);
+        Hash = HashCombine(Hash, uint32(ArrayHelper.Num()));
+
+        for (int32 i=0; i<ArrayHelper.Num(); ++i)
+        {
+            Hash = HashPropertyValue(*ArrayProperty->Inner, ArrayHelper.GetRawPtr(i), Hash, TaskHashMap);
+        }
+
+        return Hash;
+    }
+    else
+    if (const UMapProperty* MapProperty = Cast<const UMapProperty>(&Property))
+    {
+        FScriptMapHelper MapHelper(MapProperty, ValuePtr);
+        Hash = HashCombine(Hash, uint32(MapHelper.Num()));
+
+        for (int32 i=0; i<MapHelper.GetMaxIndex(); ++i)
+        {
+            if (MapHelper.IsValidIndex(i))
+            {
+                Hash = HashPropertyValue(*MapProperty->KeyProp, MapHelper.GetKeyPtr(i), Hash, TaskHashMap);
+                Hash = HashPropertyValue(*MapProperty->ValueProp, MapHelper.GetValuePtr(i), Hash, TaskHashMap);
+            }
+        }
+
+        return Hash;
+    }
+
+    FString ValueString;
+    Property.ExportTextItem(ValueString, ValuePtr, nullptr, nullptr, PPF_None);
+
+    return FCrc::StrCrc32(*ValueString, Hash);
+}
+
+void USUGGraphTask::MarkChangedRegions(const USUGGraph& Graph)
+{
+    // Blank implementation
+}
+
+void USUGGraphTask::ResolveExecutionRegion(bool bForceFullRegion)
+{
+    const FIntPoint OutputDimension(ResolvedOutputConfig.GetDimension());
+    const FIntRect FullRegion(FIntPoint::ZeroValue, OutputDimension);
+
+    bool bFullRegion = bForceFullRegion || bPendingFullDirty || ! bHasIncrementalState;
+    bool bHasRegion = bHasPendingDirtyRegion;
+    FIntRect Region(PendingDirtyRegion);
+
+    // Property changes without explicitly marked regions (and texture
+    // content changes, which are not tracked) require re-rendering the
+    // whole output
+    const uint32 StateHash = CalculateStateHash();
+
+    if (StateHash != LastStateHash && ! bHasPendingDirtyRegion)
+    {
+        bFullRegion = true;
+    }
+
+    // Accumulate input regions, scaled to output dimension and expanded by
+    // the task footprint
+
+    const int32 Footprint = GetFootprintRadius();
+
+    for (const auto& Dependency : DependencyMap)
+    {
+        const USUGGraphTask* InputTask = Dependency.Value.Task;
+
+        if (bFullRegion)
+        {
+            break;
+        }
+        else
+        if (! IsValid(InputTask) || ! InputTask->HasExecutionRegion())
+        {
+            continue;
+        }
+        else
+        if (! InputTask->IsPartialExecutionRegion())
+        {
+            bFullRegion = true;
+            break;
+        }
+
+        const FIntPoint InputDimension(InputTask->ResolvedOutputConfig.GetDimension());
+        const FIntRect& InputRegion(InputTask->GetExecutionRegion());
+        const float ScaleX = float(OutputDimension.X) / FMath::Max(1, InputDimension.X);
+        const float ScaleY = float(OutputDimension.Y) / FMath::Max(1, InputDimension.Y);
+
+        FIntRect ScaledRegion(
+            FMath::FloorToInt(InputRegion.Min.X * ScaleX),
+            FMath::FloorToInt(InputRegion.Min.Y * ScaleY),
+            FMath::CeilToInt(InputRegion.Max.X * ScaleX),
+            FMath::CeilToInt(InputRegion.Max.Y * ScaleY)
+            );
+        ScaledRegion.InflateRect(Footprint);
+
+        if (bHasRegion)
+        {
+            Region.Union(ScaledRegion);
+        }
+        else
+        {
+            Region = ScaledRegion;
+            bHasRegion = true;
+        }
+    }
+
+    if (bFullRegion)
+    {
+        Region = FullRegion;
+        bHasRegion = true;
+    }
+    else
+    if (bHasRegion)
+    {
+        Region.Clip(FullRegion);
+    }
+
+    ExecutionRegion = bHasRegion ? Region : FIntRect();
+    bHasExecutionRegion = bHasRegion && Region.Area() > 0;
+
+    LastStateHash = StateHash;
+    PendingDirtyRegion = FIntRect();
+    bHasPendingDirtyRegion = false;
+    bPendingFullDirty = false;
+    bHasIncrementalState = true;
+}
+
+void USUGGraphTask::ResetIncrementalState()
+{
+    PersistentOutputRT = nullptr;
+    ExecutionRegion = FIntRect();
+    bHasExecutionRegion = false;
+    bHasIncrementalState = false;
+}
+
+bool USUGGraphTask::AssignPersistentOutput(USUGGraphManager& GraphManager, const FRULShaderOutputConfig& OutputConfig)
+{
+    bool bReallocated = false;
+
+    const bool bRequireUAV = RequiresUAVOutput();
+
+    if (! IsValid(PersistentOutputRT) ||
+        ! FSUGGraphOutputRT::CompareFormat(*PersistentOutputRT, OutputConfig) ||
+        (bRequireUAV && ! PersistentOutputRT->bCanCreateUAV))
+    {
+        PersistentOutputRT = bRequireUAV
+            ? GraphManager.CreateUAVOutputRenderTarget(OutputConfig)
+            : GraphManager.CreateOutputRenderTarget(OutputConfig);
+        bReallocated = true;
+    }
+
+    Output = FSUGGraphOutputRT(PersistentOutputRT);
+
+    return bReallocated;
 }
 
 void USUGGraphTask::SetOutputTask(USUGGraphTask* InOutputTask)
@@ -0,0 +1,431 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+#include "SUGGraphTileStreamer.h"
+#include "Engine/TextureRenderTarget2D.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "GameFramework/PlayerController.h"
+#include "SUGGraph.h"
+
+USUGGraphTileStreamer::USUGGraphTileStreamer(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+    PrimaryComponentTick.bCanEverTick = true;
+    PrimaryComponentTick.bStartWithTickEnabled = true;
+}
+
+void USUGGraphTileStreamer::TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+    Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+    UpdatePendingTiles();
+
+    TArray<FVector> SourceLocations;
+    GatherStreamingSources(SourceLocations);
+
+    if (SourceLocations.Num() <= 0)
+    {
+        return;
+    }
+
+    EvictTiles(SourceLocations);
+
+    TArray<FTileRequest> Requests;
+    GatherRequiredTiles(SourceLocations, Requests);
+
+    // Record request time of newly required tiles and drop request times of
+    // tiles that left the streaming radius before being generated
+
+    const double CurrentTime = FPlatformTime::Seconds();
+    TMap<FIntPoint, double> RequiredTimeMap;
+
+    for (const FTileRequest& Request : Requests)
+    {
+        const double* RequestTime = RequestTimeMap.Find(Request.Coordinates);
+        RequiredTimeMap.Emplace(Request.Coordinates, RequestTime ? *RequestTime : CurrentTime);
+    }
+
+    RequestTimeMap = MoveTemp(RequiredTimeMap);
+
+    // Generate closest tiles first within memory budget
+
+    const int64 MemoryBudget = int64(MemoryBudgetMB) * 1024 * 1024;
+    const int64 EstimatedTileSize = TileCache.Num() > 0 ? (CacheMemorySize / TileCache.Num()) : 0;
+
+    int32 GeneratedCount = 0;
+
+    for (const FTileRequest& Request : Requests)
+    {
+        // Wait for assets referenced by the tile graph to be streamed in
+        if (GeneratedCount >= MaxTilesPerFrame || IsAssetPreloadPending())
+        {
+            break;
+        }
+
+        // Make room by evicting farther tiles, stop if all cached tiles are
+        // closer than the requested tile
+        bool bHasMemory = true;
+
+        while (MemoryBudget > 0 && (CacheMemorySize+EstimatedTileSize) > MemoryBudget && TileCache.Num() > 0)
+        {
+            FIntPoint FarthestTile(FIntPoint::ZeroValue);
+            float FarthestDistanceSq = -1.f;
+
+            for (const auto& TilePair : TileCache)
+            {
+                const float DistanceSq = GetTileDistanceSq(TilePair.Key, SourceLocations);
+
+                if (DistanceSq > FarthestDistanceSq)
+                {
+                    FarthestTile = TilePair.Key;
+                    FarthestDistanceSq = DistanceSq;
+                }
+            }
+
+            if (FarthestDistanceSq > Request.DistanceSq)
+            {
+                EvictTile(FarthestTile);
+            }
+            else
+            {
+                bHasMemory = false;
+                break;
+            }
+        }
+
+        if (! bHasMemory)
+        {
+            break;
+        }
+
+        GenerateTile(Request.Coordinates);
+        ++GeneratedCount;
+    }
+}
+
+UTextureRenderTarget2D* USUGGraphTileStreamer::CreateOutputRenderTarget(const FRULShaderOutputConfig& OutputConfig)
+{
+    // Reuse output render target of evicted tiles
+    for (int32 i=FreeOutputRTs.Num()-1; i>=0; --i)
+    {
+        UTextureRenderTarget2D* RenderTarget = FreeOutputRTs[i];
+
+        if (IsValid(RenderTarget) && FSUGGraphOutputRT::CompareFormat(*RenderTarget, OutputConfig))
+        {
+            FreeOutputRTs.RemoveAtSwap(i, 1, false);
+            return RenderTarget;
+        }
+    }
+
+    return Super::CreateOutputRenderTarget(OutputConfig);
+}
+
+FIntPoint USUGGraphTileStreamer::GetTileCoordinates(const FVector& WorldLocation) const
+{
+    const float InvTileSize = 1.f / FMath::Max(1.f, TileSize);
+
+    return FIntPoint(
+        FMath::FloorToInt(WorldLocation.X * InvTileSize),
+        FMath::FloorToInt(WorldLocation.Y * InvTileSize)
+        );
+}
+
+bool USUGGraphTileStreamer::HasTile(FIntPoint TileCoordinates) const
+{
+    return TileCache.Contains(TileCoordinates);
+}
+
+UTextureRenderTarget2D* USUGGraphTileStreamer::GetTileOutput(FIntPoint TileCoordinates, FName OutputName) const
+{
+    const FSUGGraphStreamedTile* StreamedTile = TileCache.Find(TileCoordinates);
+    return StreamedTile ? StreamedTile->Outputs.FindRef(OutputName) : nullptr;
+}
+
+float USUGGraphTileStreamer::GetTileGenerationLatency(FIntPoint TileCoordinates) const
+{
+    const FSUGGraphStreamedTile* StreamedTile = TileCache.Find(TileCoordinates);
+    return StreamedTile ? StreamedTile->GenerationLatency : -1.f;
+}
+
+void USUGGraphTileStreamer::ClearTiles()
+{
+    TArray<FIntPoint> CachedTiles;
+    TileCache.GetKeys(CachedTiles);
+
+    for (const FIntPoint& Coordinates : CachedTiles)
+    {
+        EvictTile(Coordinates);
+    }
+
+    FreeOutputRTs.Empty();
+    RequestTimeMap.Empty();
+}
+
+void USUGGraphTileStreamer::GatherStreamingSources(TArray<FVector>& OutLocations) const
+{
+    UWorld* World = GetWorld();
+
+    if (bUsePlayerViewsAsStreamingSources && IsValid(World))
+    {
+        for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+        {
+            APlayerController* PlayerController = It->Get();
+
+            if (IsValid(PlayerController))
+            {
+                FVector ViewLocation;
+                FRotator ViewRotation;
+                PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+                OutLocations.Emplace(ViewLocation);
+            }
+        }
+    }
+
+    for (const AActor* SourceActor : StreamingSources)
+    {
+        if (IsValid(SourceActor))
+        {
+            OutLocations.Emplace(SourceActor->GetActorLocation());
+        }
+    }
+}
+
+void USUGGraphTileStreamer::GatherRequiredTiles(const TArray<FVector>& SourceLocations, TArray<FTileRequest>& OutRequests) const
+{
+    const float Radius = FMath::Max(0.f, StreamingRadius);
+    const float RadiusSq = Radius * Radius;
+
+    TSet<FIntPoint> RequiredTiles;
+
+    for (const FVector& Location : SourceLocations)
+    {
+        const FIntPoint MinTile = GetTileCoordinates(Location - FVector(Radius, Radius, 0.f));
+        const FIntPoint MaxTile = GetTileCoordinates(Location + FVector(Radius, Radius, 0.f));
+
+        for (int32 y=MinTile.Y; y<=MaxTile.Y; ++y)
+        for (int32 x=MinTile.X; x<=MaxTile.X; ++x)
+        {
+            const FIntPoint Coordinates(x, y);
+            const FVector2D TileCenter((x+.5f)*TileSize, (y+.5f)*TileSize);
+
+            if (FVector2D::DistSquared(TileCenter, FVector2D(Location)) <= RadiusSq && ! TileCache.Contains(Coordinates))
+            {
+                RequiredTiles.Emplace(Coordinates);
+            }
+        }
+    }
+
+    OutRequests.Reserve(RequiredTiles.Num());
+
+    for (const FIntPoint& Coordinates : RequiredTiles)
+    {
+        FTileRequest Request;
+        Request.Coordinates = Coordinates;
+        Request.DistanceSq = GetTileDistanceSq(Coordinates, SourceLocations);
+        OutRequests.Emplace(Request);
+    }
+
+    OutRequests.Sort(
+        [](const FTileRequest& A, const FTileRequest& B)
+        {
+            return A.DistanceSq < B.DistanceSq;
+        } );
+}
+
+void USUGGraphTileStreamer::GenerateTile(const FIntPoint& Coordinates)
+{
+    UClass* GraphClass = *GraphType;
+
+    if (! IsValid(GraphClass))
+    {
+        UE_LOG(LogSGP,Warning, TEXT("USUGGraphTileStreamer::GenerateTile() ABORTED, INVALID GRAPH TYPE"));
+        return;
+    }
+
+    if (! IsValid(TileGraph) || TileGraph->GetClass() != GraphClass)
+    {
+        TileGraph = NewObject<USUGGraph>(this, GraphClass);
+    }
+
+    // Every tile is generated from scratch, retained task outputs of the
+    // previous tile would not match the new tile
+    TileGraph->bIncrementalExecution = false;
+
+    FSUGGraphStreamingTile& Tile(TileGraph->StreamingTile);
+    Tile.Coordinates = Coordinates;
+    Tile.Origin = FVector2D(Coordinates.X * TileSize, Coordinates.Y * TileSize);
+    Tile.Size = TileSize;
+
+    // Detach outputs of the previously generated tile, the graph will
+    // acquire new or recycled output render targets
+    for (auto& OutputPair : TileGraph->OutputMap)
+    {
+        OutputPair.Value.RenderTarget = nullptr;
+        OutputPair.Value.BackRenderTarget = nullptr;
+    }
+
+    ExecuteGraph(TileGraph);
+
+    // Tile graph execution deferred by asset preload or shader compilation,
+    // generate the tile again once the graph is ready
+    if (IsExecutionDeferred())
+    {
+        DiscardDeferredExecution();
+        return;
+    }
+
+    FSUGGraphStreamedTile StreamedTile;
+    StreamedTile.Tile = Tile;
+
+    for (const auto& OutputPair : TileGraph->OutputMap)
+    {
+        UTextureRenderTarget2D* RenderTarget = OutputPair.Value.RenderTarget;
+
+        if (IsValid(RenderTarget))
+        {
+            StreamedTile.Outputs.Emplace(OutputPair.Key, RenderTarget);
+            StreamedTile.MemorySize += GetRenderTargetMemorySize(RenderTarget);
+        }
+    }
+
+    const double* RequestTime = RequestTimeMap.Find(Coordinates);
+    StreamedTile.RequestTime = RequestTime ? *RequestTime : FPlatformTime::Seconds();
+    StreamedTile.bGenerationPending = true;
+    RequestTimeMap.Remove(Coordinates);
+
+    CacheMemorySize += StreamedTile.MemorySize;
+
+    FSUGGraphStreamedTile& CachedTile(TileCache.Emplace(Coordinates, StreamedTile));
+    CachedTile.GenerationFence.BeginFence();
+}
+
+void USUGGraphTileStreamer::UpdatePendingTiles()
+{
+    const double CurrentTime = FPlatformTime::Seconds();
+
+    TArray<FIntPoint> GeneratedTiles;
+
+    for (auto& TilePair : TileCache)
+    {
+        FSUGGraphStreamedTile& StreamedTile(TilePair.Value);
+
+        if (StreamedTile.bGenerationPending && StreamedTile.GenerationFence.IsFenceComplete())
+        {
+            StreamedTile.GenerationLatency = CurrentTime - StreamedTile.RequestTime;
+            StreamedTile.bGenerationPending = false;
+            GeneratedTiles.Emplace(TilePair.Key);
+        }
+    }
+
+    for (const FIntPoint& Coordinates : GeneratedTiles)
+    {
+        OnTileGenerated.Broadcast(Coordinates, TileCache.FindChecked(Coordinates).GenerationLatency);
+    }
+}
+
+void USUGGraphTileStreamer::EvictTiles(const TArray<FVector>& SourceLocations)
+{
+    const float EvictionRadiusSq = FMath::Square(FMath::Max(EvictionRadius, StreamingRadius));
+
+    TArray<FIntPoint> EvictedTiles;
+
+    for (const auto& TilePair : TileCache)
+    {
+        if (GetTileDistanceSq(TilePair.Key, SourceLocations) > EvictionRadiusSq)
+        {
+            EvictedTiles.Emplace(TilePair.Key);
+        }
+    }
+
+    for (const FIntPoint& Coordinates : EvictedTiles)
+    {
+        EvictTile(Coordinates);
+    }
+
+    // Release free render targets that no longer fit the memory budget
+
+    const int64 MemoryBudget = int64(MemoryBudgetMB) * 1024 * 1024;
+    int64 TotalMemorySize = CacheMemorySize;
+
+    for (int32 i=0; i<FreeOutputRTs.Num(); ++i)
+    {
+        const int64 MemorySize = GetRenderTargetMemorySize(FreeOutputRTs[i]);
+
+        if (MemoryBudget > 0 && (TotalMemorySize+MemorySize) > MemoryBudget)
+        {
+            FreeOutputRTs.SetNum(i, false);
+            break;
+        }
+
+        TotalMemorySize += MemorySize;
+    }
+}
+
+void USUGGraphTileStreamer::EvictTile(const FIntPoint& Coordinates)
+{
+    FSUGGraphStreamedTile StreamedTile;
+
+    if (TileCache.RemoveAndCopyValue(Coordinates, StreamedTile))
+    {
+        for (const auto& OutputPair : StreamedTile.Outputs)
+        {
+            if (IsValid(OutputPair.Value))
+            {
+                FreeOutputRTs.Emplace(OutputPair.Value);
+            }
+        }
+
+        CacheMemorySize -= StreamedTile.MemorySize;
+
+        OnTileEvicted.Broadcast(Coordinates);
+    }
+}
+
+float USUGGraphTileStreamer::GetTileDistanceSq(const FIntPoint& Coordinates, const TArray<FVector>& SourceLocations) const
+{
+    const FVector2D TileCenter((Coordinates.X+.5f)*TileSize, (Coordinates.Y+.5f)*TileSize);
+    float DistanceSq = TNumericLimits<float>::Max();
+
+    for (const FVector& Location : SourceLocations)
+    {
+        DistanceSq = FMath::Min(DistanceSq, FVector2D::DistSquared(TileCenter, FVector2D(Location)));
+    }
+
+    return DistanceSq;
+}
+
+int64 USUGGraphTileStreamer::GetRenderTargetMemorySize(const UTextureRenderTarget2D* RenderTarget)
+{
+    if (IsValid(RenderTarget))
+    {
+        const EPixelFormat Format = RenderTarget->GetFormat();
+        return int64(RenderTarget->SizeX) * int64(RenderTarget->SizeY) * GPixelFormats[Format].BlockBytes;
+    }
+
+    return 0;
+}
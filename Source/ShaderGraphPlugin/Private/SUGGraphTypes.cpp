@@ -26,6 +26,9 @@
 // 
 
 #include "SUGGraphTypes.h"
+#include "Algo/BinarySearch.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "Materials/MaterialInterface.h"
 
 FSUGGraphTaskConfig::FSUGGraphTaskConfig()
 {
@@ -56,11 +59,16 @@ bool FSUGGraphOutputRT::IsValidOutput() const
 }
 
 bool FSUGGraphOutputRT::CompareFormat(const FRULShaderOutputConfig& OutputConfig) const
+{
+    return CompareFormat(*RenderTarget, OutputConfig);
+}
+
+bool FSUGGraphOutputRT::CompareFormat(const UTextureRenderTarget2D& RenderTarget, const FRULShaderOutputConfig& OutputConfig)
 {
     return (
-        RenderTarget->SizeX == OutputConfig.SizeX &&
-        RenderTarget->SizeY == OutputConfig.SizeY &&
-        RenderTarget->GetFormat() == GetPixelFormatFromRenderTargetFormat(OutputConfig.Format)
+        RenderTarget.SizeX == OutputConfig.SizeX &&
+        RenderTarget.SizeY == OutputConfig.SizeY &&
+        RenderTarget.GetFormat() == GetPixelFormatFromRenderTargetFormat(OutputConfig.Format)
         );
 }
 
@@ -77,5 +85,469 @@ void FSUGGraphOutputRT::CreateReferenceId()
 
 bool FSUGGraphTextureInput::HasValidInput() const
 {
-    return IsValid(Texture) || IsValid(Task);
+    return IsValid(Texture) || ! SoftTexture.IsNull() || IsValid(Task);
+}
+
+UTexture* FSUGGraphTextureInput::GetTexture() const
+{
+    return IsValid(Texture) ? Texture : SoftTexture.Get();
+}
+
+void FSUGGraphTextureInput::GatherAssetReferences(TArray<FSoftObjectPath>& OutAssetPaths) const
+{
+    if (! IsValid(Texture) && SoftTexture.IsPending())
+    {
+        OutAssetPaths.AddUnique(SoftTexture.ToSoftObjectPath());
+    }
+}
+
+bool FSUGGraphSimulationState::IsValidState(int32 TextureCount, const FRULShaderOutputConfig& StateConfig) const
+{
+    if (StateTextures.Num() != TextureCount)
+    {
+        return false;
+    }
+
+    for (const UTextureRenderTarget2D* StateTexture : StateTextures)
+    {
+        if (! IsValid(StateTexture) || ! FSUGGraphOutputRT::CompareFormat(*StateTexture, StateConfig))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void FSUGGraphSimulationState::Reset()
+{
+    StateTextures.Reset();
+    Restart();
+}
+
+void FSUGGraphSimulationState::Restart()
+{
+    StepCount = 0;
+    SourceHash = 0;
+}
+
+UMaterialInterface* FSUGGraphMaterialRef::GetMaterial() const
+{
+    return IsValid(Material) ? Material : SoftMaterial.Get();
+}
+
+void FSUGGraphMaterialRef::GatherAssetReferences(TArray<FSoftObjectPath>& OutAssetPaths) const
+{
+    if (! IsValid(Material) && SoftMaterial.IsPending())
+    {
+        OutAssetPaths.AddUnique(SoftMaterial.ToSoftObjectPath());
+    }
+}
+
+static int32 FindSortedParameterIndex(const TArray<FName>& Names, FName ParameterName)
+{
+    return Algo::LowerBound(Names, ParameterName,
+        [](const FName& A, const FName& B)
+        {
+            return A.CompareIndexes(B) < 0;
+        } );
+}
+
+template<typename ValueType>
+static int32 SetSortedParameter(TArray<FName>& Names, TArray<ValueType>& Values, FName ParameterName, const ValueType& Value, bool& bOutInserted)
+{
+    const int32 Index = FindSortedParameterIndex(Names, ParameterName);
+
+    bOutInserted = false;
+
+    if (Names.IsValidIndex(Index) && Names[Index] == ParameterName)
+    {
+        if (Values[Index] == Value)
+        {
+            return INDEX_NONE;
+        }
+
+        Values[Index] = Value;
+    }
+    else
+    {
+        Names.Insert(ParameterName, Index);
+        Values.Insert(Value, Index);
+        bOutInserted = true;
+    }
+
+    return Index;
+}
+
+void FSUGGraphParameterBlock::SetScalar(FName ParameterName, float Value)
+{
+    bool bInserted;
+    const int32 Index = SetSortedParameter(ScalarNames, ScalarValues, ParameterName, Value, bInserted);
+
+    if (bInserted)
+    {
+        bLayoutDirty = true;
+        ++LayoutVersion;
+    }
+    else
+    if (Index != INDEX_NONE && DirtyScalars.IsValidIndex(Index))
+    {
+        DirtyScalars[Index] = true;
+    }
+}
+
+void FSUGGraphParameterBlock::SetVector(FName ParameterName, const FLinearColor& Value)
+{
+    bool bInserted;
+    const int32 Index = SetSortedParameter(VectorNames, VectorValues, ParameterName, Value, bInserted);
+
+    if (bInserted)
+    {
+        bLayoutDirty = true;
+        ++LayoutVersion;
+    }
+    else
+    if (Index != INDEX_NONE && DirtyVectors.IsValidIndex(Index))
+    {
+        DirtyVectors[Index] = true;
+    }
+}
+
+void FSUGGraphParameterBlock::SetTexture(FName ParameterName, const FSUGGraphTextureInput& Value)
+{
+    bool bInserted;
+    SetSortedParameter(TextureNames, TextureInputs, ParameterName, Value, bInserted);
+
+    // Texture inputs are resolved and compared on every application
+    if (bInserted)
+    {
+        bLayoutDirty = true;
+        ++LayoutVersion;
+    }
+}
+
+void FSUGGraphParameterBlock::RemoveTexture(FName ParameterName)
+{
+    const int32 Index = FindSortedParameterIndex(TextureNames, ParameterName);
+
+    if (TextureNames.IsValidIndex(Index) && TextureNames[Index] == ParameterName)
+    {
+        TextureNames.RemoveAt(Index);
+        TextureInputs.RemoveAt(Index);
+
+        if (ResolvedTextures.IsValidIndex(Index))
+        {
+            ResolvedTextures.RemoveAt(Index);
+        }
+
+        bLayoutDirty = true;
+        ++LayoutVersion;
+    }
+}
+
+void FSUGGraphParameterBlock::Reset()
+{
+    ScalarNames.Reset();
+    ScalarValues.Reset();
+    VectorNames.Reset();
+    VectorValues.Reset();
+    TextureNames.Reset();
+    TextureInputs.Reset();
+    ResolvedTextures.Reset();
+    bLayoutDirty = true;
+    ++LayoutVersion;
+}
+
+void FSUGGraphParameterBlock::ClearDirty()
+{
+    DirtyScalars.Init(false, ScalarNames.Num());
+    DirtyVectors.Init(false, VectorNames.Num());
+    bLayoutDirty = false;
+}
+
+float FSUGGraphParameterBlock::GetScalar(FName ParameterName, float DefaultValue) const
+{
+    const int32 Index = FindSortedParameterIndex(ScalarNames, ParameterName);
+
+    return (ScalarNames.IsValidIndex(Index) && ScalarNames[Index] == ParameterName)
+        ? ScalarValues[Index]
+        : DefaultValue;
+}
+
+UTexture* FSUGGraphParameterBlock::GetResolvedTexture(FName ParameterName) const
+{
+    const int32 Index = FindSortedParameterIndex(TextureNames, ParameterName);
+
+    return (TextureNames.IsValidIndex(Index) && TextureNames[Index] == ParameterName && ResolvedTextures.IsValidIndex(Index))
+        ? ResolvedTextures[Index]
+        : nullptr;
+}
+
+void FSUGGraphTileOccupancy::Init(const FIntPoint& InDimension, int32 InTileSize)
+{
+    Dimension = InDimension.ComponentMax(FIntPoint(1, 1));
+    TileSize = FMath::Max(1, InTileSize);
+    TileCount.X = FMath::DivideAndRoundUp(Dimension.X, TileSize);
+    TileCount.Y = FMath::DivideAndRoundUp(Dimension.Y, TileSize);
+    OccupiedTiles.Init(false, TileCount.X * TileCount.Y);
+}
+
+void FSUGGraphTileOccupancy::Reset()
+{
+    Dimension = FIntPoint::ZeroValue;
+    TileCount = FIntPoint::ZeroValue;
+    TileSize = 0;
+    OccupiedTiles.Empty();
+}
+
+bool FSUGGraphTileOccupancy::IsFullyOccupied() const
+{
+    return ! IsValid() || OccupiedTiles.Find(false) == INDEX_NONE;
+}
+
+void FSUGGraphTileOccupancy::MarkRect(const FIntRect& Rect)
+{
+    if (! IsValid())
+    {
+        return;
+    }
+
+    FIntRect ClippedRect(Rect);
+    ClippedRect.Clip(FIntRect(FIntPoint::ZeroValue, Dimension));
+
+    if (ClippedRect.Area() <= 0)
+    {
+        return;
+    }
+
+    const FIntPoint TileMin(ClippedRect.Min / TileSize);
+    const FIntPoint TileMax(
+        FMath::DivideAndRoundUp(ClippedRect.Max.X, TileSize),
+        FMath::DivideAndRoundUp(ClippedRect.Max.Y, TileSize)
+        );
+
+    for (int32 TileY=TileMin.Y; TileY<TileMax.Y; ++TileY)
+    for (int32 TileX=TileMin.X; TileX<TileMax.X; ++TileX)
+    {
+        OccupiedTiles[TileY*TileCount.X + TileX] = true;
+    }
+}
+
+void FSUGGraphTileOccupancy::MergeOccupancy(const FSUGGraphTileOccupancy& Occupancy, int32 DilationRadius)
+{
+    if (! IsValid() || ! Occupancy.IsValid())
+    {
+        return;
+    }
+
+    // Map occupied tiles to this occupancy dimension
+
+    const float ScaleX = float(Dimension.X) / Occupancy.Dimension.X;
+    const float ScaleY = float(Dimension.Y) / Occupancy.Dimension.Y;
+
+    for (int32 TileY=0; TileY<Occupancy.TileCount.Y; ++TileY)
+    for (int32 TileX=0; TileX<Occupancy.TileCount.X; ++TileX)
+    {
+        if (Occupancy.OccupiedTiles[TileY*Occupancy.TileCount.X + TileX])
+        {
+            const FIntPoint Min(FIntPoint(TileX, TileY) * Occupancy.TileSize);
+            const FIntPoint Max(Min + FIntPoint(Occupancy.TileSize, Occupancy.TileSize));
+
+            FIntRect Rect(
+                FMath::FloorToInt(Min.X * ScaleX),
+                FMath::FloorToInt(Min.Y * ScaleY),
+                FMath::CeilToInt(Max.X * ScaleX),
+                FMath::CeilToInt(Max.Y * ScaleY)
+                );
+            Rect.InflateRect(DilationRadius);
+
+            MarkRect(Rect);
+        }
+    }
+}
+
+void FSUGGraphTileOccupancy::GetOccupiedRects(TArray<FIntRect>& OutRects) const
+{
+    // Merge occupied tiles into horizontal runs, runs spanning the same
+    // columns on consecutive rows are merged into a single rect
+
+    TArray<FIntRect> OpenRuns;
+    TArray<FIntRect> RowRuns;
+
+    auto EmitRun = [&](const FIntRect& Run)
+    {
+        FIntRect Rect(Run.Min * TileSize, Run.Max * TileSize);
+        Rect.Max = Rect.Max.ComponentMin(Dimension);
+        OutRects.Emplace(Rect);
+    };
+
+    for (int32 TileY=0; TileY<TileCount.Y; ++TileY)
+    {
+        RowRuns.Reset();
+
+        for (int32 TileX=0; TileX<TileCount.X; ++TileX)
+        {
+            if (OccupiedTiles[TileY*TileCount.X + TileX])
+            {
+                if (RowRuns.Num() > 0 && RowRuns.Last().Max.X == TileX)
+                {
+                    ++RowRuns.Last().Max.X;
+                }
+                else
+                {
+                    RowRuns.Emplace(TileX, TileY, TileX+1, TileY+1);
+                }
+            }
+        }
+
+        for (FIntRect& Run : RowRuns)
+        {
+            const int32 OpenIndex = OpenRuns.IndexOfByPredicate(
+                [&Run](const FIntRect& OpenRun)
+                {
+                    return OpenRun.Min.X == Run.Min.X && OpenRun.Max.X == Run.Max.X;
+                } );
+
+            if (OpenIndex != INDEX_NONE)
+            {
+                Run.Min.Y = OpenRuns[OpenIndex].Min.Y;
+                OpenRuns.RemoveAtSwap(OpenIndex);
+            }
+        }
+
+        // Runs not continued on this row are complete
+        for (const FIntRect& OpenRun : OpenRuns)
+        {
+            EmitRun(OpenRun);
+        }
+
+        OpenRuns = RowRuns;
+    }
+
+    for (const FIntRect& OpenRun : OpenRuns)
+    {
+        EmitRun(OpenRun);
+    }
+}
+
+void FSUGGraphMaterialParameterLayout::Build(const UMaterialInterface& Material)
+{
+    TArray<FMaterialParameterInfo> ParameterInfos;
+    TArray<FGuid> ParameterIds;
+
+    ScalarNames.Reset();
+    VectorNames.Reset();
+    TextureNames.Reset();
+    ScalarDefaults.Reset();
+    VectorDefaults.Reset();
+    TextureDefaults.Reset();
+
+    // Only global parameters are assignable by name
+
+    Material.GetAllScalarParameterInfo(ParameterInfos, ParameterIds);
+
+    for (const FMaterialParameterInfo& ParameterInfo : ParameterInfos)
+    {
+        float DefaultValue = 0.f;
+
+        if (ParameterInfo.Association == EMaterialParameterAssociation::GlobalParameter &&
+            Material.GetScalarParameterDefaultValue(ParameterInfo, DefaultValue))
+        {
+            ScalarNames.Emplace(ParameterInfo.Name);
+            ScalarDefaults.Emplace(DefaultValue);
+        }
+    }
+
+    Material.GetAllVectorParameterInfo(ParameterInfos, ParameterIds);
+
+    for (const FMaterialParameterInfo& ParameterInfo : ParameterInfos)
+    {
+        FLinearColor DefaultValue(ForceInitToZero);
+
+        if (ParameterInfo.Association == EMaterialParameterAssociation::GlobalParameter &&
+            Material.GetVectorParameterDefaultValue(ParameterInfo, DefaultValue))
+        {
+            VectorNames.Emplace(ParameterInfo.Name);
+            VectorDefaults.Emplace(DefaultValue);
+        }
+    }
+
+    Material.GetAllTextureParameterInfo(ParameterInfos, ParameterIds);
+
+    for (const FMaterialParameterInfo& ParameterInfo : ParameterInfos)
+    {
+        UTexture* DefaultValue = nullptr;
+
+        if (ParameterInfo.Association == EMaterialParameterAssociation::GlobalParameter &&
+            Material.GetTextureParameterDefaultValue(ParameterInfo, DefaultValue))
+        {
+            TextureNames.Emplace(ParameterInfo.Name);
+            TextureDefaults.Emplace(DefaultValue);
+        }
+    }
+
+    ScalarIndexMap.Reset();
+    VectorIndexMap.Reset();
+    TextureIndexMap.Reset();
+
+    for (int32 i=0; i<ScalarNames.Num(); ++i)
+    {
+        ScalarIndexMap.Emplace(ScalarNames[i], i);
+    }
+
+    for (int32 i=0; i<VectorNames.Num(); ++i)
+    {
+        VectorIndexMap.Emplace(VectorNames[i], i);
+    }
+
+    for (int32 i=0; i<TextureNames.Num(); ++i)
+    {
+        TextureIndexMap.Emplace(TextureNames[i], i);
+    }
+
+    // Slots are assigned by the first initialized instance
+    ScalarSlots.Init(INDEX_NONE, ScalarNames.Num());
+    VectorSlots.Init(INDEX_NONE, VectorNames.Num());
+
+    static uint32 NextLayoutId = 0;
+    LayoutId = ++NextLayoutId;
+
+    bIsBuilt = true;
+    bHasSlots = false;
+}
+
+void FSUGGraphMaterialParameterLayout::InitializeInstance(UMaterialInstanceDynamic& MID, FSUGGraphMIDParameterState& State)
+{
+    check(bIsBuilt);
+
+    // Initialize parameters of a fresh instance in layout order, every
+    // instance of the material resolves to identical parameter indices
+
+    for (int32 i=0; i<ScalarNames.Num(); ++i)
+    {
+        int32 ParameterIndex = INDEX_NONE;
+
+        if (MID.InitializeScalarParameterAndGetIndex(ScalarNames[i], ScalarDefaults[i], ParameterIndex) && ! bHasSlots)
+        {
+            ScalarSlots[i] = ParameterIndex;
+        }
+    }
+
+    for (int32 i=0; i<VectorNames.Num(); ++i)
+    {
+        int32 ParameterIndex = INDEX_NONE;
+
+        if (MID.InitializeVectorParameterAndGetIndex(VectorNames[i], VectorDefaults[i], ParameterIndex) && ! bHasSlots)
+        {
+            VectorSlots[i] = ParameterIndex;
+        }
+    }
+
+    bHasSlots = true;
+
+    // Fresh instance holds default values
+    State.Scalars = ScalarDefaults;
+    State.Vectors = VectorDefaults;
+    State.Textures = TextureDefaults;
+    State.LastOwner.Reset();
 }
@@ -31,12 +31,20 @@
 #include "SUGGraphTask.h"
 #include "Tasks/SUGGraphTask_ApplyMaterial.h"
 #include "Tasks/SUGGraphTask_AutoLevel.h"
+#include "Tasks/SUGGraphTask_BoxFilter.h"
+#include "Tasks/SUGGraphTask_Convolution.h"
 #include "Tasks/SUGGraphTask_DrawGeometry.h"
 #include "Tasks/SUGGraphTask_DrawMaterialPoly.h"
 #include "Tasks/SUGGraphTask_DrawMaterialQuad.h"
 #include "Tasks/SUGGraphTask_DrawTaskToOutput.h"
 #include "Tasks/SUGGraphTask_DrawTaskToTexture.h"
+#include "Tasks/SUGGraphTask_GaussianBlur.h"
+#include "Tasks/SUGGraphTask_Histogram.h"
+#include "Tasks/SUGGraphTask_HydraulicErosion.h"
+#include "Tasks/SUGGraphTask_JumpFlood.h"
+#include "Tasks/SUGGraphTask_Morphology.h"
 #include "Tasks/SUGGraphTask_ResolveOutput.h"
+#include "Tasks/SUGGraphTask_SummedAreaTable.h"
 
 void USUGGraphUtility::AddTask(
     USUGGraph& Graph,
@@ -413,7 +421,8 @@ USUGGraphTask_AutoLevel* USUGGraphUtility::AddAutoLevelTask(
     USUGGraphTask* OutputTask,
     FSUGGraphTextureInput SourceTexture,
     bool bApplyLevelMin,
-    bool bApplyLevelMax
+    bool bApplyLevelMax,
+    bool bUseNativeShader
     )
 {
     USUGGraphTask_AutoLevel* Task = nullptr;
@@ -434,6 +443,310 @@ USUGGraphTask_AutoLevel* USUGGraphUtility::AddAutoLevelTask(
             Task->SourceTexture = SourceTexture;
             Task->bApplyLevelMin = bApplyLevelMin;
             Task->bApplyLevelMax = bApplyLevelMax;
+            Task->bUseNativeShader = bUseNativeShader;
+            AddTask(*Graph, *Task, TaskConfig, ConfigMethod, OutputTask);
+        }
+    }
+
+    return Task;
+}
+
+USUGGraphTask_GaussianBlur* USUGGraphUtility::AddGaussianBlurTask(
+    USUGGraph* Graph,
+    TSubclassOf<USUGGraphTask_GaussianBlur> TaskType,
+    const FSUGGraphTaskConfig& TaskConfig,
+    TEnumAsByte<enum ESUGGraphConfigMethod> ConfigMethod,
+    USUGGraphTask* OutputTask,
+    FSUGGraphTextureInput SourceTexture,
+    int32 BlurRadius,
+    float BlurSigma,
+    TEnumAsByte<enum ESUGGraphBlurMethod> BlurMethod
+    )
+{
+    USUGGraphTask_GaussianBlur* Task = nullptr;
+
+    if (IsValid(Graph))
+    {
+        if (TaskType.Get())
+        {
+            Task = NewObject<USUGGraphTask_GaussianBlur>(Graph, TaskType);
+        }
+        else
+        {
+            Task = NewObject<USUGGraphTask_GaussianBlur>(Graph);
+        }
+
+        if (IsValid(Task))
+        {
+            Task->SourceTexture = SourceTexture;
+            Task->BlurRadius = BlurRadius;
+            Task->BlurSigma = BlurSigma;
+            Task->BlurMethod = BlurMethod;
+            AddTask(*Graph, *Task, TaskConfig, ConfigMethod, OutputTask);
+        }
+    }
+
+    return Task;
+}
+
+USUGGraphTask_JumpFlood* USUGGraphUtility::AddJumpFloodTask(
+    USUGGraph* Graph,
+    TSubclassOf<USUGGraphTask_JumpFlood> TaskType,
+    const FSUGGraphTaskConfig& TaskConfig,
+    TEnumAsByte<enum ESUGGraphConfigMethod> ConfigMethod,
+    USUGGraphTask* OutputTask,
+    FSUGGraphTextureInput SourceTexture,
+    float SeedThreshold,
+    float MaxDistance
+    )
+{
+    USUGGraphTask_JumpFlood* Task = nullptr;
+
+    if (IsValid(Graph))
+    {
+        if (TaskType.Get())
+        {
+            Task = NewObject<USUGGraphTask_JumpFlood>(Graph, TaskType);
+        }
+        else
+        {
+            Task = NewObject<USUGGraphTask_JumpFlood>(Graph);
+        }
+
+        if (IsValid(Task))
+        {
+            Task->SourceTexture = SourceTexture;
+            Task->SeedThreshold = SeedThreshold;
+            Task->MaxDistance = MaxDistance;
+            AddTask(*Graph, *Task, TaskConfig, ConfigMethod, OutputTask);
+        }
+    }
+
+    return Task;
+}
+
+USUGGraphTask_Histogram* USUGGraphUtility::AddHistogramTask(
+    USUGGraph* Graph,
+    TSubclassOf<USUGGraphTask_Histogram> TaskType,
+    const FSUGGraphTaskConfig& TaskConfig,
+    USUGGraphTask* OutputTask,
+    FSUGGraphTextureInput SourceTexture,
+    TEnumAsByte<enum ESUGGraphHistogramBinCount> BinCount,
+    int32 SourceChannel,
+    float PercentileLo,
+    float PercentileHi,
+    float RangeMin,
+    float RangeMax
+    )
+{
+    USUGGraphTask_Histogram* Task = nullptr;
+
+    if (IsValid(Graph))
+    {
+        if (TaskType.Get())
+        {
+            Task = NewObject<USUGGraphTask_Histogram>(Graph, TaskType);
+        }
+        else
+        {
+            Task = NewObject<USUGGraphTask_Histogram>(Graph);
+        }
+
+        if (IsValid(Task))
+        {
+            Task->TextureInputMap.Emplace(TEXT("SourceTexture"), SourceTexture);
+            Task->BinCount = BinCount;
+            Task->SourceChannel = SourceChannel;
+            Task->PercentileLo = PercentileLo;
+            Task->PercentileHi = PercentileHi;
+            Task->RangeMin = RangeMin;
+            Task->RangeMax = RangeMax;
+
+            // Output config is resolved by the task from its bin count
+            AddTask(*Graph, *Task, TaskConfig, RUL_CM_Absolute, OutputTask);
+        }
+    }
+
+    return Task;
+}
+
+USUGGraphTask_HydraulicErosion* USUGGraphUtility::AddHydraulicErosionTask(
+    USUGGraph* Graph,
+    TSubclassOf<USUGGraphTask_HydraulicErosion> TaskType,
+    const FSUGGraphTaskConfig& TaskConfig,
+    TEnumAsByte<enum ESUGGraphConfigMethod> ConfigMethod,
+    USUGGraphTask* OutputTask,
+    FSUGGraphTextureInput SourceTexture,
+    FName SimulationName,
+    int32 StepCount,
+    int32 StepsPerExecution
+    )
+{
+    USUGGraphTask_HydraulicErosion* Task = nullptr;
+
+    if (IsValid(Graph))
+    {
+        if (TaskType.Get())
+        {
+            Task = NewObject<USUGGraphTask_HydraulicErosion>(Graph, TaskType);
+        }
+        else
+        {
+            Task = NewObject<USUGGraphTask_HydraulicErosion>(Graph);
+        }
+
+        if (IsValid(Task))
+        {
+            Task->SourceTexture = SourceTexture;
+            Task->SimulationName = SimulationName;
+            Task->StepCount = StepCount;
+            Task->StepsPerExecution = StepsPerExecution;
+            AddTask(*Graph, *Task, TaskConfig, ConfigMethod, OutputTask);
+        }
+    }
+
+    return Task;
+}
+
+USUGGraphTask_Morphology* USUGGraphUtility::AddMorphologyTask(
+    USUGGraph* Graph,
+    TSubclassOf<USUGGraphTask_Morphology> TaskType,
+    const FSUGGraphTaskConfig& TaskConfig,
+    TEnumAsByte<enum ESUGGraphConfigMethod> ConfigMethod,
+    USUGGraphTask* OutputTask,
+    FSUGGraphTextureInput SourceTexture,
+    TEnumAsByte<enum ESUGGraphMorphologyOp> Operation,
+    int32 Radius
+    )
+{
+    USUGGraphTask_Morphology* Task = nullptr;
+
+    if (IsValid(Graph))
+    {
+        if (TaskType.Get())
+        {
+            Task = NewObject<USUGGraphTask_Morphology>(Graph, TaskType);
+        }
+        else
+        {
+            Task = NewObject<USUGGraphTask_Morphology>(Graph);
+        }
+
+        if (IsValid(Task))
+        {
+            Task->TextureInputMap.Emplace(TEXT("SourceTexture"), SourceTexture);
+            Task->Operation = Operation;
+            Task->Radius = Radius;
+            AddTask(*Graph, *Task, TaskConfig, ConfigMethod, OutputTask);
+        }
+    }
+
+    return Task;
+}
+
+USUGGraphTask_SummedAreaTable* USUGGraphUtility::AddSummedAreaTableTask(
+    USUGGraph* Graph,
+    TSubclassOf<USUGGraphTask_SummedAreaTable> TaskType,
+    const FSUGGraphTaskConfig& TaskConfig,
+    TEnumAsByte<enum ESUGGraphConfigMethod> ConfigMethod,
+    USUGGraphTask* OutputTask,
+    FSUGGraphTextureInput SourceTexture,
+    bool bSubtractSourceMean,
+    float ValueOffset
+    )
+{
+    USUGGraphTask_SummedAreaTable* Task = nullptr;
+
+    if (IsValid(Graph))
+    {
+        if (TaskType.Get())
+        {
+            Task = NewObject<USUGGraphTask_SummedAreaTable>(Graph, TaskType);
+        }
+        else
+        {
+            Task = NewObject<USUGGraphTask_SummedAreaTable>(Graph);
+        }
+
+        if (IsValid(Task))
+        {
+            Task->TextureInputMap.Emplace(TEXT("SourceTexture"), SourceTexture);
+            Task->bSubtractSourceMean = bSubtractSourceMean;
+            Task->ValueOffset = ValueOffset;
+            AddTask(*Graph, *Task, TaskConfig, ConfigMethod, OutputTask);
+        }
+    }
+
+    return Task;
+}
+
+USUGGraphTask_BoxFilter* USUGGraphUtility::AddBoxFilterTask(
+    USUGGraph* Graph,
+    TSubclassOf<USUGGraphTask_BoxFilter> TaskType,
+    const FSUGGraphTaskConfig& TaskConfig,
+    TEnumAsByte<enum ESUGGraphConfigMethod> ConfigMethod,
+    USUGGraphTask* OutputTask,
+    FSUGGraphTextureInput SummedAreaTable,
+    FSUGGraphTextureInput RadiusTexture,
+    float Radius
+    )
+{
+    USUGGraphTask_BoxFilter* Task = nullptr;
+
+    if (IsValid(Graph))
+    {
+        if (TaskType.Get())
+        {
+            Task = NewObject<USUGGraphTask_BoxFilter>(Graph, TaskType);
+        }
+        else
+        {
+            Task = NewObject<USUGGraphTask_BoxFilter>(Graph);
+        }
+
+        if (IsValid(Task))
+        {
+            Task->SummedAreaTable = SummedAreaTable;
+            Task->RadiusTexture = RadiusTexture;
+            Task->Radius = Radius;
+            AddTask(*Graph, *Task, TaskConfig, ConfigMethod, OutputTask);
+        }
+    }
+
+    return Task;
+}
+
+USUGGraphTask_Convolution* USUGGraphUtility::AddConvolutionTask(
+    USUGGraph* Graph,
+    TSubclassOf<USUGGraphTask_Convolution> TaskType,
+    const FSUGGraphTaskConfig& TaskConfig,
+    TEnumAsByte<enum ESUGGraphConfigMethod> ConfigMethod,
+    USUGGraphTask* OutputTask,
+    FSUGGraphTextureInput SourceTexture,
+    FSUGGraphTextureInput KernelTexture,
+    bool bNormalizeKernel,
+    int32 MaxDirectKernelSize
+    )
+{
+    USUGGraphTask_Convolution* Task = nullptr;
+
+    if (IsValid(Graph))
+    {
+        if (TaskType.Get())
+        {
+            Task = NewObject<USUGGraphTask_Convolution>(Graph, TaskType);
+        }
+        else
+        {
+            Task = NewObject<USUGGraphTask_Convolution>(Graph);
+        }
+
+        if (IsValid(Task))
+        {
+            Task->TextureInputMap.Emplace(TEXT("SourceTexture"), SourceTexture);
+            Task->TextureInputMap.Emplace(TEXT("KernelTexture"), KernelTexture);
+            Task->bNormalizeKernel = bNormalizeKernel;
+            Task->MaxDirectKernelSize = MaxDirectKernelSize;
             AddTask(*Graph, *Task, TaskConfig, ConfigMethod, OutputTask);
         }
     }
@@ -26,6 +26,9 @@
 //
 
 #include "ShaderGraphPlugin.h"
+#include "Interfaces/IPluginManager.h"
+#include "Misc/Paths.h"
+#include "ShaderCore.h"
 
 #if WITH_EDITOR
 #include "ISettingsModule.h"
@@ -53,6 +56,10 @@ private:
 
 void FShaderGraphPlugin::StartupModule()
 {
+    // Map plugin shader directory for built-in global shaders
+    FString PluginShaderDir = FPaths::Combine(IPluginManager::Get().FindPlugin(TEXT("ShaderGraphPlugin"))->GetBaseDir(), TEXT("Shaders"));
+    AddShaderSourceDirectoryMapping(TEXT("/Plugin/ShaderGraphPlugin"), PluginShaderDir);
+
 #if WITH_EDITOR
     // We don't quite have control of when the "Settings" module is loaded, so we'll wait until PostEngineInit to register settings.
     FCoreDelegates::OnPostEngineInit.AddRaw(this, &FShaderGraphPlugin::RegisterSettings);
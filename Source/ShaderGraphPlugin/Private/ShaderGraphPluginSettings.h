@@ -42,5 +42,30 @@ public:
 	UPROPERTY(Config, EditDefaultsOnly, Category="Shaders")
     TSubclassOf<class URULShaderMaterialLibrary> MaterialLibraryType;
 
+    // Maximum number of scheduled graph executions per frame, zero for no limit
+	UPROPERTY(Config, EditDefaultsOnly, Category="Scheduling", meta=(ClampMin="0"))
+    int32 MaxScheduledExecutionsPerFrame = 4;
+
+    // Game thread time budget per frame for scheduled graph executions
+	UPROPERTY(Config, EditDefaultsOnly, Category="Scheduling", meta=(ClampMin="0", Units="ms"))
+    float ScheduledExecutionBudgetMs = 4.f;
+
+    // Requests waiting longer than this number of frames are executed regardless of priority
+	UPROPERTY(Config, EditDefaultsOnly, Category="Scheduling", meta=(ClampMin="1"))
+    int32 MaxScheduledRequestWaitFrames = 60;
+
+	UPROPERTY(Config, EditDefaultsOnly, Category="Scheduling")
+    float ScheduleDistanceScale = 10000.f;
+
+	UPROPERTY(Config, EditDefaultsOnly, Category="Scheduling")
+    float ScheduleDistanceWeight = 1.f;
+
+	UPROPERTY(Config, EditDefaultsOnly, Category="Scheduling")
+    float ScheduleVisibilityWeight = 1.f;
+
+    // Priority gained by a queued request for every frame it waits
+	UPROPERTY(Config, EditDefaultsOnly, Category="Scheduling")
+    float ScheduleWaitFrameWeight = .05f;
+
     static const URULShaderMaterialLibrary* GetMaterialLibrary();
 };
@@ -29,6 +29,18 @@
 #include "Shaders/RULShaderLibrary.h"
 #include "SUGGraph.h"
 
+bool USUGGraphTask_BlurFilter1D::SupportsRegionExecution() const
+{
+    // Filter passes ping-pong through output sized swap render targets
+    return false;
+}
+
+int32 USUGGraphTask_BlurFilter1D::GetFootprintRadius() const
+{
+    const float BlurSampleCount = GetScalarParameterValue(BlurSampleCountParameterName, 1.f);
+    return FMath::Max(Super::GetFootprintRadius(), FMath::CeilToInt(BlurSampleCount));
+}
+
 void USUGGraphTask_BlurFilter1D::ExecuteMaterialFunction(USUGGraph& Graph, UMaterialInstanceDynamic& MID)
 {
     check(Graph.HasGraphManager());
@@ -57,4 +69,7 @@ void USUGGraphTask_BlurFilter1D::ExecuteMaterialFunction(USUGGraph& Graph, UMate
         SwapRT.RenderTarget,
         1
         );
+
+    // Pass parameters are written to the MID directly
+    InvalidateParameterState();
 }
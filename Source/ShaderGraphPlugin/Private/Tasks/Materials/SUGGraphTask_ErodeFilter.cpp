@@ -26,8 +26,25 @@
 // 
 
 #include "Tasks/Materials/SUGGraphTask_ErodeFilter.h"
+#include "Engine/TextureRenderTarget2D.h"
+#include "Materials/MaterialInstanceDynamic.h"
 #include "Shaders/RULShaderLibrary.h"
 #include "SUGGraph.h"
+#include "SUGGraphManager.h"
+#include "SUGGraphRenderUtils.h"
+
+bool USUGGraphTask_ErodeFilter::SupportsRegionExecution() const
+{
+    // Filter passes ping-pong through output sized swap render targets
+    return false;
+}
+
+int32 USUGGraphTask_ErodeFilter::GetFootprintRadius() const
+{
+    // Footprint radius is per iteration, each iteration expands the
+    // neighbourhood affecting a single output pixel
+    return FMath::Max(0, IterationCount) * FMath::Max(1, Super::GetFootprintRadius());
+}
 
 void USUGGraphTask_ErodeFilter::ExecuteMaterialFunction(USUGGraph& Graph, UMaterialInstanceDynamic& MID)
 {
@@ -35,7 +52,15 @@ void USUGGraphTask_ErodeFilter::ExecuteMaterialFunction(USUGGraph& Graph, UMater
 
     ApplyMaterialParameters(MID);
 
+    ExecutedIterationCount = FMath::Max(0, IterationCount);
+
+    // Converging iterations, stop early once the result stops changing
+    if (bStopOnConvergence && IterationCount > 1)
+    {
+        ExecuteConvergingIterations(Graph, MID);
+    }
     // Setup parameters multi parameters
+    else
     if (IterationCount > 1)
     {
         FSUGGraphOutputRT SwapRT;
@@ -57,6 +82,9 @@ void USUGGraphTask_ErodeFilter::ExecuteMaterialFunction(USUGGraph& Graph, UMater
             1,
             (IterationCount-2)
             );
+
+        // Pass parameters are written to the MID directly
+        InvalidateParameterState();
     }
     // Single iteration
     else
@@ -70,3 +98,116 @@ void USUGGraphTask_ErodeFilter::ExecuteMaterialFunction(USUGGraph& Graph, UMater
             );
     }
 }
+
+void USUGGraphTask_ErodeFilter::ExecuteConvergingIterations(USUGGraph& Graph, UMaterialInstanceDynamic& MID)
+{
+    USUGGraphManager& GraphManager(*Graph.GetGraphManager());
+    UTextureRenderTarget2D* OutputTexture = Output.RenderTarget;
+
+    if (! IsValid(OutputTexture))
+    {
+        return;
+    }
+
+    FSUGGraphOutputRT SwapRT;
+    GraphManager.FindFreeOutputRT(ResolvedOutputConfig, SwapRT);
+
+    if (! IsValid(SwapRT.RenderTarget))
+    {
+        UE_LOG(LogSGP,Warning, TEXT("USUGGraphTask_ErodeFilter::ExecuteConvergingIterations() ABORTED, UNABLE TO ACQUIRE SWAP RENDER TARGET"));
+        return;
+    }
+
+    // Lease full precision difference reduction render targets
+
+    TArray<FIntPoint> LevelDimensions;
+    FSUGGraphRenderUtils::GetRangeReductionLevels(
+        FIntPoint(OutputTexture->SizeX, OutputTexture->SizeY),
+        LevelDimensions
+        );
+
+    TArray<FSUGGraphOutputRT> ReductionRTs;
+    TArray<UTextureRenderTarget2D*> ReductionTextures;
+
+    ReductionRTs.SetNum(LevelDimensions.Num());
+
+    for (int32 i=0; i<LevelDimensions.Num(); ++i)
+    {
+        FRULShaderOutputConfig LevelConfig(ResolvedOutputConfig);
+        LevelConfig.SizeX = LevelDimensions[i].X;
+        LevelConfig.SizeY = LevelDimensions[i].Y;
+        LevelConfig.Format = RTF_RGBA32f;
+
+        GraphManager.FindFreeOutputRT(LevelConfig, ReductionRTs[i]);
+        ReductionTextures.Emplace(ReductionRTs[i].RenderTarget);
+    }
+
+    // Iterations ping-pong between the swap and output render targets with
+    // the last iteration of a full run written to the output. The first
+    // iteration reads the source texture.
+
+    UTextureRenderTarget2D* IterationTextures[2] = { SwapRT.RenderTarget, OutputTexture };
+    UTextureRenderTarget2D* ResultTexture = nullptr;
+
+    const int32 CheckInterval = FMath::Max(1, ConvergenceCheckInterval);
+    const float Threshold = FMath::Max(0.f, ConvergenceThreshold);
+
+    FSUGGraphDifferenceReadbackRef Readback(MakeShared<FSUGGraphDifferenceReadback, ESPMode::ThreadSafe>());
+
+    int32 Iteration = 0;
+
+    while (Iteration < IterationCount)
+    {
+        UTextureRenderTarget2D* PreviousTexture = ResultTexture;
+        ResultTexture = IterationTextures[(Iteration + IterationCount) % 2];
+
+        if (PreviousTexture)
+        {
+            MID.SetTextureParameterValue(SourceTextureParameterName, PreviousTexture);
+        }
+
+        URULShaderLibrary::ApplyMaterial(
+            &GraphManager,
+            &MID,
+            ResultTexture,
+            TaskConfig.DrawConfig
+            );
+
+        ++Iteration;
+
+        // Measure change of the last iteration at check intervals. Checks
+        // wait for the read back, iterations stop at the first converged
+        // check regardless of GPU timing.
+        if (PreviousTexture && Iteration < IterationCount && (Iteration % CheckInterval) == 0)
+        {
+            const bool bEnqueued = FSUGGraphRenderUtils::EnqueueMaxDifference(
+                PreviousTexture,
+                ResultTexture,
+                ReductionTextures,
+                Readback
+                );
+
+            float MaxDifference;
+
+            if (bEnqueued && FSUGGraphRenderUtils::ReadMaxDifference(Readback, MaxDifference) && MaxDifference <= Threshold)
+            {
+                break;
+            }
+        }
+    }
+
+    ExecutedIterationCount = Iteration;
+
+    // Iteration source textures are written to the MID directly
+    InvalidateParameterState();
+
+    if (ResultTexture != OutputTexture)
+    {
+        FSUGGraphRenderUtils::CopyTextureRegion(
+            ResultTexture,
+            OutputTexture,
+            FIntRect(0, 0, OutputTexture->SizeX, OutputTexture->SizeY),
+            FIntPoint::ZeroValue
+            );
+    }
+}
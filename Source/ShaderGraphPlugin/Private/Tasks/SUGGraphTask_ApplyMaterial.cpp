@@ -26,26 +26,50 @@
 // 
 
 #include "Tasks/SUGGraphTask_ApplyMaterial.h"
+#include "Engine/TextureRenderTarget2D.h"
+#include "Kismet/KismetRenderingLibrary.h"
+#include "Materials/MaterialInstanceDynamic.h"
 #include "Shaders/RULShaderLibrary.h"
 #include "SUGGraph.h"
+#include "SUGGraphManager.h"
+#include "SUGGraphRenderUtils.h"
 
 void USUGGraphTask_ApplyMaterial::Initialize(USUGGraph* Graph)
 {
     check(IsValid(Graph));
 
-    // Register task inputs to dependency map
+    // Merge editor facing inputs into parameter block
+
+    for (const auto& InputPair : ScalarInputMap)
+    {
+        ParameterBlock.SetScalar(InputPair.Key, InputPair.Value);
+    }
+
+    for (const auto& InputPair : VectorInputMap)
+    {
+        ParameterBlock.SetVector(InputPair.Key, InputPair.Value);
+    }
 
     for (const auto& InputPair : TextureInputMap)
     {
-        const FName& InputKey(InputPair.Key);
-        const FSUGGraphTextureInput& InputValue(InputPair.Value);
+        ParameterBlock.SetTexture(InputPair.Key, InputPair.Value);
+    }
+
+    // Register task inputs to dependency map
+
+    ParameterBlock.ResolvedTextures.SetNumZeroed(ParameterBlock.TextureNames.Num());
+
+    for (int32 i=0; i<ParameterBlock.TextureNames.Num(); ++i)
+    {
+        const FName& InputKey(ParameterBlock.TextureNames[i]);
+        const FSUGGraphTextureInput& InputValue(ParameterBlock.TextureInputs[i]);
 
-        UTexture* Texture(InputValue.Texture);
+        UTexture* Texture(InputValue.GetTexture());
         USUGGraphTask* Task(InputValue.Task);
 
         if (IsValid(Texture))
         {
-            ResolvedTextureInputMap.Emplace(InputKey, Texture);
+            ParameterBlock.ResolvedTextures[i] = Texture;
         }
         else
         if (IsValid(Task))
@@ -64,23 +88,292 @@ void USUGGraphTask_ApplyMaterial::Execute(USUGGraph* Graph)
 
     // Resolve material instance to apply
 
+    // Pooled MIDs retain parameters of their previous use, only changed
+    // parameters are applied
+
     UMaterialInstanceDynamic* MID = nullptr;
 
-    // Create new MID from material interface
-    if (MaterialRef.Material)
+    // Use pooled MID of material interface
+    if (MaterialRef.GetMaterial())
     {
-        MID = Graph->GetCachedMID(MaterialRef.Material, true);
+        MID = Graph->GetPooledMID(MaterialRef.GetMaterial(), PooledMID);
     }
-    // Use cached MID with the specified material name
+    // Use pooled MID of the specified material name
     else
     {
-        MID = Graph->GetCachedMID(MaterialRef.MaterialName, true);
+        MID = Graph->GetPooledMID(MaterialRef.MaterialName, PooledMID);
     }
 
     if (IsValid(MID))
     {
-        ExecuteMaterialFunction(*Graph, *MID);
+        const FName DomainUVTransformName = Graph->GetParameterNameFromCategory(
+            FName(),
+            TEXT("GraphDomain"),
+            TEXT("DomainUVTransform")
+            );
+
+        // Map tile render target UV to graph domain UV for position
+        // dependent materials
+        if (Graph->IsTiledExecution())
+        {
+            MID->SetVectorParameterValue(DomainUVTransformName, Graph->GetDomainUVTransform());
+        }
+
+        // Only re-render changed region of the retained output
+        if (Graph->IsIncrementalExecution() && IsPartialExecutionRegion() && SupportsRegionExecution())
+        {
+            ExecuteMaterialRegion(*Graph, *MID, GetExecutionRegion());
+        }
+        else
+        // Only render occupied output tiles
+        if (HasSparseTileOccupancy())
+        {
+            ExecuteMaterialTiles(*Graph, *MID);
+        }
+        else
+        {
+            ExecuteMaterialFunction(*Graph, *MID);
+        }
+
+        // Restore transform for subsequent uses of the pooled MID
+        if (Graph->IsTiledExecution())
+        {
+            RestoreVectorParameter(*MID, DomainUVTransformName);
+        }
+    }
+
+    PooledMID.Reset();
+}
+
+void USUGGraphTask_ApplyMaterial::RestoreVectorParameter(UMaterialInstanceDynamic& MID, FName ParameterName)
+{
+    // Restore last applied value tracked by the pooled MID parameter state,
+    // untracked parameters are restored to identity UV transform
+    const FSUGGraphMaterialParameterLayout* Layout;
+    FSUGGraphMIDParameterState* State;
+
+    int32 LayoutIndex = INDEX_NONE;
+
+    if (FindPooledMIDState(Layout, State))
+    {
+        ResolveParameterSlots(*Layout);
+
+        const TPair<FName, int32>* RestoredIndex = RestoredVectorLayoutIndices.FindByPredicate(
+            [ParameterName](const TPair<FName, int32>& Pair)
+            {
+                return Pair.Key == ParameterName;
+            } );
+
+        if (RestoredIndex)
+        {
+            LayoutIndex = RestoredIndex->Value;
+        }
+        else
+        {
+            LayoutIndex = Layout->FindVectorIndex(ParameterName);
+            RestoredVectorLayoutIndices.Emplace(ParameterName, LayoutIndex);
+        }
+    }
+
+    if (LayoutIndex != INDEX_NONE && Layout->VectorSlots[LayoutIndex] != INDEX_NONE)
+    {
+        MID.SetVectorParameterByIndex(Layout->VectorSlots[LayoutIndex], State->Vectors[LayoutIndex]);
+    }
+    else
+    {
+        MID.SetVectorParameterValue(ParameterName, FLinearColor(0.f, 0.f, 1.f, 1.f));
+    }
+}
+
+void USUGGraphTask_ApplyMaterial::GatherAssetReferences(TArray<FSoftObjectPath>& OutAssetPaths) const
+{
+    MaterialRef.GatherAssetReferences(OutAssetPaths);
+
+    for (const auto& InputPair : TextureInputMap)
+    {
+        InputPair.Value.GatherAssetReferences(OutAssetPaths);
+    }
+
+    for (const FSUGGraphTextureInput& TextureInput : ParameterBlock.TextureInputs)
+    {
+        TextureInput.GatherAssetReferences(OutAssetPaths);
+    }
+}
+
+void USUGGraphTask_ApplyMaterial::GatherMaterialWarmUpEntries(const USUGGraph& Graph, TArray<FSUGGraphMaterialWarmUpEntry>& OutEntries) const
+{
+    FSUGGraphMaterialWarmUpEntry Entry;
+    Entry.Material = MaterialRef.GetMaterial();
+    Entry.MaterialName = MaterialRef.MaterialName;
+    Entry.DrawConfig = TaskConfig.DrawConfig;
+
+    if (! IsValid(Entry.Material) && Entry.MaterialName.IsNone())
+    {
+        return;
+    }
+
+    // Output config of input based tasks is only resolved on graph
+    // initialization, assume graph output format
+    Entry.Format = (ConfigMethod == RUL_CM_Absolute)
+        ? TaskConfig.OutputConfig.Format
+        : Graph.OutputConfig.Format;
+
+    OutEntries.Emplace(Entry);
+}
+
+bool USUGGraphTask_ApplyMaterial::SupportsRegionExecution() const
+{
+    // Blended draws depend on previous output content and can't be
+    // rendered separately
+    return bRegionAwareMaterial && TaskConfig.DrawConfig.BlendType == ERULShaderDrawBlendType::DB_Opaque;
+}
+
+void USUGGraphTask_ApplyMaterial::ExecuteMaterialTiles(USUGGraph& Graph, UMaterialInstanceDynamic& MID)
+{
+    check(Graph.HasGraphManager());
+
+    TArray<FIntRect> OccupiedRects;
+    TileOccupancy.GetOccupiedRects(OccupiedRects);
+
+    // Every occupied rect is rendered to a region render target of its own
+    // bucketed size. Render the whole output in a single pass instead if the
+    // rendered region area approaches the output area.
+
+    const FIntPoint OutputSize(ResolvedOutputConfig.GetDimension());
+    const int64 OutputArea = int64(OutputSize.X) * OutputSize.Y;
+    int64 RegionArea = 0;
+
+    for (const FIntRect& Rect : OccupiedRects)
+    {
+        const FIntPoint RegionTargetSize(GetRegionTargetSize(Rect.Size()));
+        RegionArea += int64(RegionTargetSize.X) * RegionTargetSize.Y;
+    }
+
+    if (4*RegionArea >= 3*OutputArea)
+    {
+        ExecuteMaterialFunction(Graph, MID);
+        return;
+    }
+
+    // Clear skipped tiles
+    UKismetRenderingLibrary::ClearRenderTarget2D(Graph.GetGraphManager(), Output.RenderTarget, FLinearColor::Transparent);
+
+    for (const FIntRect& Rect : OccupiedRects)
+    {
+        ExecuteMaterialRegion(Graph, MID, Rect);
+    }
+}
+
+FIntPoint USUGGraphTask_ApplyMaterial::GetRegionTargetSize(const FIntPoint& RegionSize) const
+{
+    const FIntPoint OutputSize(ResolvedOutputConfig.GetDimension());
+
+    // Region render targets are sized to the region rounded up to the next
+    // power of two, clamped to the output dimension. Pooled targets only
+    // match exact sizes, bucketed sizes keep the number of pooled region
+    // targets bounded regardless of the dirty region sizes.
+
+    return FIntPoint(
+        FMath::Min<int32>(FMath::RoundUpToPowerOfTwo(FMath::Max(1, RegionSize.X)), OutputSize.X),
+        FMath::Min<int32>(FMath::RoundUpToPowerOfTwo(FMath::Max(1, RegionSize.Y)), OutputSize.Y)
+        );
+}
+
+void USUGGraphTask_ApplyMaterial::ExecuteMaterialRegion(USUGGraph& Graph, UMaterialInstanceDynamic& MID, const FIntRect& Region)
+{
+    check(Graph.HasGraphManager());
+    const FVector2D OutputDimension(ResolvedOutputConfig.GetDimension());
+
+    // Render region to a pooled region render target at least the size of
+    // the region. Texels beyond the region are rendered but never copied.
+
+    const FIntPoint RegionTargetSize(GetRegionTargetSize(Region.Size()));
+
+    FRULShaderOutputConfig RegionConfig(ResolvedOutputConfig);
+    RegionConfig.SizeX = RegionTargetSize.X;
+    RegionConfig.SizeY = RegionTargetSize.Y;
+
+    FSUGGraphOutputRT RegionOutput;
+    Graph.GetGraphManager()->FindFreeOutputRT(RegionConfig, RegionOutput);
+
+    if (! IsValid(RegionOutput.RenderTarget))
+    {
+        UE_LOG(LogSGP,Warning, TEXT("USUGGraphTask_ApplyMaterial::ExecuteMaterialRegion() ABORTED, UNABLE TO ACQUIRE REGION RENDER TARGET"));
+        return;
+    }
+
+    const FVector2D RegionTargetDimension(RegionTargetSize);
+
+    // Map region render target UV to output UV
+
+    const FName RegionUVTransformName = Graph.GetParameterNameFromCategory(
+        FName(),
+        TEXT("GraphRegion"),
+        TEXT("RegionUVTransform")
+        );
+
+    MID.SetVectorParameterValue(RegionUVTransformName, FLinearColor(
+        Region.Min.X / OutputDimension.X,
+        Region.Min.Y / OutputDimension.Y,
+        RegionTargetDimension.X / OutputDimension.X,
+        RegionTargetDimension.Y / OutputDimension.Y
+        ));
+
+    Swap(Output, RegionOutput);
+    ExecuteMaterialFunction(Graph, MID);
+    Swap(Output, RegionOutput);
+
+    // Restore transform for subsequent uses of the pooled MID
+    RestoreVectorParameter(MID, RegionUVTransformName);
+
+    // Write rendered region to the retained output
+    FSUGGraphRenderUtils::CopyTextureRegion(
+        RegionOutput.RenderTarget,
+        Output.RenderTarget,
+        FIntRect(FIntPoint::ZeroValue, Region.Size()),
+        Region.Min
+        );
+}
+
+void USUGGraphTask_ApplyMaterial::MarkGeometryChangedRegions(const USUGGraph& Graph, uint32 GeometryHash, const TArray<FBox2D>& GeometryBounds)
+{
+    FBox2D Bounds(ForceInit);
+
+    for (const FBox2D& Box : GeometryBounds)
+    {
+        if (Box.bIsValid)
+        {
+            Bounds += Box;
+        }
+    }
+
+    if (bHasGeometryState && GeometryHash != LastGeometryHash)
+    {
+        if (Bounds.bIsValid && LastGeometryBounds.bIsValid)
+        {
+            FBox2D DirtyBounds(LastGeometryBounds);
+            DirtyBounds += Bounds;
+
+            // Bounds are specified in graph domain pixels, translate to tile
+            // render region during tiled execution
+            const FIntPoint Offset = Graph.IsTiledExecution()
+                ? Graph.ExecutionTile.RenderRect.Min
+                : FIntPoint::ZeroValue;
+
+            MarkDirtyRegion(
+                FIntPoint(FMath::FloorToInt(DirtyBounds.Min.X), FMath::FloorToInt(DirtyBounds.Min.Y)) - Offset,
+                FIntPoint(FMath::CeilToInt(DirtyBounds.Max.X), FMath::CeilToInt(DirtyBounds.Max.Y)) - Offset
+                );
+        }
+        else
+        {
+            MarkDirty();
+        }
     }
+
+    LastGeometryHash = GeometryHash;
+    LastGeometryBounds = Bounds;
+    bHasGeometryState = true;
 }
 
 void USUGGraphTask_ApplyMaterial::ExecuteMaterialFunction(USUGGraph& Graph, UMaterialInstanceDynamic& MID)
@@ -94,34 +387,41 @@ void USUGGraphTask_ApplyMaterial::ExecuteMaterialFunction(USUGGraph& Graph, UMat
         );
 }
 
+float USUGGraphTask_ApplyMaterial::GetScalarParameterValue(FName ParameterName, float DefaultValue) const
+{
+    // Editor facing inputs override parameter block values on initialization
+    const float* InputValue = ScalarInputMap.Find(ParameterName);
+    return InputValue ? *InputValue : ParameterBlock.GetScalar(ParameterName, DefaultValue);
+}
+
 void USUGGraphTask_ApplyMaterial::SetScalarParameterValue(FName ParameterName, float ParameterValue)
 {
-    ScalarInputMap.Emplace(ParameterName, ParameterValue);
+    ParameterBlock.SetScalar(ParameterName, ParameterValue);
 }
 
 void USUGGraphTask_ApplyMaterial::SetVectorParameterValue(FName ParameterName, FLinearColor ParameterValue)
 {
-    VectorInputMap.Emplace(ParameterName, ParameterValue);
+    ParameterBlock.SetVector(ParameterName, ParameterValue);
 }
 
 void USUGGraphTask_ApplyMaterial::SetTextureParameterValue(FName ParameterName, FSUGGraphTextureInput ParameterValue)
 {
-    TextureInputMap.Emplace(ParameterName, ParameterValue);
+    ParameterBlock.SetTexture(ParameterName, ParameterValue);
 }
 
 void USUGGraphTask_ApplyMaterial::SetScalarParameter(const FRULShaderScalarParameter& Parameter)
 {
-    ScalarInputMap.Emplace(Parameter.ParameterName, Parameter.ParameterValue);
+    ParameterBlock.SetScalar(Parameter.ParameterName, Parameter.ParameterValue);
 }
 
 void USUGGraphTask_ApplyMaterial::SetVectorParameter(const FRULShaderVectorParameter& Parameter)
 {
-    VectorInputMap.Emplace(Parameter.ParameterName, Parameter.ParameterValue);
+    ParameterBlock.SetVector(Parameter.ParameterName, Parameter.ParameterValue);
 }
 
 void USUGGraphTask_ApplyMaterial::SetTextureParameter(const FSUGGraphTextureParameter& Parameter)
 {
-    TextureInputMap.Emplace(Parameter.ParameterName, Parameter.ParameterValue);
+    ParameterBlock.SetTexture(Parameter.ParameterName, Parameter.ParameterValue);
 }
 
 void USUGGraphTask_ApplyMaterial::SetParameters(
@@ -209,35 +509,272 @@ void USUGGraphTask_ApplyMaterial::SetParameters(
 
 void USUGGraphTask_ApplyMaterial::ResolveTaskInputMap()
 {
-    for (const auto& DataPair : DependencyMap)
+    for (int32 i=0; i<ParameterBlock.ResolvedTextures.Num(); ++i)
     {
-        FName Key(DataPair.Key);
-        UTexture* Texture = DataPair.Value.Output.RenderTarget;
+        const FDependencyData* DependencyData = DependencyMap.Find(ParameterBlock.TextureNames[i]);
+        UTexture* Texture = DependencyData ? DependencyData->Output.RenderTarget : nullptr;
 
         if (IsValid(Texture))
         {
-            ResolvedTextureInputMap.Emplace(Key, Texture);
+            ParameterBlock.ResolvedTextures[i] = Texture;
         }
     }
 }
 
+bool USUGGraphTask_ApplyMaterial::FindPooledMIDState(const FSUGGraphMaterialParameterLayout*& OutLayout, FSUGGraphMIDParameterState*& OutState) const
+{
+    OutLayout = nullptr;
+    OutState = nullptr;
+
+    return PooledMID.IsValid() && PooledMID.Manager->FindPooledMIDState(PooledMID, OutLayout, OutState);
+}
+
 void USUGGraphTask_ApplyMaterial::ApplyMaterialParameters(UMaterialInstanceDynamic& MID)
 {
-    // Apply scalar parameters
-    for (const auto& ParameterData : ScalarInputMap)
+    FSUGGraphParameterBlock& Block(ParameterBlock);
+
+    const FSUGGraphMaterialParameterLayout* LayoutPtr;
+    FSUGGraphMIDParameterState* StatePtr;
+
+    // Non pooled MID, apply every parameter by name
+    if (! FindPooledMIDState(LayoutPtr, StatePtr))
     {
-        MID.SetScalarParameterValue(ParameterData.Key, ParameterData.Value);
+        for (int32 i=0; i<Block.ScalarNames.Num(); ++i)
+        {
+            MID.SetScalarParameterValue(Block.ScalarNames[i], Block.ScalarValues[i]);
+        }
+
+        for (int32 i=0; i<Block.VectorNames.Num(); ++i)
+        {
+            MID.SetVectorParameterValue(Block.VectorNames[i], Block.VectorValues[i]);
+        }
+
+        ApplyTextureParameters(MID, nullptr, nullptr);
+        return;
     }
 
-    // Apply vector parameters
-    for (const auto& ParameterData : VectorInputMap)
+    const FSUGGraphMaterialParameterLayout& Layout(*LayoutPtr);
+    FSUGGraphMIDParameterState& State(*StatePtr);
+
+    ResolveParameterSlots(Layout);
+
+    // MID parameters were last applied by this task with the same parameter
+    // set, only parameters marked dirty since may differ
+    const bool bApplyDirtyOnly = ! Block.bLayoutDirty && State.LastOwner.Get() == this && State.bValuesValid;
+
+    if (bApplyDirtyOnly)
     {
-        MID.SetVectorParameterValue(ParameterData.Key, ParameterData.Value);
+        for (TConstSetBitIterator<> It(Block.DirtyScalars); It; ++It)
+        {
+            ApplyScalarParameter(MID, It.GetIndex(), Layout, State);
+        }
+
+        for (TConstSetBitIterator<> It(Block.DirtyVectors); It; ++It)
+        {
+            ApplyVectorParameter(MID, It.GetIndex(), Layout, State);
+        }
     }
+    else
+    {
+        TBitArray<> AppliedScalars(false, Layout.ScalarNames.Num());
+        TBitArray<> AppliedVectors(false, Layout.VectorNames.Num());
+
+        for (int32 i=0; i<Block.ScalarNames.Num(); ++i)
+        {
+            const int32 LayoutIndex = ApplyScalarParameter(MID, i, Layout, State);
+
+            if (LayoutIndex != INDEX_NONE)
+            {
+                AppliedScalars[LayoutIndex] = true;
+            }
+        }
+
+        for (int32 i=0; i<Block.VectorNames.Num(); ++i)
+        {
+            const int32 LayoutIndex = ApplyVectorParameter(MID, i, Layout, State);
+
+            if (LayoutIndex != INDEX_NONE)
+            {
+                AppliedVectors[LayoutIndex] = true;
+            }
+        }
+
+        // Restore defaults of parameters left by the previous owner
+
+        for (int32 i=0; i<Layout.ScalarNames.Num(); ++i)
+        {
+            if (! AppliedScalars[i] && Layout.ScalarSlots[i] != INDEX_NONE && (! State.bValuesValid || State.Scalars[i] != Layout.ScalarDefaults[i]))
+            {
+                MID.SetScalarParameterByIndex(Layout.ScalarSlots[i], Layout.ScalarDefaults[i]);
+                State.Scalars[i] = Layout.ScalarDefaults[i];
+            }
+        }
+
+        for (int32 i=0; i<Layout.VectorNames.Num(); ++i)
+        {
+            if (! AppliedVectors[i] && Layout.VectorSlots[i] != INDEX_NONE && (! State.bValuesValid || State.Vectors[i] != Layout.VectorDefaults[i]))
+            {
+                MID.SetVectorParameterByIndex(Layout.VectorSlots[i], Layout.VectorDefaults[i]);
+                State.Vectors[i] = Layout.VectorDefaults[i];
+            }
+        }
+
+        TBitArray<> AppliedTextures(false, Layout.TextureNames.Num());
+
+        for (int32 i=0; i<Block.ResolvedTextures.Num(); ++i)
+        {
+            const int32 LayoutIndex = TextureLayoutIndices[i];
+
+            if (LayoutIndex != INDEX_NONE && Block.ResolvedTextures[i])
+            {
+                AppliedTextures[LayoutIndex] = true;
+            }
+        }
 
-    // Apply texture parameters
-    for (const auto& ParameterData : ResolvedTextureInputMap)
+        for (int32 i=0; i<Layout.TextureNames.Num(); ++i)
+        {
+            if (! AppliedTextures[i] && (! State.bValuesValid || State.Textures[i] != Layout.TextureDefaults[i]))
+            {
+                MID.SetTextureParameterValue(Layout.TextureNames[i], Layout.TextureDefaults[i]);
+                State.Textures[i] = Layout.TextureDefaults[i];
+            }
+        }
+    }
+
+    // Texture inputs are resolved on every execution and always compared
+    ApplyTextureParameters(MID, &Layout, &State);
+
+    State.LastOwner = this;
+    State.bValuesValid = true;
+    Block.ClearDirty();
+}
+
+void USUGGraphTask_ApplyMaterial::ResolveParameterSlots(const FSUGGraphMaterialParameterLayout& Layout)
+{
+    const FSUGGraphParameterBlock& Block(ParameterBlock);
+
+    if (Layout.LayoutId == SlotMapLayoutId && Block.LayoutVersion == SlotMapBlockVersion)
+    {
+        return;
+    }
+
+    ScalarLayoutIndices.SetNumUninitialized(Block.ScalarNames.Num());
+    VectorLayoutIndices.SetNumUninitialized(Block.VectorNames.Num());
+    TextureLayoutIndices.SetNumUninitialized(Block.TextureNames.Num());
+
+    for (int32 i=0; i<Block.ScalarNames.Num(); ++i)
+    {
+        ScalarLayoutIndices[i] = Layout.FindScalarIndex(Block.ScalarNames[i]);
+    }
+
+    for (int32 i=0; i<Block.VectorNames.Num(); ++i)
+    {
+        VectorLayoutIndices[i] = Layout.FindVectorIndex(Block.VectorNames[i]);
+    }
+
+    for (int32 i=0; i<Block.TextureNames.Num(); ++i)
+    {
+        TextureLayoutIndices[i] = Layout.FindTextureIndex(Block.TextureNames[i]);
+    }
+
+    RestoredVectorLayoutIndices.Reset();
+
+    SlotMapLayoutId = Layout.LayoutId;
+    SlotMapBlockVersion = Block.LayoutVersion;
+}
+
+void USUGGraphTask_ApplyMaterial::InvalidateParameterState()
+{
+    const FSUGGraphMaterialParameterLayout* Layout;
+    FSUGGraphMIDParameterState* State;
+
+    if (FindPooledMIDState(Layout, State))
+    {
+        State->LastOwner.Reset();
+        State->bValuesValid = false;
+    }
+}
+
+int32 USUGGraphTask_ApplyMaterial::ApplyScalarParameter(UMaterialInstanceDynamic& MID, int32 BlockIndex, const FSUGGraphMaterialParameterLayout& Layout, FSUGGraphMIDParameterState& State)
+{
+    const FName ParameterName(ParameterBlock.ScalarNames[BlockIndex]);
+    const float Value = ParameterBlock.ScalarValues[BlockIndex];
+    const int32 LayoutIndex = ScalarLayoutIndices[BlockIndex];
+
+    if (LayoutIndex != INDEX_NONE && Layout.ScalarSlots[LayoutIndex] != INDEX_NONE)
+    {
+        float& AppliedValue(State.Scalars[LayoutIndex]);
+
+        if (AppliedValue != Value || ! State.bValuesValid)
+        {
+            MID.SetScalarParameterByIndex(Layout.ScalarSlots[LayoutIndex], Value);
+            AppliedValue = Value;
+        }
+
+        return LayoutIndex;
+    }
+
+    // Parameter unknown to the material layout
+    MID.SetScalarParameterValue(ParameterName, Value);
+
+    return INDEX_NONE;
+}
+
+int32 USUGGraphTask_ApplyMaterial::ApplyVectorParameter(UMaterialInstanceDynamic& MID, int32 BlockIndex, const FSUGGraphMaterialParameterLayout& Layout, FSUGGraphMIDParameterState& State)
+{
+    const FName ParameterName(ParameterBlock.VectorNames[BlockIndex]);
+    const FLinearColor& Value(ParameterBlock.VectorValues[BlockIndex]);
+    const int32 LayoutIndex = VectorLayoutIndices[BlockIndex];
+
+    if (LayoutIndex != INDEX_NONE && Layout.VectorSlots[LayoutIndex] != INDEX_NONE)
+    {
+        FLinearColor& AppliedValue(State.Vectors[LayoutIndex]);
+
+        if (AppliedValue != Value || ! State.bValuesValid)
+        {
+            MID.SetVectorParameterByIndex(Layout.VectorSlots[LayoutIndex], Value);
+            AppliedValue = Value;
+        }
+
+        return LayoutIndex;
+    }
+
+    // Parameter unknown to the material layout
+    MID.SetVectorParameterValue(ParameterName, Value);
+
+    return INDEX_NONE;
+}
+
+void USUGGraphTask_ApplyMaterial::ApplyTextureParameters(UMaterialInstanceDynamic& MID, const FSUGGraphMaterialParameterLayout* Layout, FSUGGraphMIDParameterState* State)
+{
+    const FSUGGraphParameterBlock& Block(ParameterBlock);
+
+    for (int32 i=0; i<Block.ResolvedTextures.Num(); ++i)
     {
-        MID.SetTextureParameterValue(ParameterData.Key, ParameterData.Value);
+        UTexture* Texture = Block.ResolvedTextures[i];
+
+        if (! Texture)
+        {
+            continue;
+        }
+
+        const int32 LayoutIndex = (Layout && State)
+            ? TextureLayoutIndices[i]
+            : INDEX_NONE;
+
+        if (LayoutIndex != INDEX_NONE)
+        {
+            UTexture*& AppliedTexture(State->Textures[LayoutIndex]);
+
+            if (AppliedTexture != Texture || ! State->bValuesValid)
+            {
+                MID.SetTextureParameterValue(Block.TextureNames[i], Texture);
+                AppliedTexture = Texture;
+            }
+        }
+        else
+        {
+            MID.SetTextureParameterValue(Block.TextureNames[i], Texture);
+        }
     }
 }
@@ -28,12 +28,14 @@
 #include "Tasks/SUGGraphTask_AutoLevel.h"
 #include "Shaders/RULShaderLibrary.h"
 #include "SUGGraph.h"
+#include "SUGGraphManager.h"
+#include "SUGGraphRenderUtils.h"
 
 void USUGGraphTask_AutoLevel::Initialize(USUGGraph* Graph)
 {
     check(IsValid(Graph));
 
-    UTexture* Texture(SourceTexture.Texture);
+    UTexture* Texture(SourceTexture.GetTexture());
     USUGGraphTask* Task(SourceTexture.Task);
 
     if (! IsValid(Texture) && IsValid(Task))
@@ -46,14 +48,23 @@ void USUGGraphTask_AutoLevel::Execute(USUGGraph* Graph)
 {
     check(IsValid(Graph));
 
-    UTexture* Texture = SourceTexture.Texture;
+    UTexture* Texture = SourceTexture.GetTexture();
 
     if (! IsValid(Texture))
     {
         Texture = GetOutputRTFromDependencyMap(TEXT("SourceOutput"));
     }
 
-    if (IsValid(Texture))
+    if (! IsValid(Texture))
+    {
+        return;
+    }
+
+    if (bUseNativeShader)
+    {
+        ExecuteNativeShader(*Graph, Texture);
+    }
+    else
     {
         URULShaderLibrary::ApplyAutoLevels(
             Graph->GetGraphManager(),
@@ -65,3 +76,50 @@ void USUGGraphTask_AutoLevel::Execute(USUGGraph* Graph)
             );
     }
 }
+
+void USUGGraphTask_AutoLevel::ExecuteNativeShader(USUGGraph& Graph, UTexture* Texture)
+{
+    check(Graph.HasGraphManager());
+
+    if (! Texture->Resource)
+    {
+        return;
+    }
+
+    const FIntPoint SourceDimension(Texture->Resource->GetSizeX(), Texture->Resource->GetSizeY());
+
+    // Lease full precision value range render targets of every reduction
+    // level, the range never leaves the GPU
+
+    TArray<FIntPoint> LevelDimensions;
+    FSUGGraphRenderUtils::GetRangeReductionLevels(SourceDimension, LevelDimensions);
+
+    TArray<FSUGGraphOutputRT> ReductionRTs;
+    TArray<UTextureRenderTarget2D*> ReductionTextures;
+
+    ReductionRTs.SetNum(LevelDimensions.Num());
+
+    for (int32 i=0; i<LevelDimensions.Num(); ++i)
+    {
+        FRULShaderOutputConfig LevelConfig(ResolvedOutputConfig);
+        LevelConfig.SizeX = LevelDimensions[i].X;
+        LevelConfig.SizeY = LevelDimensions[i].Y;
+        LevelConfig.Format = RTF_RG32f;
+
+        Graph.GetGraphManager()->FindFreeOutputRT(LevelConfig, ReductionRTs[i]);
+        ReductionTextures.Emplace(ReductionRTs[i].RenderTarget);
+    }
+
+    FSUGGraphRenderUtils::DrawAutoLevel(
+        Texture,
+        ReductionTextures,
+        Output.RenderTarget,
+        bApplyLevelMin,
+        bApplyLevelMax
+        );
+}
+
+void USUGGraphTask_AutoLevel::GatherAssetReferences(TArray<FSoftObjectPath>& OutAssetPaths) const
+{
+    SourceTexture.GatherAssetReferences(OutAssetPaths);
+}
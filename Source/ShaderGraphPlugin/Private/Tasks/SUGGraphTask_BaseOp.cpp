@@ -0,0 +1,290 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+#include "Tasks/SUGGraphTask_BaseOp.h"
+#include "SUGGraph.h"
+#include "SUGGraphRenderUtils.h"
+
+void USUGGraphTask_BaseOp::Initialize(USUGGraph* Graph)
+{
+    // Register range texture as task input, entries of a cleared range
+    // texture are removed
+    if (RangeTexture.HasValidInput())
+    {
+        ParameterBlock.SetTexture(TEXT("RangeTexture"), RangeTexture);
+    }
+    else
+    {
+        ParameterBlock.RemoveTexture(TEXT("RangeTexture"));
+    }
+
+    Super::Initialize(Graph);
+}
+
+void USUGGraphTask_BaseOp::Execute(USUGGraph* Graph)
+{
+    if (bUseNativeShader)
+    {
+        check(IsValid(Graph));
+        ExecuteNativeShader(*Graph);
+    }
+    else
+    {
+        Super::Execute(Graph);
+    }
+}
+
+void USUGGraphTask_BaseOp::PostExecute(USUGGraph* Graph)
+{
+    Super::PostExecute(Graph);
+    ResetFusion();
+}
+
+bool USUGGraphTask_BaseOp::SupportsRegionExecution() const
+{
+    // Native operations always render the whole output
+    return ! bUseNativeShader && Super::SupportsRegionExecution();
+}
+
+void USUGGraphTask_BaseOp::GatherAssetReferences(TArray<FSoftObjectPath>& OutAssetPaths) const
+{
+    Super::GatherAssetReferences(OutAssetPaths);
+    RangeTexture.GatherAssetReferences(OutAssetPaths);
+}
+
+void USUGGraphTask_BaseOp::GatherMaterialWarmUpEntries(const USUGGraph& Graph, TArray<FSUGGraphMaterialWarmUpEntry>& OutEntries) const
+{
+    if (! bUseNativeShader)
+    {
+        Super::GatherMaterialWarmUpEntries(Graph, OutEntries);
+    }
+}
+
+bool USUGGraphTask_BaseOp::GetOperationInputNames(TEnumAsByte<enum ESUGGraphBaseOpType> InOperation, FName (&OutInputNames)[3])
+{
+    static const FName SourceTextureName(TEXT("SourceTexture"));
+    static const FName BackgroundTextureName(TEXT("BackgroundTexture"));
+    static const FName ForegroundTextureName(TEXT("ForegroundTexture"));
+    static const FName MaskTextureName(TEXT("MaskTexture"));
+
+    OutInputNames[0] = NAME_None;
+    OutInputNames[1] = NAME_None;
+    OutInputNames[2] = NAME_None;
+
+    switch (InOperation)
+    {
+        case SUG_BOP_Levels:
+        case SUG_BOP_LevelsManual:
+        case SUG_BOP_BlendTarget:
+            OutInputNames[0] = SourceTextureName;
+            break;
+
+        case SUG_BOP_BlendTargetMasked:
+            OutInputNames[0] = SourceTextureName;
+            OutInputNames[2] = MaskTextureName;
+            break;
+
+        case SUG_BOP_Blend:
+        case SUG_BOP_BlendMasked:
+            OutInputNames[0] = BackgroundTextureName;
+            OutInputNames[1] = ForegroundTextureName;
+            OutInputNames[2] = MaskTextureName;
+            break;
+
+        default:
+            return false;
+    }
+
+    return true;
+}
+
+bool USUGGraphTask_BaseOp::IsFusable() const
+{
+    // Target blend operations read the render target, range textures are
+    // not supported by fused stages and tasks drawing on top of another task
+    // output require their own output
+    return bUseNativeShader && ! IsValid(OutputTask) && ! RangeTexture.HasValidInput() && (
+        Operation == SUG_BOP_Levels ||
+        Operation == SUG_BOP_LevelsManual ||
+        Operation == SUG_BOP_Blend ||
+        Operation == SUG_BOP_BlendMasked
+        );
+}
+
+void USUGGraphTask_BaseOp::ResetFusion()
+{
+    FusedConsumer = nullptr;
+    FusedInputName = NAME_None;
+    FusedStageCount = 1;
+    FusedParameters.Reset();
+}
+
+void USUGGraphTask_BaseOp::ResolveFusion(USUGGraph& Graph)
+{
+    ResetFusion();
+
+    if (! IsFusable())
+    {
+        return;
+    }
+
+    FName InputNames[3];
+    GetOperationInputNames(Operation, InputNames);
+
+    FRULShaderOutputConfig ResolvedConfig;
+    GetResolvedOutputConfig(ResolvedConfig);
+
+    // Fuse the first input task that is a fusable native operation with this
+    // task as its only dependant and a matching output config
+
+    for (int32 i=0; i<3; ++i)
+    {
+        const FDependencyData* DependencyData = InputNames[i].IsNone()
+            ? nullptr
+            : DependencyMap.Find(InputNames[i]);
+
+        USUGGraphTask_BaseOp* InputTask = DependencyData
+            ? Cast<USUGGraphTask_BaseOp>(DependencyData->Task)
+            : nullptr;
+
+        if (! IsValid(InputTask) ||
+            ! InputTask->IsFusable() ||
+            InputTask->GetDependantCount() != 1 ||
+            (InputTask->FusedStageCount+1) > FSUGGraphFusedOpParameters::MaxStages)
+        {
+            continue;
+        }
+
+        FRULShaderOutputConfig InputConfig;
+        InputTask->GetResolvedOutputConfig(InputConfig);
+
+        if (! InputConfig.Compare(ResolvedConfig))
+        {
+            continue;
+        }
+
+        InputTask->FusedConsumer = this;
+        InputTask->bOutputElided = true;
+
+        FusedInputName = InputNames[i];
+        FusedStageCount = InputTask->FusedStageCount+1;
+        break;
+    }
+}
+
+bool USUGGraphTask_BaseOp::ResolveNativeParameters(FSUGGraphBaseOpParameters& OutParameters) const
+{
+    FName InputNames[3];
+
+    if (! GetOperationInputNames(Operation, InputNames))
+    {
+        return false;
+    }
+
+    OutParameters.Operation = Operation;
+
+    for (int32 i=0; i<3; ++i)
+    {
+        OutParameters.InputTextures[i] = InputNames[i].IsNone()
+            ? nullptr
+            : ParameterBlock.GetResolvedTexture(InputNames[i]);
+    }
+
+    OutParameters.RemapParams.X = ParameterBlock.GetScalar(TEXT("InRemapValueLo"), 0.f);
+    OutParameters.RemapParams.Y = ParameterBlock.GetScalar(TEXT("InRemapValueHi"), 1.f);
+    OutParameters.RemapParams.Z = ParameterBlock.GetScalar(TEXT("OutRemapValueLo"), 0.f);
+    OutParameters.RemapParams.W = ParameterBlock.GetScalar(TEXT("OutRemapValueHi"), 1.f);
+
+    OutParameters.LevelsParams.X = ParameterBlock.GetScalar(TEXT("LevelsLo"), 0.f);
+    OutParameters.LevelsParams.Y = ParameterBlock.GetScalar(TEXT("LevelsMi"), .5f);
+    OutParameters.LevelsParams.Z = ParameterBlock.GetScalar(TEXT("LevelsHi"), 1.f);
+    OutParameters.LevelsParams.W = ParameterBlock.GetScalar(TEXT("MidPoint"), .5f);
+
+    OutParameters.Opacity = ParameterBlock.GetScalar(TEXT("Opacity"), 1.f);
+
+    if (Operation == SUG_BOP_Levels || Operation == SUG_BOP_LevelsManual)
+    {
+        OutParameters.RangeTexture = ParameterBlock.GetResolvedTexture(TEXT("RangeTexture"));
+    }
+
+    return true;
+}
+
+void USUGGraphTask_BaseOp::ExecuteNativeShader(USUGGraph& Graph)
+{
+    // Resolve task output as texture input
+    ResolveTaskInputMap();
+
+    FSUGGraphBaseOpParameters Parameters;
+
+    if (! ResolveNativeParameters(Parameters))
+    {
+        UE_LOG(LogSGP,Warning, TEXT("USUGGraphTask_BaseOp::ExecuteNativeShader() ABORTED, INVALID OPERATION"));
+        return;
+    }
+
+    // Fused stages are drawn by the last task of the fused chain
+
+    const bool bHasFusedInput = FusedParameters.IsValid() && FusedParameters->HasStages();
+
+    int32 ChainInputIndex = INDEX_NONE;
+
+    if (bHasFusedInput)
+    {
+        FName InputNames[3];
+        GetOperationInputNames(Operation, InputNames);
+
+        for (int32 i=0; i<3; ++i)
+        {
+            if (InputNames[i] == FusedInputName)
+            {
+                ChainInputIndex = i;
+                break;
+            }
+        }
+    }
+
+    if (IsValid(FusedConsumer))
+    {
+        TSharedPtr<FSUGGraphFusedOpParameters> ChainParameters = bHasFusedInput
+            ? FusedParameters
+            : MakeShareable(new FSUGGraphFusedOpParameters);
+
+        ChainParameters->AddStage(Parameters, ChainInputIndex);
+        FusedConsumer->FusedParameters = ChainParameters;
+    }
+    else
+    if (bHasFusedInput)
+    {
+        FusedParameters->AddStage(Parameters, ChainInputIndex);
+        FSUGGraphRenderUtils::DrawFusedOps(*FusedParameters, Output.RenderTarget);
+    }
+    else
+    {
+        FSUGGraphRenderUtils::DrawBaseOp(Parameters, Output.RenderTarget);
+    }
+}
@@ -0,0 +1,96 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+#include "Tasks/SUGGraphTask_BoxFilter.h"
+#include "Tasks/SUGGraphTask_SummedAreaTable.h"
+#include "SUGGraph.h"
+#include "SUGGraphRenderUtils.h"
+
+void USUGGraphTask_BoxFilter::Initialize(USUGGraph* Graph)
+{
+    check(IsValid(Graph));
+
+    if (! IsValid(SummedAreaTable.GetTexture()) && IsValid(SummedAreaTable.Task))
+    {
+        DependencyMap.Emplace(TEXT("SummedAreaOutput"), SummedAreaTable.Task);
+    }
+
+    if (! IsValid(RadiusTexture.GetTexture()) && IsValid(RadiusTexture.Task))
+    {
+        DependencyMap.Emplace(TEXT("RadiusOutput"), RadiusTexture.Task);
+    }
+}
+
+void USUGGraphTask_BoxFilter::Execute(USUGGraph* Graph)
+{
+    check(IsValid(Graph));
+
+    UTexture* TableTexture = SummedAreaTable.GetTexture();
+
+    if (! IsValid(TableTexture))
+    {
+        TableTexture = GetOutputRTFromDependencyMap(TEXT("SummedAreaOutput"));
+    }
+
+    if (! IsValid(TableTexture))
+    {
+        UE_LOG(LogSGP,Warning, TEXT("USUGGraphTask_BoxFilter::Execute() ABORTED, INVALID SUMMED AREA TABLE"));
+        return;
+    }
+
+    UTexture* ScaleTexture = RadiusTexture.GetTexture();
+
+    if (! IsValid(ScaleTexture))
+    {
+        ScaleTexture = GetOutputRTFromDependencyMap(TEXT("RadiusOutput"));
+    }
+
+    FSUGGraphBoxFilterParameters Parameters;
+    Parameters.Radius = Radius;
+
+    const USUGGraphTask_SummedAreaTable* TableTask = Cast<USUGGraphTask_SummedAreaTable>(SummedAreaTable.Task);
+
+    if (IsValid(TableTask) && ! IsValid(SummedAreaTable.GetTexture()))
+    {
+        Parameters.ValueOffset = TableTask->ValueOffset;
+        Parameters.bTableMean = TableTask->bSubtractSourceMean;
+    }
+
+    FSUGGraphRenderUtils::DrawBoxFilter(Parameters, TableTexture, ScaleTexture, Output.RenderTarget);
+}
+
+int32 USUGGraphTask_BoxFilter::GetFootprintRadius() const
+{
+    // Summed area table lookups only depend on texels within the box
+    return FMath::Max(Super::GetFootprintRadius(), FMath::CeilToInt(FMath::Max(0.f, Radius)));
+}
+
+void USUGGraphTask_BoxFilter::GatherAssetReferences(TArray<FSoftObjectPath>& OutAssetPaths) const
+{
+    SummedAreaTable.GatherAssetReferences(OutAssetPaths);
+    RadiusTexture.GatherAssetReferences(OutAssetPaths);
+}
@@ -0,0 +1,229 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+#include "Tasks/SUGGraphTask_Compute.h"
+#include "Engine/Texture.h"
+#include "Engine/TextureRenderTarget2D.h"
+#include "RenderingThread.h"
+#include "TextureResource.h"
+#include "SUGGraph.h"
+#include "SUGGraphManager.h"
+#include "SUGGraphRenderUtils.h"
+
+void USUGGraphTask_Compute::Initialize(USUGGraph* Graph)
+{
+    check(IsValid(Graph));
+
+    ResolvedTextureMap.Reset();
+
+    // Register task inputs to dependency map
+
+    for (const auto& InputPair : TextureInputMap)
+    {
+        const FName& InputKey(InputPair.Key);
+        const FSUGGraphTextureInput& InputValue(InputPair.Value);
+
+        UTexture* Texture(InputValue.GetTexture());
+        USUGGraphTask* Task(InputValue.Task);
+
+        if (IsValid(Texture))
+        {
+            ResolvedTextureMap.Emplace(InputKey, Texture);
+        }
+        else
+        if (IsValid(Task))
+        {
+            DependencyMap.Emplace(InputKey, Task);
+        }
+    }
+}
+
+void USUGGraphTask_Compute::Execute(USUGGraph* Graph)
+{
+    check(IsValid(Graph));
+
+    // Resolve task output as texture input
+    ResolveTaskInputMap();
+
+    FSUGGraphComputeKernelPtr Kernel = CreateComputeKernel(*Graph);
+
+    if (Kernel.IsValid())
+    {
+        DispatchKernel(*Graph, Kernel, Output.RenderTarget);
+    }
+}
+
+bool USUGGraphTask_Compute::SupportsRegionExecution() const
+{
+    // Kernels are dispatched over the whole output
+    return false;
+}
+
+bool USUGGraphTask_Compute::RequiresUAVOutput() const
+{
+    return true;
+}
+
+void USUGGraphTask_Compute::GatherAssetReferences(TArray<FSoftObjectPath>& OutAssetPaths) const
+{
+    for (const auto& InputPair : TextureInputMap)
+    {
+        InputPair.Value.GatherAssetReferences(OutAssetPaths);
+    }
+}
+
+FSUGGraphComputeKernelPtr USUGGraphTask_Compute::CreateComputeKernel(USUGGraph& Graph)
+{
+    return nullptr;
+}
+
+void USUGGraphTask_Compute::ResolveTaskInputMap()
+{
+    for (const auto& DependencyPair : DependencyMap)
+    {
+        UTexture* Texture = DependencyPair.Value.Output.RenderTarget;
+
+        if (IsValid(Texture))
+        {
+            ResolvedTextureMap.Emplace(DependencyPair.Key, Texture);
+        }
+    }
+}
+
+float USUGGraphTask_Compute::GetScalarInput(FName InputName, float DefaultValue) const
+{
+    const float* Value = ScalarInputMap.Find(InputName);
+    return Value ? *Value : DefaultValue;
+}
+
+FLinearColor USUGGraphTask_Compute::GetVectorInput(FName InputName, const FLinearColor& DefaultValue) const
+{
+    const FLinearColor* Value = VectorInputMap.Find(InputName);
+    return Value ? *Value : DefaultValue;
+}
+
+UTexture* USUGGraphTask_Compute::GetResolvedTexture(FName InputName) const
+{
+    UTexture* const* Texture = ResolvedTextureMap.Find(InputName);
+    return Texture ? *Texture : nullptr;
+}
+
+void USUGGraphTask_Compute::DispatchKernel(USUGGraph& Graph, const FSUGGraphComputeKernelPtr& Kernel, UTextureRenderTarget2D* TargetTexture)
+{
+    check(Kernel.IsValid());
+    check(Graph.HasGraphManager());
+
+    if (! IsValid(TargetTexture))
+    {
+        UE_LOG(LogSGP,Warning, TEXT("USUGGraphTask_Compute::DispatchKernel() ABORTED, INVALID TARGET TEXTURE"));
+        return;
+    }
+
+    USUGGraphManager& GraphManager(*Graph.GetGraphManager());
+
+    // Targets without UAV support (shared or graph outputs) are written
+    // through a pooled UAV render target and copied afterwards
+    FSUGGraphOutputRT ScratchOutput;
+    UTextureRenderTarget2D* DispatchTexture = TargetTexture;
+
+    if (! TargetTexture->bCanCreateUAV)
+    {
+        FRULShaderOutputConfig ScratchConfig(ResolvedOutputConfig);
+        ScratchConfig.SizeX = TargetTexture->SizeX;
+        ScratchConfig.SizeY = TargetTexture->SizeY;
+
+        GraphManager.FindFreeOutputRT(ScratchConfig, ScratchOutput, true);
+        DispatchTexture = ScratchOutput.RenderTarget;
+
+        if (! IsValid(DispatchTexture))
+        {
+            return;
+        }
+    }
+
+    FTextureRenderTargetResource* DispatchResource = DispatchTexture->GameThread_GetRenderTargetResource();
+
+    if (! DispatchResource)
+    {
+        return;
+    }
+
+    TArray<FName> InputNames;
+    TArray<FTextureResource*> InputResources;
+
+    for (const auto& TexturePair : ResolvedTextureMap)
+    {
+        InputNames.Emplace(TexturePair.Key);
+        InputResources.Emplace(IsValid(TexturePair.Value) ? TexturePair.Value->Resource : nullptr);
+    }
+
+    const FIntPoint OutputSize(DispatchTexture->SizeX, DispatchTexture->SizeY);
+    FSUGGraphBufferPoolPtr BufferPool = GraphManager.GetBufferPool();
+
+    ENQUEUE_RENDER_COMMAND(SUGGraphTask_Compute_DispatchKernel)(
+        [Kernel, BufferPool, DispatchResource, InputNames, InputResources, OutputSize](FRHICommandListImmediate& RHICmdList)
+        {
+            FTexture2DRHIRef OutputTexture = DispatchResource->GetRenderTargetTexture();
+
+            if (! OutputTexture)
+            {
+                return;
+            }
+
+            FUnorderedAccessViewRHIRef OutputUAV = RHICreateUnorderedAccessView(OutputTexture, 0);
+
+            FSUGGraphComputeContext Context;
+            Context.InputNames = InputNames;
+            Context.OutputTexture = OutputTexture;
+            Context.OutputUAV = OutputUAV;
+            Context.OutputSize = OutputSize;
+            Context.BufferPool = BufferPool.Get();
+
+            for (FTextureResource* InputResource : InputResources)
+            {
+                Context.InputTextures.Emplace(InputResource ? InputResource->TextureRHI.GetReference() : nullptr);
+            }
+
+            RHICmdList.TransitionResource(EResourceTransitionAccess::ERWBarrier, EResourceTransitionPipeline::EGfxToCompute, OutputUAV);
+
+            Kernel->Dispatch(RHICmdList, Context);
+
+            RHICmdList.TransitionResource(EResourceTransitionAccess::EReadable, EResourceTransitionPipeline::EComputeToGfx, OutputUAV);
+
+            BufferPool->ReleaseBuffers();
+        } );
+
+    if (DispatchTexture != TargetTexture)
+    {
+        FSUGGraphRenderUtils::CopyTextureRegion(
+            DispatchTexture,
+            TargetTexture,
+            FIntRect(FIntPoint::ZeroValue, OutputSize),
+            FIntPoint::ZeroValue
+            );
+    }
+}
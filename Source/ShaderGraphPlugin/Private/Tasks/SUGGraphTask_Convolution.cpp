@@ -0,0 +1,240 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+#include "Tasks/SUGGraphTask_Convolution.h"
+#include "Engine/Texture2D.h"
+#include "SUGGraph.h"
+#include "SUGGraphShaders.h"
+
+// Transform length of an output axis, the output padded by the kernel if it
+// fits a single transform or the largest transform for blocked convolution
+static int32 GetConvolutionFFTSize(int32 OutputSize, int32 KernelSize)
+{
+    const int32 PaddedSize = OutputSize + KernelSize - 1;
+
+    return (PaddedSize <= FSUGGraphConvolutionCS::MaxFFTSize)
+        ? (int32) FMath::RoundUpToPowerOfTwo(PaddedSize)
+        : (int32) FSUGGraphConvolutionCS::MaxFFTSize;
+}
+
+class FSUGGraphConvolutionKernel : public FSUGGraphComputeKernel
+{
+public:
+
+    bool bNormalizeKernel;
+    bool bCacheKernelSpectrum;
+    int32 MaxDirectKernelSize;
+
+    virtual void Dispatch(FRHICommandListImmediate& RHICmdList, const FSUGGraphComputeContext& Context) override
+    {
+        typedef FSUGGraphConvolutionCS FShader;
+
+        check(Context.BufferPool);
+
+        FTextureRHIParamRef SourceRHI = Context.GetInputTexture(TEXT("SourceTexture"));
+        FTextureRHIParamRef KernelRHI = Context.GetInputTexture(TEXT("KernelTexture"));
+
+        const FIntVector KernelDimension = KernelRHI->GetSizeXYZ();
+        const FIntPoint KernelSize(KernelDimension.X, KernelDimension.Y);
+        const FIntPoint& Size(Context.OutputSize);
+
+        // Output blocks padded by the kernel extent avoid circular
+        // convolution wrapping into output texels. Outputs exceeding a
+        // single transform are convolved in blocks overlapping by the kernel
+        // extent (overlap-save) sharing a single kernel spectrum.
+
+        const FIntPoint FFTSize(
+            GetConvolutionFFTSize(Size.X, KernelSize.X),
+            GetConvolutionFFTSize(Size.Y, KernelSize.Y)
+            );
+
+        const FIntPoint BlockSize(
+            FMath::Min(Size.X, FFTSize.X - KernelSize.X + 1),
+            FMath::Min(Size.Y, FFTSize.Y - KernelSize.Y + 1)
+            );
+
+        const bool bSmallKernel = KernelSize.X <= MaxDirectKernelSize && KernelSize.Y <= MaxDirectKernelSize;
+
+        TShaderMap<FGlobalShaderType>* ShaderMap = GetGlobalShaderMap(GMaxRHIFeatureLevel);
+
+        auto DispatchPass = [&](
+            FShader::EPassType PassType,
+            const FIntPoint& BlockOrigin,
+            const FIntPoint& PassBlockSize,
+            FUnorderedAccessViewRHIParamRef SpectrumUAV,
+            FShaderResourceViewRHIParamRef KernelSpectrumSRV,
+            FUnorderedAccessViewRHIParamRef OutputUAV,
+            const FIntVector& GroupCount
+            )
+        {
+            FShader::FPermutationDomain PermutationVector;
+            PermutationVector.Set<FShader::FPassType>(PassType);
+
+            TShaderMapRef<FShader> ComputeShader(ShaderMap, PermutationVector);
+            RHICmdList.SetComputeShader(ComputeShader->GetComputeShader());
+
+            ComputeShader->SetParameters(
+                RHICmdList,
+                Size,
+                FFTSize,
+                BlockOrigin,
+                PassBlockSize,
+                KernelSize,
+                bNormalizeKernel,
+                SourceRHI,
+                KernelRHI,
+                SpectrumUAV,
+                KernelSpectrumSRV,
+                OutputUAV
+                );
+
+            RHICmdList.DispatchComputeShader(GroupCount.X, GroupCount.Y, GroupCount.Z);
+            ComputeShader->UnbindBuffers(RHICmdList);
+        };
+
+        if (bSmallKernel)
+        {
+            const FIntVector GroupCount = FSUGGraphComputeContext::GetGroupCount(
+                Size,
+                FIntPoint(FShader::GroupSize, FShader::GroupSize)
+                );
+
+            DispatchPass(FShader::PassDirect, FIntPoint::ZeroValue, Size, nullptr, nullptr, Context.OutputUAV, GroupCount);
+            return;
+        }
+
+        // Kernels covering the whole transform are refused by the task
+        if (BlockSize.X <= 0 || BlockSize.Y <= 0)
+        {
+            return;
+        }
+
+        const int32 SpectrumCount = FFTSize.X * FFTSize.Y;
+
+        // Build kernel spectrum if not cached
+
+        FRWBufferStructured* KernelSpectrum = bCacheKernelSpectrum
+            ? Context.BufferPool->FindCachedBuffer(KernelRHI, FFTSize)
+            : nullptr;
+
+        if (! KernelSpectrum)
+        {
+            KernelSpectrum = bCacheKernelSpectrum
+                ? &Context.BufferPool->AddCachedBuffer(KernelRHI, FFTSize, sizeof(FVector4), SpectrumCount)
+                : &Context.BufferPool->AcquireBuffer(sizeof(FVector4), SpectrumCount);
+
+            DispatchPass(FShader::PassKernelRows, FIntPoint::ZeroValue, BlockSize, KernelSpectrum->UAV, nullptr, nullptr, FIntVector(FFTSize.Y, 1, 1));
+            RHICmdList.TransitionResource(EResourceTransitionAccess::ERWBarrier, EResourceTransitionPipeline::EComputeToCompute, KernelSpectrum->UAV);
+
+            DispatchPass(FShader::PassKernelColumns, FIntPoint::ZeroValue, BlockSize, KernelSpectrum->UAV, nullptr, nullptr, FIntVector(FFTSize.X, 1, 1));
+            RHICmdList.TransitionResource(EResourceTransitionAccess::EReadable, EResourceTransitionPipeline::EComputeToCompute, KernelSpectrum->UAV);
+        }
+
+        // Every output block transforms forward source rows, forward columns
+        // multiplied by the kernel spectrum followed by inverse columns, then
+        // inverse rows covering the output block
+
+        FRWBufferStructured& Spectrum(Context.BufferPool->AcquireBuffer(sizeof(FVector4), SpectrumCount));
+
+        for (int32 BlockY=0; BlockY<Size.Y; BlockY+=BlockSize.Y)
+        for (int32 BlockX=0; BlockX<Size.X; BlockX+=BlockSize.X)
+        {
+            const FIntPoint BlockOrigin(BlockX, BlockY);
+            const FIntPoint OutputBlockSize(
+                FMath::Min(BlockSize.X, Size.X - BlockX),
+                FMath::Min(BlockSize.Y, Size.Y - BlockY)
+                );
+
+            DispatchPass(FShader::PassSourceRows, BlockOrigin, OutputBlockSize, Spectrum.UAV, nullptr, nullptr, FIntVector(FFTSize.Y, 1, 1));
+            RHICmdList.TransitionResource(EResourceTransitionAccess::ERWBarrier, EResourceTransitionPipeline::EComputeToCompute, Spectrum.UAV);
+
+            DispatchPass(FShader::PassConvolveColumns, BlockOrigin, OutputBlockSize, Spectrum.UAV, KernelSpectrum->SRV, nullptr, FIntVector(FFTSize.X, 1, 1));
+            RHICmdList.TransitionResource(EResourceTransitionAccess::ERWBarrier, EResourceTransitionPipeline::EComputeToCompute, Spectrum.UAV);
+
+            DispatchPass(FShader::PassResolveRows, BlockOrigin, OutputBlockSize, Spectrum.UAV, nullptr, Context.OutputUAV, FIntVector(OutputBlockSize.Y, 1, 1));
+            RHICmdList.TransitionResource(EResourceTransitionAccess::ERWBarrier, EResourceTransitionPipeline::EComputeToCompute, Spectrum.UAV);
+        }
+    }
+};
+
+int32 USUGGraphTask_Convolution::GetFootprintRadius() const
+{
+    // Footprint of task kernels is only known once executed and has to be
+    // specified as the task footprint radius
+    const FSUGGraphTextureInput* KernelInput = TextureInputMap.Find(TEXT("KernelTexture"));
+    const UTexture* KernelTexture = KernelInput ? KernelInput->GetTexture() : nullptr;
+
+    if (IsValid(KernelTexture))
+    {
+        const int32 KernelExtent = FMath::Max(KernelTexture->GetSurfaceWidth(), KernelTexture->GetSurfaceHeight());
+        return Super::GetFootprintRadius() + FMath::CeilToInt(KernelExtent * .5f);
+    }
+
+    return Super::GetFootprintRadius();
+}
+
+FSUGGraphComputeKernelPtr USUGGraphTask_Convolution::CreateComputeKernel(USUGGraph& Graph)
+{
+    if (! GetResolvedTexture(TEXT("SourceTexture")))
+    {
+        UE_LOG(LogSGP,Warning, TEXT("USUGGraphTask_Convolution::CreateComputeKernel() ABORTED, INVALID SOURCE TEXTURE"));
+        return nullptr;
+    }
+
+    if (! GetResolvedTexture(TEXT("KernelTexture")))
+    {
+        UE_LOG(LogSGP,Warning, TEXT("USUGGraphTask_Convolution::CreateComputeKernel() ABORTED, INVALID KERNEL TEXTURE"));
+        return nullptr;
+    }
+
+    // Blocked transforms output blocks of the transform size minus the
+    // kernel extent. Limit transformed kernels to half the transform size to
+    // keep at least half of every transform as output block.
+
+    const UTexture* KernelTexture = GetResolvedTexture(TEXT("KernelTexture"));
+    const int32 KernelExtent = FMath::Max(KernelTexture->GetSurfaceWidth(), KernelTexture->GetSurfaceHeight());
+
+    if (KernelExtent > MaxDirectKernelSize && KernelExtent > FSUGGraphConvolutionCS::MaxFFTSize / 2)
+    {
+        UE_LOG(LogSGP,Warning, TEXT("USUGGraphTask_Convolution::CreateComputeKernel() ABORTED, KERNEL DIMENSION %d EXCEEDS TRANSFORM LIMIT"), KernelExtent);
+        return nullptr;
+    }
+
+    TSharedPtr<FSUGGraphConvolutionKernel, ESPMode::ThreadSafe> Kernel(MakeShared<FSUGGraphConvolutionKernel, ESPMode::ThreadSafe>());
+
+    // Only static kernel textures keep their content for the lifetime of
+    // the texture resource, kernel spectra of render targets and task
+    // outputs are rebuilt every dispatch
+
+    const FSUGGraphTextureInput* KernelInput = TextureInputMap.Find(TEXT("KernelTexture"));
+
+    Kernel->bNormalizeKernel = bNormalizeKernel;
+    Kernel->bCacheKernelSpectrum = KernelInput && IsValid(Cast<UTexture2D>(KernelInput->GetTexture()));
+    Kernel->MaxDirectKernelSize = FMath::Max(0, MaxDirectKernelSize);
+
+    return Kernel;
+}
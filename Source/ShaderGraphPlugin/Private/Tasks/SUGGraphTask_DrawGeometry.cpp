@@ -36,7 +36,34 @@ void USUGGraphTask_DrawGeometry::Execute(USUGGraph* Graph)
     if (HasValidOutputRT())
     {
         FIntPoint DrawDimension(Dimension);
+        const TArray<FVector>* DrawVertices = &Vertices;
+        TArray<FVector> TileVertices;
 
+        // Tiled execution, vertices are specified in graph domain space.
+        // Translate vertices to tile space and scale draw dimension to the
+        // tile render region.
+        if (Graph->IsTiledExecution())
+        {
+            const FSUGGraphExecutionTile& Tile(Graph->ExecutionTile);
+            const FVector2D DomainSize(Tile.DomainSize);
+            const FVector2D DomainDimension = (DrawDimension.X > 0 && DrawDimension.Y > 0)
+                ? FVector2D(DrawDimension)
+                : DomainSize;
+            const FVector2D DomainToDimension(DomainDimension / DomainSize);
+            const FVector2D TileOffset(FVector2D(Tile.RenderRect.Min) * DomainToDimension);
+            const FVector2D TileDimension(FVector2D(Tile.RenderRect.Size()) * DomainToDimension);
+
+            TileVertices.Reserve(Vertices.Num());
+
+            for (const FVector& Vertex : Vertices)
+            {
+                TileVertices.Emplace(Vertex.X-TileOffset.X, Vertex.Y-TileOffset.Y, Vertex.Z);
+            }
+
+            DrawVertices = &TileVertices;
+            DrawDimension = FIntPoint(FMath::RoundToInt(TileDimension.X), FMath::RoundToInt(TileDimension.Y));
+        }
+        else
         if (DrawDimension.X <= 0 || DrawDimension.Y <= 0)
         {
             FRULShaderOutputConfig OutputConfig;
@@ -52,7 +79,7 @@ void USUGGraphTask_DrawGeometry::Execute(USUGGraph* Graph)
                 Output.RenderTarget,
                 TaskConfig.DrawConfig,
                 DrawDimension,
-                Vertices,
+                *DrawVertices,
                 Colors,
                 Indices
                 );
@@ -64,9 +91,78 @@ void USUGGraphTask_DrawGeometry::Execute(USUGGraph* Graph)
                 Output.RenderTarget,
                 TaskConfig.DrawConfig,
                 DrawDimension,
-                Vertices,
+                *DrawVertices,
                 Indices
                 );
         }
     }
 }
+
+void USUGGraphTask_DrawGeometry::ResolveTileOccupancy(const USUGGraph& Graph)
+{
+    if (! bGenerateTileOccupancy)
+    {
+        Super::ResolveTileOccupancy(Graph);
+        return;
+    }
+
+    const FIntPoint OutputDimension(ResolvedOutputConfig.GetDimension());
+    const bool bHasDimension = Dimension.X > 0 && Dimension.Y > 0;
+
+    // Map vertices from draw dimension space to output pixels
+
+    FVector2D VertexScale(1.f, 1.f);
+    FVector2D VertexOffset(0.f, 0.f);
+
+    if (Graph.IsTiledExecution())
+    {
+        const FSUGGraphExecutionTile& Tile(Graph.ExecutionTile);
+        const FVector2D DomainSize(Tile.DomainSize);
+
+        if (bHasDimension)
+        {
+            VertexScale = DomainSize / FVector2D(Dimension);
+        }
+
+        VertexOffset = -FVector2D(Tile.RenderRect.Min);
+    }
+    else
+    if (bHasDimension)
+    {
+        VertexScale = FVector2D(OutputDimension) / FVector2D(Dimension);
+    }
+
+    // Mark tiles overlapped by triangle bounds
+
+    TileOccupancy.Init(OutputDimension, OccupancyTileSize);
+
+    const bool bIndexed = Indices.Num() > 0;
+    const int32 IndexCount = bIndexed ? Indices.Num() : Vertices.Num();
+
+    for (int32 i=0; i+2<IndexCount; i+=3)
+    {
+        FBox2D TriangleBounds(ForceInit);
+
+        for (int32 v=0; v<3; ++v)
+        {
+            const int32 VertexIndex = bIndexed ? Indices[i+v] : i+v;
+
+            if (Vertices.IsValidIndex(VertexIndex))
+            {
+                const FVector& Vertex(Vertices[VertexIndex]);
+                TriangleBounds += FVector2D(Vertex.X, Vertex.Y) * VertexScale + VertexOffset;
+            }
+        }
+
+        if (TriangleBounds.bIsValid)
+        {
+            // Conservative bounds, include partially covered border pixels
+            TileOccupancy.MarkRect(FIntRect(
+                FMath::FloorToInt(TriangleBounds.Min.X) - 1,
+                FMath::FloorToInt(TriangleBounds.Min.Y) - 1,
+                FMath::CeilToInt(TriangleBounds.Max.X) + 1,
+                FMath::CeilToInt(TriangleBounds.Max.Y) + 1
+                ));
+        }
+    }
+}
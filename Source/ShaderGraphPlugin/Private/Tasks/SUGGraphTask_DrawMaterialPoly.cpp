@@ -29,13 +29,84 @@
 #include "Shaders/RULShaderLibrary.h"
 #include "SUGGraph.h"
 
+bool USUGGraphTask_DrawMaterialPoly::SupportsRegionExecution() const
+{
+    // Geometry is drawn in output space, changed regions are re-rendered
+    // by drawing the whole geometry
+    return false;
+}
+
+void USUGGraphTask_DrawMaterialPoly::GetGeometryBounds(TArray<FBox2D>& OutBounds) const
+{
+    OutBounds.Reset(Polys.Num());
+
+    for (const FGULPolyGeometryInstance& Poly : Polys)
+    {
+        // Instance extent around its origin at any rotation, include
+        // partially covered border pixels
+        const float Extent = Poly.Size.Size() + 1.f;
+
+        OutBounds.Emplace(
+            Poly.Origin - FVector2D(Extent, Extent),
+            Poly.Origin + FVector2D(Extent, Extent)
+            );
+    }
+}
+
+void USUGGraphTask_DrawMaterialPoly::ResolveTileOccupancy(const USUGGraph& Graph)
+{
+    if (bGenerateTileOccupancy)
+    {
+        TArray<FBox2D> GeometryBounds;
+        GetGeometryBounds(GeometryBounds);
+
+        GenerateTileOccupancy(Graph, GeometryBounds);
+    }
+    else
+    {
+        Super::ResolveTileOccupancy(Graph);
+    }
+}
+
+void USUGGraphTask_DrawMaterialPoly::MarkChangedRegions(const USUGGraph& Graph)
+{
+    TArray<FBox2D> GeometryBounds;
+    GetGeometryBounds(GeometryBounds);
+
+    // Geometry changes only affect the previous and current geometry bounds
+    MarkGeometryChangedRegions(
+        Graph,
+        CalculatePropertyHash(GET_MEMBER_NAME_CHECKED(USUGGraphTask_DrawMaterialPoly, Polys)),
+        GeometryBounds
+        );
+}
+
 void USUGGraphTask_DrawMaterialPoly::ExecuteMaterialFunction(USUGGraph& Graph, UMaterialInstanceDynamic& MID)
 {
     ApplyMaterialParameters(MID);
 
+    const TArray<FGULPolyGeometryInstance>* DrawPolys = &Polys;
+    TArray<FGULPolyGeometryInstance> TilePolys;
+
+    // Tiled execution, geometry is specified in graph domain pixels.
+    // Translate geometry to the tile render region.
+    if (Graph.IsTiledExecution())
+    {
+        const FVector2D TileOffset(Graph.ExecutionTile.RenderRect.Min);
+
+        TilePolys = Polys;
+
+        for (FGULPolyGeometryInstance& TilePoly : TilePolys)
+        {
+            TilePoly.Origin -= TileOffset;
+        }
+
+        DrawPolys = &TilePolys;
+    }
+
     URULShaderLibrary::DrawMaterialPoly(
         Graph.GetGraphManager(),
-        Polys,
+        *DrawPolys,
         &MID,
         Output.RenderTarget,
         TaskConfig.DrawConfig
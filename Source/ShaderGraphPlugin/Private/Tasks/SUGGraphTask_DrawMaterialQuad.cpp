@@ -29,13 +29,84 @@
 #include "Shaders/RULShaderLibrary.h"
 #include "SUGGraph.h"
 
+bool USUGGraphTask_DrawMaterialQuad::SupportsRegionExecution() const
+{
+    // Geometry is drawn in output space, changed regions are re-rendered
+    // by drawing the whole geometry
+    return false;
+}
+
+void USUGGraphTask_DrawMaterialQuad::GetGeometryBounds(TArray<FBox2D>& OutBounds) const
+{
+    OutBounds.Reset(Quads.Num());
+
+    for (const FGULQuadGeometryInstance& Quad : Quads)
+    {
+        // Instance extent around its origin at any rotation, include
+        // partially covered border pixels
+        const float Extent = Quad.Size.Size() + 1.f;
+
+        OutBounds.Emplace(
+            Quad.Origin - FVector2D(Extent, Extent),
+            Quad.Origin + FVector2D(Extent, Extent)
+            );
+    }
+}
+
+void USUGGraphTask_DrawMaterialQuad::ResolveTileOccupancy(const USUGGraph& Graph)
+{
+    if (bGenerateTileOccupancy)
+    {
+        TArray<FBox2D> GeometryBounds;
+        GetGeometryBounds(GeometryBounds);
+
+        GenerateTileOccupancy(Graph, GeometryBounds);
+    }
+    else
+    {
+        Super::ResolveTileOccupancy(Graph);
+    }
+}
+
+void USUGGraphTask_DrawMaterialQuad::MarkChangedRegions(const USUGGraph& Graph)
+{
+    TArray<FBox2D> GeometryBounds;
+    GetGeometryBounds(GeometryBounds);
+
+    // Geometry changes only affect the previous and current geometry bounds
+    MarkGeometryChangedRegions(
+        Graph,
+        CalculatePropertyHash(GET_MEMBER_NAME_CHECKED(USUGGraphTask_DrawMaterialQuad, Quads)),
+        GeometryBounds
+        );
+}
+
 void USUGGraphTask_DrawMaterialQuad::ExecuteMaterialFunction(USUGGraph& Graph, UMaterialInstanceDynamic& MID)
 {
     ApplyMaterialParameters(MID);
 
+    const TArray<FGULQuadGeometryInstance>* DrawQuads = &Quads;
+    TArray<FGULQuadGeometryInstance> TileQuads;
+
+    // Tiled execution, geometry is specified in graph domain pixels.
+    // Translate geometry to the tile render region.
+    if (Graph.IsTiledExecution())
+    {
+        const FVector2D TileOffset(Graph.ExecutionTile.RenderRect.Min);
+
+        TileQuads = Quads;
+
+        for (FGULQuadGeometryInstance& TileQuad : TileQuads)
+        {
+            TileQuad.Origin -= TileOffset;
+        }
+
+        DrawQuads = &TileQuads;
+    }
+
     URULShaderLibrary::DrawMaterialQuad(
         Graph.GetGraphManager(),
-        Quads,
+        *DrawQuads,
         &MID,
         Output.RenderTarget,
         TaskConfig.DrawConfig
@@ -0,0 +1,264 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+#include "Tasks/SUGGraphTask_GaussianBlur.h"
+#include "SUGGraph.h"
+#include "SUGGraphManager.h"
+#include "SUGGraphRenderUtils.h"
+
+// Blur variance in output pixels squared added by the downsample and
+// upsample passes of a pyramid with the specified level count
+static float GetPyramidPassVariance(int32 LevelCount)
+{
+    // Per axis variance of a single pass in texels of the pass source level.
+    // Downsample taps average 2x2 texel blocks at the center and diagonals,
+    // upsample tent taps include bilinear interpolation at quarter texel
+    // offsets.
+    const float DownsampleVariance = .75f;
+    const float UpsampleVariance = 1.f/3.f + 3.f/16.f;
+
+    float Variance = 0.f;
+
+    for (int32 i=1; i<=LevelCount; ++i)
+    {
+        const float LevelTexelArea = (float) (1 << (2*(i-1)));
+        Variance += DownsampleVariance * LevelTexelArea;
+        Variance += UpsampleVariance * LevelTexelArea * 4.f;
+    }
+
+    return Variance;
+}
+
+void USUGGraphTask_GaussianBlur::Initialize(USUGGraph* Graph)
+{
+    check(IsValid(Graph));
+
+    UTexture* Texture(SourceTexture.GetTexture());
+    USUGGraphTask* Task(SourceTexture.Task);
+
+    if (! IsValid(Texture) && IsValid(Task))
+    {
+        DependencyMap.Emplace(TEXT("SourceOutput"), Task);
+    }
+}
+
+void USUGGraphTask_GaussianBlur::Execute(USUGGraph* Graph)
+{
+    check(IsValid(Graph));
+    check(Graph->HasGraphManager());
+
+    UTexture* Texture = SourceTexture.GetTexture();
+
+    if (! IsValid(Texture))
+    {
+        Texture = GetOutputRTFromDependencyMap(TEXT("SourceOutput"));
+    }
+
+    if (! IsValid(Texture))
+    {
+        UE_LOG(LogSGP,Warning, TEXT("USUGGraphTask_GaussianBlur::Execute() ABORTED, INVALID SOURCE TEXTURE"));
+        return;
+    }
+
+    const int32 LevelCount = GetPyramidLevelCount();
+
+    if (LevelCount > 0)
+    {
+        ExecutePyramidBlur(*Graph, Texture, LevelCount);
+    }
+    else
+    {
+        ExecuteSeparableBlur(*Graph, Texture);
+    }
+}
+
+int32 USUGGraphTask_GaussianBlur::GetPyramidLevelCount() const
+{
+    typedef FSUGGraphGaussianBlurParameters FParams;
+
+    if (BlurMethod == SUG_BM_Separable)
+    {
+        return 0;
+    }
+
+    // Halve the radius for every pyramid level until it fits the level radius
+
+    int32 LevelCount = (BlurMethod == SUG_BM_Pyramid) ? 1 : 0;
+
+    while ((BlurRadius >> LevelCount) > FParams::PyramidLevelRadius)
+    {
+        ++LevelCount;
+    }
+
+    // Keep the blurred level at least a few pixels in size
+
+    const FIntPoint Dimension = ResolvedOutputConfig.GetDimension();
+    const int32 MinDimension = FMath::Max(1, FMath::Min(Dimension.X, Dimension.Y));
+    const int32 MaxLevelCount = FMath::Max(0, (int32) FMath::FloorLog2(MinDimension) - 2);
+
+    return FMath::Min(LevelCount, MaxLevelCount);
+}
+
+void USUGGraphTask_GaussianBlur::ExecuteSeparableBlur(USUGGraph& Graph, UTexture* Texture)
+{
+    if (BlurRadius > FSUGGraphGaussianBlurParameters::MaxRadius)
+    {
+        UE_LOG(LogSGP,Warning, TEXT("USUGGraphTask_GaussianBlur::ExecuteSeparableBlur() BLUR RADIUS %d EXCEEDS SEPARABLE BLUR LIMIT, CLAMPED TO %d"),
+            BlurRadius,
+            (int32) FSUGGraphGaussianBlurParameters::MaxRadius);
+    }
+
+    FSUGGraphGaussianBlurParameters Parameters;
+    Parameters.SetGaussianTaps(BlurRadius, BlurSigma);
+
+    // Scratch target is leased from the output pool for the duration of
+    // the task execution
+    FSUGGraphOutputRT ScratchRT;
+    Graph.GetGraphManager()->FindFreeOutputRT(ResolvedOutputConfig, ScratchRT);
+
+    FSUGGraphRenderUtils::DrawGaussianBlur(
+        Parameters,
+        Texture,
+        ScratchRT.RenderTarget,
+        Output.RenderTarget
+        );
+}
+
+void USUGGraphTask_GaussianBlur::ExecutePyramidBlur(USUGGraph& Graph, UTexture* Texture, int32 LevelCount)
+{
+    check(LevelCount > 0);
+
+    USUGGraphManager* GraphManager = Graph.GetGraphManager();
+
+    // Lease half resolution render targets for every pyramid level and a
+    // scratch render target for the separable blur of the last level
+
+    TArray<FSUGGraphOutputRT, TInlineAllocator<8>> LevelRTs;
+    LevelRTs.SetNum(LevelCount);
+
+    FRULShaderOutputConfig LevelConfig(ResolvedOutputConfig);
+
+    for (int32 i=0; i<LevelCount; ++i)
+    {
+        LevelConfig.SizeX = FMath::Max(1, LevelConfig.SizeX / 2);
+        LevelConfig.SizeY = FMath::Max(1, LevelConfig.SizeY / 2);
+        GraphManager->FindFreeOutputRT(LevelConfig, LevelRTs[i]);
+
+        if (! LevelRTs[i].IsValidOutput())
+        {
+            UE_LOG(LogSGP,Warning, TEXT("USUGGraphTask_GaussianBlur::ExecutePyramidBlur() ABORTED, INVALID PYRAMID LEVEL RENDER TARGET"));
+            return;
+        }
+    }
+
+    FSUGGraphOutputRT ScratchRT;
+    GraphManager->FindFreeOutputRT(LevelConfig, ScratchRT);
+
+    // Downsample source to the last pyramid level
+
+    UTexture* LevelTexture = Texture;
+
+    for (int32 i=0; i<LevelCount; ++i)
+    {
+        FSUGGraphRenderUtils::DrawPyramidBlurPass(LevelTexture, LevelRTs[i].RenderTarget, false);
+        LevelTexture = LevelRTs[i].RenderTarget;
+    }
+
+    // Blur last pyramid level in place with the radius scaled to the level.
+    // Blur added by the pyramid passes is subtracted from the level sigma.
+
+    typedef FSUGGraphGaussianBlurParameters FParams;
+
+    const float LevelScale = 1.f / (1 << LevelCount);
+    const float Sigma = (BlurSigma > 0.f)
+        ? BlurSigma
+        : FMath::Max(BlurRadius / 3.f, .5f);
+    const float PassVariance = GetPyramidPassVariance(LevelCount);
+    const float LevelVariance = FMath::Square(Sigma) - PassVariance;
+
+    int32 LevelRadius = FMath::CeilToInt(BlurRadius * LevelScale);
+
+    if (LevelVariance <= 0.f)
+    {
+        UE_LOG(LogSGP,Warning, TEXT("USUGGraphTask_GaussianBlur::ExecutePyramidBlur() BLUR SIGMA %f BELOW PYRAMID PASS BLUR %f, RESULT IS OVERBLURRED"),
+            Sigma,
+            FMath::Sqrt(PassVariance));
+    }
+
+    if (LevelRadius > FParams::MaxRadius)
+    {
+        UE_LOG(LogSGP,Warning, TEXT("USUGGraphTask_GaussianBlur::ExecutePyramidBlur() BLUR RADIUS %d EXCEEDS PYRAMID LIMIT %d FOR OUTPUT SIZE, CLAMPED"),
+            BlurRadius,
+            (int32) FParams::MaxRadius << LevelCount);
+
+        LevelRadius = FParams::MaxRadius;
+    }
+
+    // Level blur is skipped if the pass blur alone covers the requested blur
+    if (LevelVariance > 0.f)
+    {
+        const float LevelSigma = FMath::Sqrt(LevelVariance) * LevelScale;
+
+        FParams Parameters;
+        Parameters.SetGaussianTaps(LevelRadius, FMath::Max(LevelSigma, KINDA_SMALL_NUMBER));
+
+        FSUGGraphRenderUtils::DrawGaussianBlur(
+            Parameters,
+            LevelRTs.Last().RenderTarget,
+            ScratchRT.RenderTarget,
+            LevelRTs.Last().RenderTarget
+            );
+    }
+
+    // Upsample blurred level back to the task output, downsampled levels are
+    // no longer needed and are overwritten on the way up
+
+    for (int32 i=LevelCount-1; i>=0; --i)
+    {
+        UTextureRenderTarget2D* TargetTexture = (i > 0)
+            ? LevelRTs[i-1].RenderTarget
+            : Output.RenderTarget;
+
+        FSUGGraphRenderUtils::DrawPyramidBlurPass(LevelRTs[i].RenderTarget, TargetTexture, true);
+    }
+}
+
+int32 USUGGraphTask_GaussianBlur::GetFootprintRadius() const
+{
+    // Output config might not be resolved yet, pyramid blurs are assumed
+    // whenever the blur method allows them
+    const int32 Radius = (BlurMethod == SUG_BM_Separable)
+        ? FMath::Clamp(BlurRadius, 0, (int32) FSUGGraphGaussianBlurParameters::MaxRadius)
+        : FMath::Max(0, BlurRadius);
+
+    return FMath::Max(Super::GetFootprintRadius(), Radius);
+}
+
+void USUGGraphTask_GaussianBlur::GatherAssetReferences(TArray<FSoftObjectPath>& OutAssetPaths) const
+{
+    SourceTexture.GatherAssetReferences(OutAssetPaths);
+}
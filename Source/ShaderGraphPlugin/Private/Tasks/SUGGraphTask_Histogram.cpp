@@ -0,0 +1,142 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+#include "Tasks/SUGGraphTask_Histogram.h"
+#include "ClearQuad.h"
+#include "SUGGraph.h"
+#include "SUGGraphShaders.h"
+
+class FSUGGraphHistogramKernel : public FSUGGraphComputeKernel
+{
+public:
+
+    uint32 BinCount;
+    FVector4 ChannelMask;
+    FVector2D ValueRange;
+    FVector2D Percentiles;
+
+    virtual void Dispatch(FRHICommandListImmediate& RHICmdList, const FSUGGraphComputeContext& Context) override
+    {
+        typedef FSUGGraphHistogramCS FShader;
+
+        check(Context.BufferPool);
+
+        FTextureRHIParamRef SourceRHI = Context.GetInputTexture(TEXT("SourceTexture"));
+        const FIntVector SourceSize = SourceRHI->GetSizeXYZ();
+
+        FRWBufferStructured& HistogramBuffer(Context.BufferPool->AcquireBuffer(sizeof(uint32), FShader::MaxBinCount));
+        ClearUAV(RHICmdList, HistogramBuffer, 0);
+
+        TShaderMap<FGlobalShaderType>* ShaderMap = GetGlobalShaderMap(GMaxRHIFeatureLevel);
+
+        // Accumulate source values into histogram bins
+
+        {
+            FShader::FPermutationDomain PermutationVector;
+            PermutationVector.Set<FShader::FPassType>(FShader::PassAccumulate);
+
+            TShaderMapRef<FShader> ComputeShader(ShaderMap, PermutationVector);
+            RHICmdList.SetComputeShader(ComputeShader->GetComputeShader());
+
+            ComputeShader->SetAccumulateParameters(
+                RHICmdList,
+                SourceRHI,
+                FIntPoint(SourceSize.X, SourceSize.Y),
+                ChannelMask,
+                BinCount,
+                ValueRange,
+                HistogramBuffer.UAV
+                );
+
+            const FIntVector GroupCount = FSUGGraphComputeContext::GetGroupCount(
+                FIntPoint(SourceSize.X, SourceSize.Y),
+                FIntPoint(FShader::GroupSize, FShader::GroupSize)
+                );
+
+            RHICmdList.DispatchComputeShader(GroupCount.X, GroupCount.Y, GroupCount.Z);
+            ComputeShader->UnbindBuffers(RHICmdList);
+        }
+
+        RHICmdList.TransitionResource(EResourceTransitionAccess::EReadable, EResourceTransitionPipeline::EComputeToCompute, HistogramBuffer.UAV);
+
+        // Prefix sum histogram bins and resolve percentiles to the output
+
+        {
+            FShader::FPermutationDomain PermutationVector;
+            PermutationVector.Set<FShader::FPassType>(FShader::PassPercentile);
+
+            TShaderMapRef<FShader> ComputeShader(ShaderMap, PermutationVector);
+            RHICmdList.SetComputeShader(ComputeShader->GetComputeShader());
+
+            ComputeShader->SetPercentileParameters(
+                RHICmdList,
+                HistogramBuffer.SRV,
+                BinCount,
+                ValueRange,
+                Percentiles,
+                Context.OutputUAV
+                );
+
+            RHICmdList.DispatchComputeShader(1, 1, 1);
+            ComputeShader->UnbindBuffers(RHICmdList);
+        }
+
+        RHICmdList.TransitionResource(EResourceTransitionAccess::ERWBarrier, EResourceTransitionPipeline::EComputeToCompute, HistogramBuffer.UAV);
+    }
+};
+
+void USUGGraphTask_Histogram::ResolveOutputConfig(const USUGGraph& Graph)
+{
+    Super::ResolveOutputConfig(Graph);
+
+    // Output is always a full precision single row texel per bin texture
+    ResolvedOutputConfig.SizeX = GetBinCount();
+    ResolvedOutputConfig.SizeY = 1;
+    ResolvedOutputConfig.Format = RTF_RGBA32f;
+}
+
+FSUGGraphComputeKernelPtr USUGGraphTask_Histogram::CreateComputeKernel(USUGGraph& Graph)
+{
+    if (! GetResolvedTexture(TEXT("SourceTexture")))
+    {
+        UE_LOG(LogSGP,Warning, TEXT("USUGGraphTask_Histogram::CreateComputeKernel() ABORTED, INVALID SOURCE TEXTURE"));
+        return nullptr;
+    }
+
+    TSharedPtr<FSUGGraphHistogramKernel, ESPMode::ThreadSafe> Kernel(MakeShared<FSUGGraphHistogramKernel, ESPMode::ThreadSafe>());
+
+    Kernel->BinCount = GetBinCount();
+    Kernel->ChannelMask = FVector4(0.f, 0.f, 0.f, 0.f);
+    Kernel->ChannelMask[FMath::Clamp(SourceChannel, 0, 3)] = 1.f;
+    Kernel->ValueRange = FVector2D(RangeMin, RangeMax);
+    Kernel->Percentiles = FVector2D(
+        FMath::Clamp(PercentileLo, 0.f, 1.f),
+        FMath::Clamp(PercentileHi, 0.f, 1.f)
+        );
+
+    return Kernel;
+}
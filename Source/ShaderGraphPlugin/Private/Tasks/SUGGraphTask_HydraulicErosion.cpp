@@ -0,0 +1,174 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+#include "Tasks/SUGGraphTask_HydraulicErosion.h"
+#include "Engine/TextureRenderTarget2D.h"
+#include "SUGGraph.h"
+#include "SUGGraphManager.h"
+#include "SUGGraphRenderUtils.h"
+
+void USUGGraphTask_HydraulicErosion::Initialize(USUGGraph* Graph)
+{
+    check(IsValid(Graph));
+
+    UTexture* Texture(SourceTexture.GetTexture());
+    USUGGraphTask* Task(SourceTexture.Task);
+
+    if (! IsValid(Texture) && IsValid(Task))
+    {
+        DependencyMap.Emplace(TEXT("SourceOutput"), Task);
+    }
+}
+
+void USUGGraphTask_HydraulicErosion::Execute(USUGGraph* Graph)
+{
+    check(IsValid(Graph));
+    check(Graph->HasGraphManager());
+
+    // Erosion spreads across the whole domain, tiles simulated separately
+    // would not match at tile borders
+    if (Graph->IsTiledExecution())
+    {
+        UE_LOG(LogSGP,Warning, TEXT("USUGGraphTask_HydraulicErosion::Execute() ABORTED, TILED EXECUTION IS NOT SUPPORTED"));
+        return;
+    }
+
+    USUGGraphManager& GraphManager(*Graph->GetGraphManager());
+
+    // State textures as (Terrain0, Terrain1, Flux0, Flux1), state is
+    // reinitialized whenever the output dimension or the source changes.
+    // Source tasks are identified by their state and inputs, content
+    // changes of source render targets are not detected.
+
+    FRULShaderOutputConfig StateConfig(ResolvedOutputConfig);
+    StateConfig.Format = RTF_RGBA32f;
+
+    FTaskHashMap TaskHashMap;
+    const uint32 SourceHash = CalculatePropertyHash(GET_MEMBER_NAME_CHECKED(USUGGraphTask_HydraulicErosion, SourceTexture), &TaskHashMap);
+
+    FSUGGraphSimulationState& State(GraphManager.FindOrAddSimulationState(SimulationName));
+    UTexture* InitialTexture = nullptr;
+
+    const bool bValidStateTextures = State.IsValidState(4, StateConfig);
+
+    if (! bValidStateTextures || State.SourceHash != SourceHash)
+    {
+        UTexture* Texture = SourceTexture.GetTexture();
+
+        if (! IsValid(Texture))
+        {
+            Texture = GetOutputRTFromDependencyMap(TEXT("SourceOutput"));
+        }
+
+        if (! IsValid(Texture))
+        {
+            UE_LOG(LogSGP,Warning, TEXT("USUGGraphTask_HydraulicErosion::Execute() ABORTED, INVALID SOURCE TEXTURE"));
+            return;
+        }
+
+        // Source changes restart the simulation in the existing state render
+        // targets, initialization passes overwrite their content
+        if (bValidStateTextures)
+        {
+            State.Restart();
+        }
+        else
+        {
+            State.Reset();
+
+            for (int32 i=0; i<4; ++i)
+            {
+                UTextureRenderTarget2D* StateTexture = GraphManager.CreateOutputRenderTarget(StateConfig);
+
+                if (! IsValid(StateTexture))
+                {
+                    UE_LOG(LogSGP,Warning, TEXT("USUGGraphTask_HydraulicErosion::Execute() ABORTED, UNABLE TO CREATE STATE RENDER TARGETS"));
+                    State.Reset();
+                    return;
+                }
+
+                State.StateTextures.Emplace(StateTexture);
+            }
+        }
+
+        State.SourceHash = SourceHash;
+        InitialTexture = Texture;
+    }
+
+    // Advance simulation by the step budget, completed simulations only
+    // resolve their current height
+
+    const int32 StepBudget = FMath::Max(1, StepsPerExecution);
+    const int32 PendingSteps = FMath::Clamp(StepCount - State.StepCount, 0, StepBudget);
+
+    FSUGGraphHydraulicErosionParameters Parameters;
+    Parameters.TimeStep = TimeStep;
+    Parameters.CellSize = CellSize;
+    Parameters.Gravity = Gravity;
+    Parameters.RainRate = RainRate;
+    Parameters.SedimentCapacity = SedimentCapacity;
+    Parameters.DissolvingRate = DissolvingRate;
+    Parameters.DepositionRate = DepositionRate;
+    Parameters.EvaporationRate = EvaporationRate;
+    Parameters.MinimumTilt = MinimumTilt;
+
+    FSUGGraphRenderUtils::DrawHydraulicErosion(
+        Parameters,
+        InitialTexture,
+        State.StateTextures[0],
+        State.StateTextures[1],
+        State.StateTextures[2],
+        State.StateTextures[3],
+        PendingSteps,
+        Output.RenderTarget
+        );
+
+    // Keep current flux state in the first flux render target
+    if (PendingSteps % 2)
+    {
+        State.StateTextures.Swap(2, 3);
+    }
+
+    State.StepCount += PendingSteps;
+    CompletedStepCount = State.StepCount;
+}
+
+void USUGGraphTask_HydraulicErosion::PostExecute(USUGGraph* Graph)
+{
+    Super::PostExecute(Graph);
+
+    // Continue the simulation on the next incremental execution
+    if (! IsSimulationComplete())
+    {
+        MarkDirty();
+    }
+}
+
+void USUGGraphTask_HydraulicErosion::GatherAssetReferences(TArray<FSoftObjectPath>& OutAssetPaths) const
+{
+    SourceTexture.GatherAssetReferences(OutAssetPaths);
+}
@@ -0,0 +1,130 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+#include "Tasks/SUGGraphTask_JumpFlood.h"
+#include "SUGGraph.h"
+#include "SUGGraphManager.h"
+#include "SUGGraphRenderUtils.h"
+
+static bool IsFloatRenderTargetFormat(ETextureRenderTargetFormat Format)
+{
+    switch (Format)
+    {
+        case RTF_R16f:
+        case RTF_RG16f:
+        case RTF_RGBA16f:
+        case RTF_R32f:
+        case RTF_RG32f:
+        case RTF_RGBA32f:
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+void USUGGraphTask_JumpFlood::Initialize(USUGGraph* Graph)
+{
+    check(IsValid(Graph));
+
+    UTexture* Texture(SourceTexture.GetTexture());
+    USUGGraphTask* Task(SourceTexture.Task);
+
+    if (! IsValid(Texture) && IsValid(Task))
+    {
+        DependencyMap.Emplace(TEXT("SourceOutput"), Task);
+    }
+}
+
+void USUGGraphTask_JumpFlood::Execute(USUGGraph* Graph)
+{
+    check(IsValid(Graph));
+    check(Graph->HasGraphManager());
+
+    UTexture* Texture = SourceTexture.GetTexture();
+
+    if (! IsValid(Texture))
+    {
+        Texture = GetOutputRTFromDependencyMap(TEXT("SourceOutput"));
+    }
+
+    if (! IsValid(Texture))
+    {
+        UE_LOG(LogSGP,Warning, TEXT("USUGGraphTask_JumpFlood::Execute() ABORTED, INVALID SOURCE TEXTURE"));
+        return;
+    }
+
+    // Unlimited distances depend on the whole graph domain, tiles only see
+    // their footprint margin
+    if (MaxDistance <= 0.f && Graph->IsTiledExecution())
+    {
+        UE_LOG(LogSGP,Warning, TEXT("USUGGraphTask_JumpFlood::Execute() ABORTED, UNLIMITED DISTANCE REQUIRES NON-TILED EXECUTION"));
+        return;
+    }
+
+    // Nearest seed positions are stored in full precision pooled targets
+
+    FRULShaderOutputConfig FloodConfig(ResolvedOutputConfig);
+    FloodConfig.Format = RTF_RG32f;
+
+    FSUGGraphOutputRT FloodRT0;
+    FSUGGraphOutputRT FloodRT1;
+    Graph->GetGraphManager()->FindFreeOutputRT(FloodConfig, FloodRT0);
+    Graph->GetGraphManager()->FindFreeOutputRT(FloodConfig, FloodRT1);
+
+    FSUGGraphJumpFloodParameters Parameters;
+    Parameters.SeedThreshold = SeedThreshold;
+    Parameters.MaxDistance = MaxDistance;
+
+    // Unlimited pixel distances saturate in non-float outputs, normalize
+    // them to the output diagonal instead
+    if (MaxDistance <= 0.f && ! IsFloatRenderTargetFormat(ResolvedOutputConfig.Format))
+    {
+        const FIntPoint Dimension = ResolvedOutputConfig.GetDimension();
+        Parameters.MaxDistance = FMath::Max(1.f, FVector2D(Dimension).Size());
+    }
+
+    FSUGGraphRenderUtils::DrawJumpFlood(
+        Parameters,
+        Texture,
+        FloodRT0.RenderTarget,
+        FloodRT1.RenderTarget,
+        Output.RenderTarget
+        );
+}
+
+int32 USUGGraphTask_JumpFlood::GetFootprintRadius() const
+{
+    // Unlimited distances depend on the whole source, tiled executions
+    // require a limited distance range and abort otherwise
+    return FMath::Max(Super::GetFootprintRadius(), FMath::CeilToInt(FMath::Max(0.f, MaxDistance)));
+}
+
+void USUGGraphTask_JumpFlood::GatherAssetReferences(TArray<FSoftObjectPath>& OutAssetPaths) const
+{
+    SourceTexture.GatherAssetReferences(OutAssetPaths);
+}
@@ -0,0 +1,155 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+#include "Tasks/SUGGraphTask_Morphology.h"
+#include "SUGGraph.h"
+#include "SUGGraphShaders.h"
+
+class FSUGGraphMorphologyKernel : public FSUGGraphComputeKernel
+{
+public:
+
+    int32 Radius;
+    bool bDilate;
+
+    virtual void Dispatch(FRHICommandListImmediate& RHICmdList, const FSUGGraphComputeContext& Context) override
+    {
+        typedef FSUGGraphMorphologyCS FShader;
+
+        check(Context.BufferPool);
+
+        FTextureRHIParamRef SourceRHI = Context.GetInputTexture(TEXT("SourceTexture"));
+        const FIntPoint& Size(Context.OutputSize);
+
+        // Lines are padded by the radius on both ends, prefix and suffix
+        // buffers are shared by horizontal and vertical passes
+
+        const int32 PaddedCountX = (Size.X + 2*Radius) * Size.Y;
+        const int32 PaddedCountY = (Size.Y + 2*Radius) * Size.X;
+        const int32 PaddedCount = FMath::Max(PaddedCountX, PaddedCountY);
+
+        FRWBufferStructured& PrefixBuffer(Context.BufferPool->AcquireBuffer(sizeof(FVector4), PaddedCount));
+        FRWBufferStructured& SuffixBuffer(Context.BufferPool->AcquireBuffer(sizeof(FVector4), PaddedCount));
+        FRWBufferStructured& IntermediateBuffer(Context.BufferPool->AcquireBuffer(sizeof(FVector4), Size.X * Size.Y));
+
+        TShaderMap<FGlobalShaderType>* ShaderMap = GetGlobalShaderMap(GMaxRHIFeatureLevel);
+
+        auto GetShader = [&](FShader::EPassType PassType)
+        {
+            FShader::FPermutationDomain PermutationVector;
+            PermutationVector.Set<FShader::FPassType>(PassType);
+            PermutationVector.Set<FShader::FDilate>(bDilate);
+            return TShaderMapRef<FShader>(ShaderMap, PermutationVector);
+        };
+
+        auto DispatchScan = [&](FShader::EPassType PassType, FShaderResourceViewRHIParamRef IntermediateSRV, int32 LineLength, int32 LineCount)
+        {
+            TShaderMapRef<FShader> ComputeShader(GetShader(PassType));
+            RHICmdList.SetComputeShader(ComputeShader->GetComputeShader());
+
+            ComputeShader->SetScanParameters(
+                RHICmdList,
+                Size,
+                uint32(Radius),
+                SourceRHI,
+                IntermediateSRV,
+                PrefixBuffer.UAV,
+                SuffixBuffer.UAV
+                );
+
+            const int32 SegmentCount = FMath::DivideAndRoundUp(LineLength + 2*Radius, 2*Radius + 1);
+
+            RHICmdList.DispatchComputeShader(FMath::DivideAndRoundUp(SegmentCount, int32(FShader::ScanGroupSize)), LineCount, 1);
+            ComputeShader->UnbindBuffers(RHICmdList);
+
+            RHICmdList.TransitionResource(EResourceTransitionAccess::EReadable, EResourceTransitionPipeline::EComputeToCompute, PrefixBuffer.UAV);
+            RHICmdList.TransitionResource(EResourceTransitionAccess::EReadable, EResourceTransitionPipeline::EComputeToCompute, SuffixBuffer.UAV);
+        };
+
+        auto DispatchCombine = [&](FShader::EPassType PassType, FUnorderedAccessViewRHIParamRef IntermediateUAV, FUnorderedAccessViewRHIParamRef OutputUAV)
+        {
+            TShaderMapRef<FShader> ComputeShader(GetShader(PassType));
+            RHICmdList.SetComputeShader(ComputeShader->GetComputeShader());
+
+            ComputeShader->SetCombineParameters(
+                RHICmdList,
+                Size,
+                uint32(Radius),
+                PrefixBuffer.SRV,
+                SuffixBuffer.SRV,
+                IntermediateUAV,
+                OutputUAV
+                );
+
+            const FIntVector GroupCount = FSUGGraphComputeContext::GetGroupCount(
+                Size,
+                FIntPoint(FShader::GroupSize, FShader::GroupSize)
+                );
+
+            RHICmdList.DispatchComputeShader(GroupCount.X, GroupCount.Y, GroupCount.Z);
+            ComputeShader->UnbindBuffers(RHICmdList);
+
+            RHICmdList.TransitionResource(EResourceTransitionAccess::ERWBarrier, EResourceTransitionPipeline::EComputeToCompute, PrefixBuffer.UAV);
+            RHICmdList.TransitionResource(EResourceTransitionAccess::ERWBarrier, EResourceTransitionPipeline::EComputeToCompute, SuffixBuffer.UAV);
+        };
+
+        // Horizontal pass from the source texture to the intermediate buffer
+
+        DispatchScan(FShader::PassScanX, nullptr, Size.X, Size.Y);
+        DispatchCombine(FShader::PassCombineX, IntermediateBuffer.UAV, nullptr);
+
+        RHICmdList.TransitionResource(EResourceTransitionAccess::EReadable, EResourceTransitionPipeline::EComputeToCompute, IntermediateBuffer.UAV);
+
+        // Vertical pass from the intermediate buffer to the output
+
+        DispatchScan(FShader::PassScanY, IntermediateBuffer.SRV, Size.Y, Size.X);
+        DispatchCombine(FShader::PassCombineY, nullptr, Context.OutputUAV);
+
+        RHICmdList.TransitionResource(EResourceTransitionAccess::ERWBarrier, EResourceTransitionPipeline::EComputeToCompute, IntermediateBuffer.UAV);
+    }
+};
+
+int32 USUGGraphTask_Morphology::GetFootprintRadius() const
+{
+    return Super::GetFootprintRadius() + FMath::Max(0, Radius);
+}
+
+FSUGGraphComputeKernelPtr USUGGraphTask_Morphology::CreateComputeKernel(USUGGraph& Graph)
+{
+    if (! GetResolvedTexture(TEXT("SourceTexture")))
+    {
+        UE_LOG(LogSGP,Warning, TEXT("USUGGraphTask_Morphology::CreateComputeKernel() ABORTED, INVALID SOURCE TEXTURE"));
+        return nullptr;
+    }
+
+    TSharedPtr<FSUGGraphMorphologyKernel, ESPMode::ThreadSafe> Kernel(MakeShared<FSUGGraphMorphologyKernel, ESPMode::ThreadSafe>());
+
+    Kernel->Radius = FMath::Max(0, Radius);
+    Kernel->bDilate = (Operation == SUG_MO_Dilate);
+
+    return Kernel;
+}
@@ -0,0 +1,149 @@
+////////////////////////////////////////////////////////////////////////////////
+//
+// MIT License
+// 
+// Copyright (c) 2018-2019 Nuraga Wiswakarma
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////
+// 
+
+#include "Tasks/SUGGraphTask_SummedAreaTable.h"
+#include "SUGGraph.h"
+#include "SUGGraphShaders.h"
+
+class FSUGGraphSummedAreaTableKernel : public FSUGGraphComputeKernel
+{
+public:
+
+    float ValueOffset;
+    bool bSubtractMean;
+
+    virtual void Dispatch(FRHICommandListImmediate& RHICmdList, const FSUGGraphComputeContext& Context) override
+    {
+        typedef FSUGGraphSummedAreaTableCS FShader;
+
+        check(Context.BufferPool);
+
+        FTextureRHIParamRef SourceRHI = Context.GetInputTexture(TEXT("SourceTexture"));
+        const FIntPoint& Size(Context.OutputSize);
+
+        FRWBufferStructured& RowTotalBuffer(Context.BufferPool->AcquireBuffer(sizeof(FVector4), Size.Y));
+        FRWBufferStructured& MeanBuffer(Context.BufferPool->AcquireBuffer(sizeof(FVector4), 1));
+        FRWBufferStructured& RowSumBuffer(Context.BufferPool->AcquireBuffer(sizeof(FVector4), Size.X * Size.Y));
+
+        TShaderMap<FGlobalShaderType>* ShaderMap = GetGlobalShaderMap(GMaxRHIFeatureLevel);
+
+        // Sum every source row to the row total buffer and reduce row totals
+        // to the source mean once
+
+        if (bSubtractMean)
+        {
+            FShader::FPermutationDomain PermutationVector;
+            PermutationVector.Set<FShader::FPassType>(FShader::PassTotals);
+
+            TShaderMapRef<FShader> ComputeShader(ShaderMap, PermutationVector);
+            RHICmdList.SetComputeShader(ComputeShader->GetComputeShader());
+
+            ComputeShader->SetTotalParameters(RHICmdList, Size, SourceRHI, RowTotalBuffer.UAV);
+
+            RHICmdList.DispatchComputeShader(Size.Y, 1, 1);
+            ComputeShader->UnbindBuffers(RHICmdList);
+        }
+
+        RHICmdList.TransitionResource(EResourceTransitionAccess::EReadable, EResourceTransitionPipeline::EComputeToCompute, RowTotalBuffer.UAV);
+
+        if (bSubtractMean)
+        {
+            FShader::FPermutationDomain PermutationVector;
+            PermutationVector.Set<FShader::FPassType>(FShader::PassMean);
+
+            TShaderMapRef<FShader> ComputeShader(ShaderMap, PermutationVector);
+            RHICmdList.SetComputeShader(ComputeShader->GetComputeShader());
+
+            ComputeShader->SetMeanParameters(RHICmdList, Size, RowTotalBuffer.SRV, MeanBuffer.UAV);
+
+            RHICmdList.DispatchComputeShader(1, 1, 1);
+            ComputeShader->UnbindBuffers(RHICmdList);
+        }
+
+        RHICmdList.TransitionResource(EResourceTransitionAccess::EReadable, EResourceTransitionPipeline::EComputeToCompute, MeanBuffer.UAV);
+
+        // Prefix sum every source row to the row sum buffer, a group per row
+
+        {
+            FShader::FPermutationDomain PermutationVector;
+            PermutationVector.Set<FShader::FPassType>(FShader::PassRows);
+
+            TShaderMapRef<FShader> ComputeShader(ShaderMap, PermutationVector);
+            RHICmdList.SetComputeShader(ComputeShader->GetComputeShader());
+
+            ComputeShader->SetRowParameters(RHICmdList, Size, ValueOffset, bSubtractMean, SourceRHI, MeanBuffer.SRV, RowSumBuffer.UAV);
+
+            RHICmdList.DispatchComputeShader(Size.Y, 1, 1);
+            ComputeShader->UnbindBuffers(RHICmdList);
+        }
+
+        RHICmdList.TransitionResource(EResourceTransitionAccess::EReadable, EResourceTransitionPipeline::EComputeToCompute, RowSumBuffer.UAV);
+
+        // Prefix sum every row sum column to the output, a group per column
+
+        {
+            FShader::FPermutationDomain PermutationVector;
+            PermutationVector.Set<FShader::FPassType>(FShader::PassColumns);
+
+            TShaderMapRef<FShader> ComputeShader(ShaderMap, PermutationVector);
+            RHICmdList.SetComputeShader(ComputeShader->GetComputeShader());
+
+            ComputeShader->SetColumnParameters(RHICmdList, Size, bSubtractMean, MeanBuffer.SRV, RowSumBuffer.SRV, Context.OutputUAV);
+
+            RHICmdList.DispatchComputeShader(Size.X, 1, 1);
+            ComputeShader->UnbindBuffers(RHICmdList);
+        }
+
+        RHICmdList.TransitionResource(EResourceTransitionAccess::ERWBarrier, EResourceTransitionPipeline::EComputeToCompute, RowTotalBuffer.UAV);
+        RHICmdList.TransitionResource(EResourceTransitionAccess::ERWBarrier, EResourceTransitionPipeline::EComputeToCompute, MeanBuffer.UAV);
+        RHICmdList.TransitionResource(EResourceTransitionAccess::ERWBarrier, EResourceTransitionPipeline::EComputeToCompute, RowSumBuffer.UAV);
+    }
+};
+
+void USUGGraphTask_SummedAreaTable::ResolveOutputConfig(const USUGGraph& Graph)
+{
+    Super::ResolveOutputConfig(Graph);
+
+    // Table keeps the resolved dimension but is always full precision
+    ResolvedOutputConfig.Format = RTF_RGBA32f;
+}
+
+FSUGGraphComputeKernelPtr USUGGraphTask_SummedAreaTable::CreateComputeKernel(USUGGraph& Graph)
+{
+    if (! GetResolvedTexture(TEXT("SourceTexture")))
+    {
+        UE_LOG(LogSGP,Warning, TEXT("USUGGraphTask_SummedAreaTable::CreateComputeKernel() ABORTED, INVALID SOURCE TEXTURE"));
+        return nullptr;
+    }
+
+    TSharedPtr<FSUGGraphSummedAreaTableKernel, ESPMode::ThreadSafe> Kernel(MakeShared<FSUGGraphSummedAreaTableKernel, ESPMode::ThreadSafe>());
+
+    Kernel->ValueOffset = ValueOffset;
+    Kernel->bSubtractMean = bSubtractSourceMean;
+
+    return Kernel;
+}
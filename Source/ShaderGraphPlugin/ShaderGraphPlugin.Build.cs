@@ -41,12 +41,15 @@ namespace UnrealBuildTool.Rules
                     "CoreUObject",
                     "Engine",
                     "GeometryUtilityLibrary",
-                    "RenderingUtilityLibrary"
+                    "RenderCore",
+                    "RenderingUtilityLibrary",
+                    "RHI"
                 } );
 
             PrivateDependencyModuleNames.AddRange(
                 new string[] {
-                    "GenericWorkerThread"
+                    "GenericWorkerThread",
+                    "Projects"
                 } );
         }
     }